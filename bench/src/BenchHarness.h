@@ -0,0 +1,130 @@
+#ifndef __BENCHHARNESS_H__
+#define __BENCHHARNESS_H__
+#include <stdio.h>	// For printf()
+#include <stdint.h>
+#include <chrono>
+#include <vector>
+#include <string>
+#include <fstream>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>	// For __rdtsc()
+#endif
+
+/**
+ * @brief Simple wall-clock stopwatch used to time benchmarks
+ */
+class BenchTimer {
+public:
+	BenchTimer() : start(std::chrono::steady_clock::now()) { }
+
+	/**
+	 * @brief Get the time elapsed since construction
+	 *
+	 * @return The elapsed time in seconds
+	 */
+	double elapsedSeconds() const {
+		return std::chrono::duration<double>(std::chrono::steady_clock::now() - this->start).count();
+	}
+
+private:
+	std::chrono::steady_clock::time_point start;
+};
+
+/**
+ * @brief CPU cycle counter used to express benchmark results in bytes per cycle
+ *
+ * On x86, this reads the time-stamp counter (that ticks at the nominal CPU frequency). On other targets, no cycle counter is available and elapsedCycles() returns 0
+ */
+class BenchCycleCounter {
+public:
+	BenchCycleCounter() : start(BenchCycleCounter::now()) { }
+
+	/**
+	 * @brief Get the number of cycles elapsed since construction
+	 *
+	 * @return The elapsed cycles, or 0 if there is no cycle counter on this target
+	 */
+	uint64_t elapsedCycles() const {
+		return BenchCycleCounter::now() - this->start;
+	}
+
+private:
+	static uint64_t now() {
+#if defined(__x86_64__) || defined(__i386__)
+		return __rdtsc();
+#else
+		return 0;
+#endif
+	}
+
+	uint64_t start;
+};
+
+/**
+ * @brief Print the result of one benchmark
+ *
+ * @param name The benchmark name
+ * @param bytes The number of input bytes processed during the benchmark
+ * @param items The number of items (frames, datasets...) produced during the benchmark
+ * @param itemsName The name of the items counted in @p items
+ * @param seconds The duration of the benchmark
+ */
+inline void benchReport(const char* name, uint64_t bytes, uint64_t items, const char* itemsName, double seconds) {
+	printf("%-56s %9.2f MB/s %12.0f %s/s (%llu %s in %.3f s)\n",
+	       name,
+	       bytes / seconds / 1e6,
+	       items / seconds, itemsName,
+	       static_cast<unsigned long long>(items), itemsName,
+	       seconds);
+}
+
+/**
+ * @brief Print the result of one benchmark, including the throughput in bytes per CPU cycle
+ *
+ * @param name The benchmark name
+ * @param bytes The number of input bytes processed during the benchmark
+ * @param items The number of items (frames, datasets...) produced during the benchmark
+ * @param itemsName The name of the items counted in @p items
+ * @param seconds The duration of the benchmark
+ * @param cycles The CPU cycles elapsed during the benchmark (0 if unknown)
+ */
+inline void benchReportCycles(const char* name, uint64_t bytes, uint64_t items, const char* itemsName, double seconds, uint64_t cycles) {
+	if (cycles == 0) {
+		printf("%-56s %9.2f MB/s %12.0f %s/s (no cycle counter)\n", name, bytes / seconds / 1e6, items / seconds, itemsName);
+		return;
+	}
+	printf("%-56s %9.2f MB/s %7.3f bytes/cycle %12.0f %s/s\n",
+	       name,
+	       bytes / seconds / 1e6,
+	       static_cast<double>(bytes) / cycles,
+	       items / seconds, itemsName);
+}
+
+inline std::vector<uint8_t> benchReadVectorFromDisk(const std::string& inputFilename) {
+	std::ifstream instream(inputFilename, std::ios::in | std::ios::binary);
+	std::vector<uint8_t> data((std::istreambuf_iterator<char>(instream)), std::istreambuf_iterator<char>());
+	return data;
+}
+
+/**
+ * @brief Build a large capture by repeating a sample capture file
+ *
+ * @param sampleFilename The sample file to repeat (relative to the bench directory)
+ * @param minSize The minimum size of the resulting capture in bytes
+ * @return The repeated capture
+ */
+inline std::vector<uint8_t> benchBuildRepeatedCapture(const std::string& sampleFilename, size_t minSize) {
+	std::vector<uint8_t> sample = benchReadVectorFromDisk(sampleFilename);
+	std::vector<uint8_t> result;
+	if (sample.empty()) {
+		fprintf(stderr, "Could not read sample file %s\n", sampleFilename.c_str());
+		return result;
+	}
+	result.reserve(minSize + sample.size());
+	while (result.size() < minSize) {
+		result.insert(result.end(), sample.begin(), sample.end());
+	}
+	return result;
+}
+
+#endif // __BENCHHARNESS_H__
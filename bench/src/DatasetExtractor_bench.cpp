@@ -0,0 +1,354 @@
+#include <stdint.h>
+#include <vector>
+
+#include "BenchHarness.h"
+#include "TIC/Unframer.h"
+#include "TIC/DatasetExtractor.h"
+#include "TIC/DatasetBatchExtractor.h"
+#include "TIC/DatasetView.h"
+#include "TIC/LazyDatasetView.h"
+#include "TIC/DatasetLabelFilter.h"
+#include "TIC/FrameValidator.h"
+
+/**
+ * @brief Frame payloads extracted from a capture, stored back to back, with the size of each frame
+ */
+struct BenchFramePayloads {
+	BenchFramePayloads() : bytes(), frameSizes() { }
+
+	std::vector<uint8_t> bytes;
+	std::vector<unsigned int> frameSizes;
+};
+
+static void benchAppendFrameBytes(const uint8_t* buf, unsigned int cnt, void* context) {
+	BenchFramePayloads* payloads = static_cast<BenchFramePayloads*>(context);
+	payloads->bytes.insert(payloads->bytes.end(), buf, buf + cnt);
+	payloads->frameSizes.back() += cnt;
+}
+
+static void benchOnPayloadFrameComplete(void* context) {
+	static_cast<BenchFramePayloads*>(context)->frameSizes.push_back(0);
+}
+
+/**
+ * @brief Unframe a capture once, so that the dataset extractor can be benchmarked alone
+ */
+static BenchFramePayloads benchExtractFramePayloads(const std::vector<uint8_t>& capture) {
+	BenchFramePayloads payloads;
+	payloads.frameSizes.push_back(0);
+	TIC::Unframer tu(benchAppendFrameBytes, benchOnPayloadFrameComplete, &payloads);
+	tu.pushBytes(&(capture[0]), capture.size());
+	payloads.frameSizes.pop_back(); /* Drop the trailing incomplete frame */
+	return payloads;
+}
+
+static void benchCountDataset(const uint8_t* buf, unsigned int cnt, void* context) {
+	(*static_cast<uint64_t*>(context))++;
+}
+
+/**
+ * @brief Feed frame payloads into a TIC::DatasetExtractor, by chunks, resetting it between frames (as done by a TIC::Unframer onFrameComplete callback)
+ *
+ * @param name The benchmark name
+ * @param payloads The frame payloads to extract datasets from
+ * @param chunkSize The size of each chunk pushed to the extractor (1 to push byte-at-a-time)
+ */
+static void benchExtractDatasets(const char* name, const BenchFramePayloads& payloads, unsigned int chunkSize) {
+	uint64_t datasetCount = 0;
+	TIC::DatasetExtractor de(benchCountDataset, &datasetCount);
+
+	BenchTimer timer;
+	BenchCycleCounter cycles;
+	const uint8_t* frame = &(payloads.bytes[0]);
+	for (unsigned int frameSize : payloads.frameSizes) {
+		de.reset();
+		for (unsigned int pos = 0; pos < frameSize; pos += chunkSize) {
+			unsigned int len = frameSize - pos;
+			if (len > chunkSize)
+				len = chunkSize;
+			de.pushBytes(frame + pos, len);
+		}
+		frame += frameSize;
+	}
+	uint64_t elapsedCycles = cycles.elapsedCycles();
+	double seconds = timer.elapsedSeconds();
+	benchReportCycles(name, payloads.bytes.size(), datasetCount, "datasets", seconds, elapsedCycles);
+}
+
+static void benchDecodeDataset(const uint8_t* buf, unsigned int cnt, void* context) {
+	TIC::DatasetView dv(buf, cnt);
+	if (dv.isValid())
+		(*static_cast<uint64_t*>(context))++;
+}
+
+static void benchDecodePrescannedDataset(const uint8_t* buf, unsigned int cnt, const TIC::DatasetPrescan& prescan, void* context) {
+	TIC::DatasetView dv(buf, cnt, prescan);
+	if (dv.isValid())
+		(*static_cast<uint64_t*>(context))++;
+}
+
+static const char* const benchDispatchedLabels[] = { /* 20 labels a consumer typically handles */
+	"ADCO", "PTEC", "IINST1", "IINST2", "IINST3", "IMAX1", "PMAX", "PAPP", "BASE", "HCHC",
+	"ADSC", "DATE", "NGTF", "LTARF", "EAST", "EASF01", "IRMS1", "URMS1", "SINSTS", "SMAXSN",
+};
+
+static void benchDispatchByLabelEquals(const uint8_t* buf, unsigned int cnt, void* context) {
+	TIC::DatasetView dv(buf, cnt);
+	for (const char* label : benchDispatchedLabels) {
+		if (dv.labelEquals(label)) {
+			(*static_cast<uint64_t*>(context))++;
+			return;
+		}
+	}
+}
+
+static const uint64_t benchDispatchedLabelKeys[] = { /* Same labels as benchDispatchedLabels */
+	TIC::labelKey("ADCO"), TIC::labelKey("PTEC"), TIC::labelKey("IINST1"), TIC::labelKey("IINST2"), TIC::labelKey("IINST3"),
+	TIC::labelKey("IMAX1"), TIC::labelKey("PMAX"), TIC::labelKey("PAPP"), TIC::labelKey("BASE"), TIC::labelKey("HCHC"),
+	TIC::labelKey("ADSC"), TIC::labelKey("DATE"), TIC::labelKey("NGTF"), TIC::labelKey("LTARF"), TIC::labelKey("EAST"),
+	TIC::labelKey("EASF01"), TIC::labelKey("IRMS1"), TIC::labelKey("URMS1"), TIC::labelKey("SINSTS"), TIC::labelKey("SMAXSN"),
+};
+
+static void benchDispatchByLabelKey(const uint8_t* buf, unsigned int cnt, void* context) {
+	TIC::DatasetView dv(buf, cnt);
+	for (uint64_t key : benchDispatchedLabelKeys) {
+		if (dv.labelKey == key) {
+			(*static_cast<uint64_t*>(context))++;
+			return;
+		}
+	}
+}
+
+static void benchDispatchByLabelId(const uint8_t* buf, unsigned int cnt, void* context) {
+	TIC::DatasetView dv(buf, cnt);
+	switch (dv.labelId) {
+		case TIC::LabelId::ADCO: case TIC::LabelId::PTEC: case TIC::LabelId::IINST1: case TIC::LabelId::IINST2: case TIC::LabelId::IINST3:
+		case TIC::LabelId::IMAX1: case TIC::LabelId::PMAX: case TIC::LabelId::PAPP: case TIC::LabelId::BASE: case TIC::LabelId::HCHC:
+		case TIC::LabelId::ADSC: case TIC::LabelId::DATE: case TIC::LabelId::NGTF: case TIC::LabelId::LTARF: case TIC::LabelId::EAST:
+		case TIC::LabelId::EASF01: case TIC::LabelId::IRMS1: case TIC::LabelId::URMS1: case TIC::LabelId::SINSTS: case TIC::LabelId::SMAXSN:
+			(*static_cast<uint64_t*>(context))++;
+			break;
+		default:
+			break;
+	}
+}
+
+static const TIC::Horodate& benchHorodateOf(const TIC::DatasetView& dv) {
+	return dv.horodate;
+}
+
+static const TIC::Horodate& benchHorodateOf(const TIC::LazyDatasetView& dv) {
+	return dv.getHorodate();
+}
+
+/**
+ * @brief Filter stage keeping about one standard TIC dataset out of eight (by label identifier), and using the horodate and value of the datasets kept
+ */
+template<typename View>
+static void benchFilterDataset(const View& dv, uint64_t* keptDatasetCount) {
+	switch (dv.labelId) {
+		case TIC::LabelId::EAST: case TIC::LabelId::SINSTS: case TIC::LabelId::SMAXSN: case TIC::LabelId::SMAXSN_1: case TIC::LabelId::URMS1:
+			break;
+		default:
+			return;
+	}
+	bool ok;
+	dv.dataToUint32(ok);
+	if (ok || benchHorodateOf(dv).isValid)
+		(*keptDatasetCount)++;
+}
+
+static void benchFilterWithDatasetView(const uint8_t* buf, unsigned int cnt, void* context) {
+	benchFilterDataset(TIC::DatasetView(buf, cnt), static_cast<uint64_t*>(context));
+}
+
+static void benchFilterWithLazyDatasetView(const uint8_t* buf, unsigned int cnt, void* context) {
+	benchFilterDataset(TIC::LazyDatasetView(buf, cnt), static_cast<uint64_t*>(context));
+}
+
+/**
+ * @brief Feed frame payloads into a dataset extractor, by chunks, and decode each dataset extracted into a TIC::DatasetView
+ *
+ * @param name The benchmark name
+ * @param payloads The frame payloads to extract datasets from
+ * @param chunkSize The size of each chunk pushed to the extractor
+ * @param onDatasetExtracted The callback decoding each dataset, and counting valid ones
+ * @param labelFilter An optional allowlist of labels to attach to the extractor
+ */
+template<typename Extractor, typename FParserFunc>
+static void benchExtractDecodeDatasets(const char* name, const BenchFramePayloads& payloads, unsigned int chunkSize, FParserFunc onDatasetExtracted, const TIC::DatasetLabelFilter* labelFilter = nullptr) {
+	uint64_t validDatasetCount = 0;
+	Extractor de(onDatasetExtracted, &validDatasetCount);
+	de.setLabelFilter(labelFilter);
+
+	BenchTimer timer;
+	BenchCycleCounter cycles;
+	const uint8_t* frame = &(payloads.bytes[0]);
+	for (unsigned int frameSize : payloads.frameSizes) {
+		de.reset();
+		for (unsigned int pos = 0; pos < frameSize; pos += chunkSize) {
+			unsigned int len = frameSize - pos;
+			if (len > chunkSize)
+				len = chunkSize;
+			de.pushBytes(frame + pos, len);
+		}
+		frame += frameSize;
+	}
+	uint64_t elapsedCycles = cycles.elapsedCycles();
+	double seconds = timer.elapsedSeconds();
+	benchReportCycles(name, payloads.bytes.size(), validDatasetCount, "valid datasets", seconds, elapsedCycles);
+}
+
+static void benchCountFrameDatasets(const uint8_t* frame, unsigned int frameSize, const TIC::DatasetSpan* spans, unsigned int spanCount, void* context) {
+	(*static_cast<uint64_t*>(context)) += spanCount;
+}
+
+/**
+ * @brief Feed whole frame payloads into a TIC::DatasetBatchExtractor, that invokes its callback once per frame instead of once per dataset
+ *
+ * @param name The benchmark name
+ * @param payloads The frame payloads to extract datasets from
+ */
+static void benchExtractDatasetBatches(const char* name, const BenchFramePayloads& payloads) {
+	uint64_t datasetCount = 0;
+	TIC::DatasetBatchExtractor batchExtractor(benchCountFrameDatasets, &datasetCount);
+
+	BenchTimer timer;
+	BenchCycleCounter cycles;
+	const uint8_t* frame = &(payloads.bytes[0]);
+	for (unsigned int frameSize : payloads.frameSizes) {
+		batchExtractor.pushFrame(frame, frameSize);
+		frame += frameSize;
+	}
+	uint64_t elapsedCycles = cycles.elapsedCycles();
+	double seconds = timer.elapsedSeconds();
+	benchReportCycles(name, payloads.bytes.size(), datasetCount, "datasets", seconds, elapsedCycles);
+}
+
+static void benchCheckFrameDatasets(const uint8_t* frame, unsigned int frameSize, const TIC::DatasetSpan* spans, unsigned int spanCount, void* context) {
+	for (unsigned int idx = 0; idx < spanCount; idx++) {
+		TIC::DatasetView dv(frame + spans[idx].offset, spans[idx].length);
+		if (dv.decodedType != TIC::DatasetView::DatasetType::WrongCRC)
+			(*static_cast<uint64_t*>(context))++;
+	}
+}
+
+/**
+ * @brief Check the checksum of all datasets of whole frames, with a TIC::DatasetBatchExtractor and one TIC::DatasetView per dataset
+ *
+ * @param name The benchmark name
+ * @param payloads The frame payloads to check
+ */
+static void benchCheckFramesWithDatasetView(const char* name, const BenchFramePayloads& payloads) {
+	uint64_t checkedDatasetCount = 0;
+	TIC::DatasetBatchExtractor batchExtractor(benchCheckFrameDatasets, &checkedDatasetCount);
+
+	BenchTimer timer;
+	BenchCycleCounter cycles;
+	const uint8_t* frame = &(payloads.bytes[0]);
+	for (unsigned int frameSize : payloads.frameSizes) {
+		batchExtractor.pushFrame(frame, frameSize);
+		frame += frameSize;
+	}
+	uint64_t elapsedCycles = cycles.elapsedCycles();
+	double seconds = timer.elapsedSeconds();
+	benchReportCycles(name, payloads.bytes.size(), payloads.frameSizes.size(), "frames", seconds, elapsedCycles);
+	if (checkedDatasetCount == 0)
+		printf("No dataset with a correct checksum\n");
+}
+
+/**
+ * @brief Check the checksum of all datasets of whole frames with TIC::validateFrame()
+ *
+ * @param name The benchmark name
+ * @param payloads The frame payloads to check
+ */
+static void benchCheckFramesWithValidateFrame(const char* name, const BenchFramePayloads& payloads) {
+	uint64_t checkedDatasetCount = 0;
+	TIC::FrameValidation<TIC::DATASET_BATCH_DEFAULT_MAX_DATASETS_PER_FRAME> validation;
+
+	BenchTimer timer;
+	BenchCycleCounter cycles;
+	const uint8_t* frame = &(payloads.bytes[0]);
+	for (unsigned int frameSize : payloads.frameSizes) {
+		TIC::validateFrame(frame, frameSize, validation);
+		for (unsigned int word = 0; word < validation.VALID_BITMAP_WORDS; word++)
+			checkedDatasetCount += static_cast<uint64_t>(__builtin_popcount(validation.validBitmap[word]));
+		frame += frameSize;
+	}
+	uint64_t elapsedCycles = cycles.elapsedCycles();
+	double seconds = timer.elapsedSeconds();
+	benchReportCycles(name, payloads.bytes.size(), payloads.frameSizes.size(), "frames", seconds, elapsedCycles);
+	if (checkedDatasetCount == 0)
+		printf("No dataset with a correct checksum\n");
+}
+
+/**
+ * @brief Same as benchExtractDatasets() byte-at-a-time, but using pushByte() instead of pushBytes(&byte, 1)
+ */
+static void benchExtractDatasetsWithPushByte(const char* name, const BenchFramePayloads& payloads) {
+	uint64_t datasetCount = 0;
+	TIC::DatasetExtractor de(benchCountDataset, &datasetCount);
+
+	BenchTimer timer;
+	BenchCycleCounter cycles;
+	const uint8_t* frame = &(payloads.bytes[0]);
+	for (unsigned int frameSize : payloads.frameSizes) {
+		de.reset();
+		for (unsigned int pos = 0; pos < frameSize; pos++)
+			de.pushByte(frame[pos]);
+		frame += frameSize;
+	}
+	uint64_t elapsedCycles = cycles.elapsedCycles();
+	double seconds = timer.elapsedSeconds();
+	benchReportCycles(name, payloads.bytes.size(), datasetCount, "datasets", seconds, elapsedCycles);
+}
+
+void runDatasetExtractorBenchmarks() {
+	std::vector<uint8_t> standardCapture = benchBuildRepeatedCapture("../test/samples/continuous_linky_1P_standard_TIC_sample.bin", 20 * 1000 * 1000);
+	std::vector<uint8_t> historicalCapture = benchBuildRepeatedCapture("../test/samples/continuous_linky_3P_historical_TIC_sample.bin", 20 * 1000 * 1000);
+	if (standardCapture.empty() || historicalCapture.empty())
+		return;
+	BenchFramePayloads standardPayloads = benchExtractFramePayloads(standardCapture);
+	BenchFramePayloads historicalPayloads = benchExtractFramePayloads(historicalCapture);
+
+	benchExtractDatasets("DatasetExtractor standard, byte-at-a-time", standardPayloads, 1);
+	benchExtractDatasetsWithPushByte("DatasetExtractor standard, byte-at-a-time with pushByte()", standardPayloads);
+	benchExtractDatasets("DatasetExtractor standard, 64-byte chunks", standardPayloads, 64);
+	benchExtractDatasets("DatasetExtractor standard, whole frames", standardPayloads, TIC::UNFRAMER_DEFAULT_MAX_FRAME_SIZE);
+	benchExtractDatasetBatches("DatasetBatchExtractor standard, whole frames", standardPayloads);
+	benchExtractDatasets("DatasetExtractor historical, byte-at-a-time", historicalPayloads, 1);
+	benchExtractDatasetsWithPushByte("DatasetExtractor historical, byte-at-a-time with pushByte()", historicalPayloads);
+	benchExtractDatasets("DatasetExtractor historical, 64-byte chunks", historicalPayloads, 64);
+	benchExtractDatasets("DatasetExtractor historical, whole frames", historicalPayloads, TIC::UNFRAMER_DEFAULT_MAX_FRAME_SIZE);
+	benchExtractDatasetBatches("DatasetBatchExtractor historical, whole frames", historicalPayloads);
+	benchCheckFramesWithDatasetView("DatasetBatchExtractor+DatasetView checksums standard", standardPayloads);
+	benchCheckFramesWithValidateFrame("validateFrame() checksums standard", standardPayloads);
+	benchCheckFramesWithDatasetView("DatasetBatchExtractor+DatasetView checksums historical", historicalPayloads);
+	benchCheckFramesWithValidateFrame("validateFrame() checksums historical", historicalPayloads);
+	benchExtractDecodeDatasets<TIC::DatasetExtractor>("DatasetExtractor+DatasetView standard, 64-byte chunks", standardPayloads, 64, benchDecodeDataset);
+	benchExtractDecodeDatasets<TIC::PrescanDatasetExtractor>("PrescanDatasetExtractor+DatasetView standard, 64-byte chunks", standardPayloads, 64, benchDecodePrescannedDataset);
+	benchExtractDecodeDatasets<TIC::DatasetExtractor>("DatasetExtractor+DatasetView standard, whole frames", standardPayloads, TIC::UNFRAMER_DEFAULT_MAX_FRAME_SIZE, benchDecodeDataset);
+	benchExtractDecodeDatasets<TIC::PrescanDatasetExtractor>("PrescanDatasetExtractor+DatasetView standard, whole frames", standardPayloads, TIC::UNFRAMER_DEFAULT_MAX_FRAME_SIZE, benchDecodePrescannedDataset);
+	benchExtractDecodeDatasets<TIC::DatasetExtractor>("DatasetExtractor+DatasetView historical, 64-byte chunks", historicalPayloads, 64, benchDecodeDataset);
+	benchExtractDecodeDatasets<TIC::PrescanDatasetExtractor>("PrescanDatasetExtractor+DatasetView historical, 64-byte chunks", historicalPayloads, 64, benchDecodePrescannedDataset);
+
+	benchExtractDecodeDatasets<TIC::DatasetExtractor>("DatasetView+labelEquals() chain standard, 20 labels, whole frames", standardPayloads, TIC::UNFRAMER_DEFAULT_MAX_FRAME_SIZE, benchDispatchByLabelEquals);
+	benchExtractDecodeDatasets<TIC::DatasetExtractor>("DatasetView+labelKey compares standard, 20 labels, whole frames", standardPayloads, TIC::UNFRAMER_DEFAULT_MAX_FRAME_SIZE, benchDispatchByLabelKey);
+	benchExtractDecodeDatasets<TIC::DatasetExtractor>("DatasetView filter standard, 5 labels kept, whole frames", standardPayloads, TIC::UNFRAMER_DEFAULT_MAX_FRAME_SIZE, benchFilterWithDatasetView);
+	benchExtractDecodeDatasets<TIC::DatasetExtractor>("LazyDatasetView filter standard, 5 labels kept, whole frames", standardPayloads, TIC::UNFRAMER_DEFAULT_MAX_FRAME_SIZE, benchFilterWithLazyDatasetView);
+	benchExtractDecodeDatasets<TIC::DatasetExtractor>("DatasetView+labelId switch standard, 20 labels, whole frames", standardPayloads, TIC::UNFRAMER_DEFAULT_MAX_FRAME_SIZE, benchDispatchByLabelId);
+	benchExtractDecodeDatasets<TIC::DatasetExtractor>("DatasetView+labelEquals() chain historical, 20 labels, whole frames", historicalPayloads, TIC::UNFRAMER_DEFAULT_MAX_FRAME_SIZE, benchDispatchByLabelEquals);
+	benchExtractDecodeDatasets<TIC::DatasetExtractor>("DatasetView+labelKey compares historical, 20 labels, whole frames", historicalPayloads, TIC::UNFRAMER_DEFAULT_MAX_FRAME_SIZE, benchDispatchByLabelKey);
+	benchExtractDecodeDatasets<TIC::DatasetExtractor>("DatasetView+labelId switch historical, 20 labels, whole frames", historicalPayloads, TIC::UNFRAMER_DEFAULT_MAX_FRAME_SIZE, benchDispatchByLabelId);
+
+	TIC::DatasetLabelFilter standardFilter; /* Labels usually needed by energy monitoring consumers */
+	for (const char* label : { "EAST", "SINSTS", "IRMS1", "URMS1", "DATE" })
+		standardFilter.addLabel(label);
+	benchExtractDecodeDatasets<TIC::DatasetExtractor>("DatasetExtractor+DatasetView standard, 5 labels filtered, 64-byte chunks", standardPayloads, 64, benchDecodeDataset, &standardFilter);
+	benchExtractDecodeDatasets<TIC::DatasetExtractor>("DatasetExtractor+DatasetView standard, 5 labels filtered, whole frames", standardPayloads, TIC::UNFRAMER_DEFAULT_MAX_FRAME_SIZE, benchDecodeDataset, &standardFilter);
+	TIC::DatasetLabelFilter historicalFilter;
+	for (const char* label : { "PAPP", "IINST1", "BASE" })
+		historicalFilter.addLabel(label);
+	benchExtractDecodeDatasets<TIC::DatasetExtractor>("DatasetExtractor+DatasetView historical, 3 labels filtered, 64-byte chunks", historicalPayloads, 64, benchDecodeDataset, &historicalFilter);
+}
@@ -0,0 +1,103 @@
+#include "BenchHarness.h"
+#include "TIC/DatasetView.h"
+
+/**
+ * @brief Dataset values to convert, stored back to back
+ */
+struct BenchValues {
+	std::vector<uint8_t> bytes; /*!< The digits of all values */
+	std::vector<unsigned int> sizes; /*!< The number of digits of each value */
+};
+
+/**
+ * @brief Build @p count values of @p digitCount digits, with varying digits
+ */
+static BenchValues benchBuildValues(unsigned int digitCount, unsigned int count) {
+	BenchValues values = { std::vector<uint8_t>(), std::vector<unsigned int>() };
+	uint32_t seed = 12345;
+	for (unsigned int valueIdx = 0; valueIdx < count; valueIdx++) {
+		for (unsigned int digitIdx = 0; digitIdx < digitCount; digitIdx++) {
+			seed = seed * 1103515245 + 12345;
+			values.bytes.push_back(static_cast<uint8_t>('0' + (seed >> 16) % 10));
+		}
+		values.sizes.push_back(digitCount);
+	}
+	return values;
+}
+
+/**
+ * @brief The digit-by-digit conversion that uint32FromValueBuffer() used before the SWAR implementation, as a reference
+ *
+ * It is not inlined, like the library functions it is compared with
+ */
+__attribute__((noinline)) static uint32_t benchDigitLoopUint32FromValueBuffer(const uint8_t* buf, unsigned int cnt) {
+	uint32_t result = 0;
+	if (cnt == 0)
+		return -1;
+	for (unsigned int idx = 0; idx < cnt; idx++) {
+		uint8_t digit = buf[idx];
+		if (digit < '0' || digit > '9')
+			return -1;
+		if (result > ((uint32_t)-1 / 10))
+			return -1;
+		result *= 10;
+		if (result > (uint32_t)-1 - (digit - '0'))
+			return -1;
+		result += (digit - '0');
+	}
+	return result;
+}
+
+static uint64_t benchConvertWithDigitLoop(const uint8_t* buf, unsigned int cnt) {
+	return benchDigitLoopUint32FromValueBuffer(buf, cnt);
+}
+
+static uint64_t benchConvertUint32(const uint8_t* buf, unsigned int cnt) {
+	return TIC::DatasetView::uint32FromValueBuffer(buf, cnt);
+}
+
+static uint64_t benchConvertUint64(const uint8_t* buf, unsigned int cnt) {
+	bool ok;
+	uint64_t value = TIC::DatasetView::uint64FromValueBuffer(buf, cnt, ok);
+	return ok ? value : 0;
+}
+
+/**
+ * @brief Convert all values with @p convert, repeatedly
+ *
+ * @param name The benchmark name
+ * @param values The values to convert
+ * @param convert The conversion function
+ */
+static void benchConvertValues(const char* name, const BenchValues& values, uint64_t (*convert)(const uint8_t*, unsigned int)) {
+	const unsigned int rounds = 20;
+	uint64_t checksum = 0;
+	BenchTimer timer;
+	BenchCycleCounter cycles;
+	for (unsigned int round = 0; round < rounds; round++) {
+		const uint8_t* value = &(values.bytes[0]);
+		for (unsigned int valueSize : values.sizes) {
+			checksum += convert(value, valueSize);
+			value += valueSize;
+		}
+	}
+	uint64_t elapsedCycles = cycles.elapsedCycles();
+	double seconds = timer.elapsedSeconds();
+	benchReportCycles(name, values.bytes.size() * rounds, values.sizes.size() * rounds, "values", seconds, elapsedCycles);
+	if (checksum == 1) /* Prevent the compiler from optimizing away the conversions */
+		printf("\n");
+}
+
+void runDatasetViewBenchmarks() {
+	BenchValues powerValues = benchBuildValues(5, 1000 * 1000); /* Like PAPP or SINSTS */
+	BenchValues indexValues = benchBuildValues(9, 1000 * 1000); /* Like BASE or historical energy indexes */
+	BenchValues energyValues = benchBuildValues(12, 1000 * 1000); /* Like EAST or EASF01 (only fits in 64 bits) */
+
+	benchConvertValues("Digit loop uint32, 5-digit values", powerValues, benchConvertWithDigitLoop);
+	benchConvertValues("uint32FromValueBuffer() (SWAR), 5-digit values", powerValues, benchConvertUint32);
+	benchConvertValues("uint64FromValueBuffer() (SWAR), 5-digit values", powerValues, benchConvertUint64);
+	benchConvertValues("Digit loop uint32, 9-digit values", indexValues, benchConvertWithDigitLoop);
+	benchConvertValues("uint32FromValueBuffer() (SWAR), 9-digit values", indexValues, benchConvertUint32);
+	benchConvertValues("uint64FromValueBuffer() (SWAR), 9-digit values", indexValues, benchConvertUint64);
+	benchConvertValues("uint64FromValueBuffer() (SWAR), 12-digit values", energyValues, benchConvertUint64);
+}
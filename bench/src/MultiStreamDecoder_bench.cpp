@@ -0,0 +1,85 @@
+#include <stdint.h>
+#include <vector>
+#include <thread>
+
+#include "BenchHarness.h"
+#include "TIC/MultiStreamDecoder.h"
+
+/**
+ * @brief Per-stream counter, aligned on a cache line to avoid false sharing between workers
+ */
+struct alignas(64) StreamDatasetCounter {
+	uint64_t validDatasets;
+};
+
+static void benchOnStreamDataset(unsigned int streamId, const TIC::DatasetView& dv, void* context) {
+	StreamDatasetCounter* counters = static_cast<StreamDatasetCounter*>(context);
+	if (dv.isValid())
+		counters[streamId].validDatasets++;
+}
+
+/**
+ * @brief Replay a synthetic capture on many streams through a TIC::MultiStreamDecoder
+ *
+ * @param captures The captures replayed (stream n replays captures[n % captures.size()], starting at a stream-specific offset)
+ * @param streamCount The number of streams
+ * @param bytesPerStream The number of bytes replayed on each stream
+ * @param batchSize The size of each batch submitted for one stream
+ * @param workerCount The number of worker threads
+ * @return The throughput in bytes per second
+ */
+static double benchMultiStreamReplay(const std::vector<std::vector<uint8_t> >& captures, unsigned int streamCount, unsigned int bytesPerStream, unsigned int batchSize, unsigned int workerCount) {
+	std::vector<StreamDatasetCounter> counters(streamCount, StreamDatasetCounter{0});
+	TIC::MultiStreamDecoder msd(streamCount, workerCount, benchOnStreamDataset, &(counters[0]));
+
+	BenchTimer timer;
+	/* Round-robin over streams, one batch at a time, as data would arrive from many serial lines */
+	for (unsigned int streamPos = 0; streamPos < bytesPerStream; streamPos += batchSize) {
+		for (unsigned int streamId = 0; streamId < streamCount; streamId++) {
+			const std::vector<uint8_t>& capture = captures[streamId % captures.size()];
+			unsigned int startOffset = (streamId * 37) % (capture.size() - bytesPerStream);
+			msd.pushBytes(streamId, &(capture[startOffset + streamPos]), batchSize);
+		}
+	}
+	msd.flush();
+	double seconds = timer.elapsedSeconds();
+
+	uint64_t validDatasets = 0;
+	for (auto& counter : counters) {
+		validDatasets += counter.validDatasets;
+	}
+	char name[80];
+	snprintf(name, sizeof(name), "MultiStreamDecoder %u streams, %u worker(s)", streamCount, workerCount);
+	benchReport(name, static_cast<uint64_t>(streamCount) * bytesPerStream, validDatasets, "valid datasets", seconds);
+	printf("%-56s %llu stolen tasks\n", "", static_cast<unsigned long long>(msd.getStolenTaskCount()));
+	return static_cast<double>(streamCount) * bytesPerStream / seconds;
+}
+
+void runMultiStreamDecoderBenchmarks() {
+	const unsigned int streamCount = 1000;
+	const unsigned int batchSize = 4096;
+	const unsigned int bytesPerStream = 25 * batchSize; /* 100MB replayed in total */
+	std::vector<std::vector<uint8_t> > captures;
+	captures.push_back(benchBuildRepeatedCapture("../test/samples/continuous_linky_1P_standard_TIC_sample.bin", bytesPerStream + 4096));
+	captures.push_back(benchBuildRepeatedCapture("../test/samples/continuous_linky_3P_historical_TIC_sample.bin", bytesPerStream + 4096));
+	captures.push_back(benchBuildRepeatedCapture("../test/samples/linky_1P_midnight.bin", bytesPerStream + 4096));
+	for (auto& capture : captures) {
+		if (capture.empty())
+			return;
+	}
+
+	unsigned int maxWorkers = std::thread::hardware_concurrency();
+	if (maxWorkers == 0)
+		maxWorkers = 1;
+	double singleWorkerThroughput = 0;
+	for (unsigned int workerCount = 1; ; workerCount *= 2) {
+		if (workerCount > maxWorkers)
+			workerCount = maxWorkers;
+		double throughput = benchMultiStreamReplay(captures, streamCount, bytesPerStream, batchSize, workerCount);
+		if (workerCount == 1)
+			singleWorkerThroughput = throughput;
+		printf("%-56s speedup x%.2f over 1 worker (%u hardware thread(s))\n", "", throughput / singleWorkerThroughput, maxWorkers);
+		if (workerCount == maxWorkers)
+			break;
+	}
+}
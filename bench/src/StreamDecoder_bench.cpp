@@ -0,0 +1,100 @@
+#include <stdint.h>
+#include <vector>
+
+#include "BenchHarness.h"
+#include "TIC/Unframer.h"
+#include "TIC/DatasetExtractor.h"
+#include "TIC/DatasetView.h"
+#include "TIC/StreamDecoder.h"
+
+/**
+ * @brief Counters updated by the callbacks of the benchmarked decoders
+ */
+struct StreamDecoderBenchContext {
+	TIC::DatasetExtractor* de;
+	uint64_t datasetCount;
+	uint64_t validDatasetCount;
+};
+
+static void benchOnDatasetView(const TIC::DatasetView& dv, void* context) {
+	StreamDecoderBenchContext* ctx = static_cast<StreamDecoderBenchContext*>(context);
+	ctx->datasetCount++;
+	if (dv.isValid())
+		ctx->validDatasetCount++;
+}
+
+static void benchOnDatasetExtracted(const uint8_t* buf, unsigned int cnt, void* context) {
+	benchOnDatasetView(TIC::DatasetView(buf, cnt), context);
+}
+
+static void benchOnNewFrameBytes(const uint8_t* buf, unsigned int cnt, void* context) {
+	StreamDecoderBenchContext* ctx = static_cast<StreamDecoderBenchContext*>(context);
+	ctx->de->pushBytes(buf, cnt);
+}
+
+static void benchOnFrameComplete(void* context) {
+	StreamDecoderBenchContext* ctx = static_cast<StreamDecoderBenchContext*>(context);
+	ctx->de->reset();
+}
+
+/**
+ * @brief Decode a whole capture into TIC::DatasetView objects with the three stages pipeline (TIC::Unframer, TIC::DatasetExtractor, TIC::DatasetView)
+ *
+ * @param name The benchmark name
+ * @param capture The capture to decode
+ * @param chunkSize The size of each chunk pushed to the decoder
+ */
+static void benchPipeline(const char* name, const std::vector<uint8_t>& capture, size_t chunkSize) {
+	StreamDecoderBenchContext ctx = { nullptr, 0, 0 };
+	TIC::DatasetExtractor de(benchOnDatasetExtracted, &ctx);
+	ctx.de = &de;
+	TIC::BasicUnframer<TIC::UnframerForwardOnTheFly, TIC::UNFRAMER_DEFAULT_MAX_FRAME_SIZE> tu(benchOnNewFrameBytes, benchOnFrameComplete, &ctx);
+
+	BenchTimer timer;
+	BenchCycleCounter cycles;
+	for (size_t pos = 0; pos < capture.size(); pos += chunkSize) {
+		size_t len = capture.size() - pos;
+		if (len > chunkSize)
+			len = chunkSize;
+		tu.pushBytes(&(capture[pos]), static_cast<unsigned int>(len));
+	}
+	uint64_t elapsedCycles = cycles.elapsedCycles();
+	double seconds = timer.elapsedSeconds();
+	benchReportCycles(name, capture.size(), ctx.validDatasetCount, "valid datasets", seconds, elapsedCycles);
+}
+
+/**
+ * @brief Same as benchPipeline(), using the fused TIC::StreamDecoder
+ */
+static void benchStreamDecoder(const char* name, const std::vector<uint8_t>& capture, size_t chunkSize) {
+	StreamDecoderBenchContext ctx = { nullptr, 0, 0 };
+	TIC::StreamDecoder sd(benchOnDatasetView, &ctx);
+
+	BenchTimer timer;
+	BenchCycleCounter cycles;
+	for (size_t pos = 0; pos < capture.size(); pos += chunkSize) {
+		size_t len = capture.size() - pos;
+		if (len > chunkSize)
+			len = chunkSize;
+		sd.pushBytes(&(capture[pos]), static_cast<unsigned int>(len));
+	}
+	uint64_t elapsedCycles = cycles.elapsedCycles();
+	double seconds = timer.elapsedSeconds();
+	benchReportCycles(name, capture.size(), ctx.validDatasetCount, "valid datasets", seconds, elapsedCycles);
+}
+
+void runStreamDecoderBenchmarks() {
+	std::vector<uint8_t> standardCapture = benchBuildRepeatedCapture("../test/samples/continuous_linky_1P_standard_TIC_sample.bin", 100 * 1000 * 1000);
+	std::vector<uint8_t> historicalCapture = benchBuildRepeatedCapture("../test/samples/continuous_linky_3P_historical_TIC_sample.bin", 100 * 1000 * 1000);
+	if (standardCapture.empty() || historicalCapture.empty())
+		return;
+
+	benchPipeline("3-stage pipeline standard, 4096-byte chunks", standardCapture, 4096);
+	benchStreamDecoder("StreamDecoder standard, 4096-byte chunks", standardCapture, 4096);
+	benchPipeline("3-stage pipeline standard, 64-byte chunks", standardCapture, 64);
+	benchStreamDecoder("StreamDecoder standard, 64-byte chunks", standardCapture, 64);
+	benchPipeline("3-stage pipeline historical, 4096-byte chunks", historicalCapture, 4096);
+	benchStreamDecoder("StreamDecoder historical, 4096-byte chunks", historicalCapture, 4096);
+	benchPipeline("3-stage pipeline historical, 64-byte chunks", historicalCapture, 64);
+	benchStreamDecoder("StreamDecoder historical, 64-byte chunks", historicalCapture, 64);
+}
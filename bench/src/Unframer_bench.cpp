@@ -0,0 +1,172 @@
+#include <stdint.h>
+#include <vector>
+
+#include "BenchHarness.h"
+#include "TIC/Unframer.h"
+#include "TIC/DatasetExtractor.h"
+
+/**
+ * @brief Counters updated by the callbacks of the benchmarked decoding chain
+ */
+struct UnframerBenchContext {
+	TIC::DatasetExtractor* de;
+	uint64_t frameCount;
+	uint64_t datasetCount;
+	uint64_t datasetBytes;
+};
+
+static void benchOnDatasetExtracted(const uint8_t* buf, unsigned int cnt, void* context) {
+	UnframerBenchContext* ctx = static_cast<UnframerBenchContext*>(context);
+	ctx->datasetCount++;
+	ctx->datasetBytes += cnt;
+}
+
+static void benchOnNewFrameBytes(const uint8_t* buf, unsigned int cnt, void* context) {
+	UnframerBenchContext* ctx = static_cast<UnframerBenchContext*>(context);
+	ctx->de->pushBytes(buf, cnt);
+}
+
+static void benchOnFrameComplete(void* context) {
+	UnframerBenchContext* ctx = static_cast<UnframerBenchContext*>(context);
+	ctx->frameCount++;
+	ctx->de->reset();
+}
+
+/**
+ * @brief Decode a whole capture through a TIC::Unframer and a TIC::DatasetExtractor, feeding it by chunks
+ *
+ * @param name The benchmark name
+ * @param capture The capture to decode
+ * @param chunkSize The size of each chunk pushed to the unframer (use capture.size() to push the whole capture in one call)
+ */
+static void benchUnframeAndExtract(const char* name, const std::vector<uint8_t>& capture, size_t chunkSize) {
+	UnframerBenchContext ctx = { nullptr, 0, 0, 0 };
+	TIC::DatasetExtractor de(benchOnDatasetExtracted, &ctx);
+	ctx.de = &de;
+	TIC::Unframer tu(benchOnNewFrameBytes, benchOnFrameComplete, &ctx);
+
+	BenchTimer timer;
+	for (size_t pos = 0; pos < capture.size(); pos += chunkSize) {
+		size_t len = capture.size() - pos;
+		if (len > chunkSize)
+			len = chunkSize;
+		tu.pushBytes(&(capture[pos]), static_cast<unsigned int>(len));
+	}
+	double seconds = timer.elapsedSeconds();
+	benchReport(name, capture.size(), ctx.datasetCount, "datasets", seconds);
+}
+
+/**
+ * @brief Dataset sink counting datasets, used for the compile-time sink benchmarks
+ */
+struct BenchDatasetCounter {
+	UnframerBenchContext* ctx;
+	void operator()(const uint8_t* buf, unsigned int cnt) {
+		this->ctx->datasetCount++;
+		this->ctx->datasetBytes += cnt;
+	}
+};
+
+/**
+ * @brief Same as benchUnframeAndExtract(), but the Unframer->DatasetExtractor->counter chain uses compile-time sinks instead of function pointers
+ */
+static void benchUnframeAndExtractWithSinks(const char* name, const std::vector<uint8_t>& capture, size_t chunkSize) {
+	typedef TIC::BasicDatasetExtractor<TIC::DatasetExtractorTruncateAndDeliver, TIC::DATASET_EXTRACTOR_DEFAULT_MAX_DATASET_SIZE, BenchDatasetCounter> CountingDatasetExtractor;
+	typedef TIC::UnframerDatasetExtractorSink<CountingDatasetExtractor> FrameSink;
+	UnframerBenchContext ctx = { nullptr, 0, 0, 0 };
+	CountingDatasetExtractor de(BenchDatasetCounter{&ctx});
+	TIC::BasicUnframer<TIC::UnframerForwardOnTheFly, TIC::UNFRAMER_DEFAULT_MAX_FRAME_SIZE, FrameSink> tu{FrameSink(de)};
+
+	BenchTimer timer;
+	for (size_t pos = 0; pos < capture.size(); pos += chunkSize) {
+		size_t len = capture.size() - pos;
+		if (len > chunkSize)
+			len = chunkSize;
+		tu.pushBytes(&(capture[pos]), static_cast<unsigned int>(len));
+	}
+	double seconds = timer.elapsedSeconds();
+	benchReport(name, capture.size(), ctx.datasetCount, "datasets", seconds);
+}
+
+/**
+ * @brief Feed the compile-time sink chain one byte at a time, as a UART receive loop would
+ *
+ * @param name The benchmark name
+ * @param capture The TIC stream to decode
+ * @param usePushByte true to feed bytes with pushByte(), false to feed them with pushBytes(&byte, 1)
+ */
+static void benchUnframeAndExtractByteByByte(const char* name, const std::vector<uint8_t>& capture, bool usePushByte) {
+	typedef TIC::BasicDatasetExtractor<TIC::DatasetExtractorTruncateAndDeliver, TIC::DATASET_EXTRACTOR_DEFAULT_MAX_DATASET_SIZE, BenchDatasetCounter> CountingDatasetExtractor;
+	typedef TIC::UnframerDatasetExtractorSink<CountingDatasetExtractor> FrameSink;
+	UnframerBenchContext ctx = { nullptr, 0, 0, 0 };
+	CountingDatasetExtractor de(BenchDatasetCounter{&ctx});
+	TIC::BasicUnframer<TIC::UnframerForwardOnTheFly, TIC::UNFRAMER_DEFAULT_MAX_FRAME_SIZE, FrameSink> tu{FrameSink(de)};
+
+	BenchTimer timer;
+	if (usePushByte) {
+		for (size_t pos = 0; pos < capture.size(); pos++)
+			tu.pushByte(capture[pos]);
+	}
+	else {
+		for (size_t pos = 0; pos < capture.size(); pos++)
+			tu.pushBytes(&(capture[pos]), 1);
+	}
+	double seconds = timer.elapsedSeconds();
+	benchReport(name, capture.size(), ctx.datasetCount, "datasets", seconds);
+}
+
+static void benchOnWholeFrame(const uint8_t* buf, unsigned int cnt, void* context) {
+	UnframerBenchContext* ctx = static_cast<UnframerBenchContext*>(context);
+	ctx->datasetBytes += buf[cnt / 2]; /* Touch the frame content */
+}
+
+static void benchOnWholeFrameComplete(void* context) {
+	UnframerBenchContext* ctx = static_cast<UnframerBenchContext*>(context);
+	ctx->frameCount++;
+}
+
+/**
+ * @brief Unframe a whole capture in buffered (whole frame) mode, feeding it by chunks
+ *
+ * @param name The benchmark name
+ * @param capture The capture to decode
+ * @param chunkSize The size of each chunk pushed to the unframer (frames contained in one chunk are delivered without copy)
+ */
+static void benchUnframeBuffered(const char* name, const std::vector<uint8_t>& capture, size_t chunkSize) {
+	UnframerBenchContext ctx = { nullptr, 0, 0, 0 };
+	TIC::BasicUnframer<TIC::UnframerBufferWholeFrame, TIC::UNFRAMER_DEFAULT_MAX_FRAME_SIZE> tu(benchOnWholeFrame, benchOnWholeFrameComplete, &ctx);
+
+	BenchTimer timer;
+	for (size_t pos = 0; pos < capture.size(); pos += chunkSize) {
+		size_t len = capture.size() - pos;
+		if (len > chunkSize)
+			len = chunkSize;
+		tu.pushBytes(&(capture[pos]), static_cast<unsigned int>(len));
+	}
+	double seconds = timer.elapsedSeconds();
+	benchReport(name, capture.size(), ctx.frameCount, "frames", seconds);
+}
+
+void runUnframerBenchmarks() {
+	std::vector<uint8_t> standardCapture = benchBuildRepeatedCapture("../test/samples/continuous_linky_1P_standard_TIC_sample.bin", 100 * 1000 * 1000);
+	std::vector<uint8_t> historicalCapture = benchBuildRepeatedCapture("../test/samples/continuous_linky_3P_historical_TIC_sample.bin", 100 * 1000 * 1000);
+	if (standardCapture.empty() || historicalCapture.empty())
+		return;
+
+	benchUnframeAndExtract("Unframer+DatasetExtractor standard, one 100MB push", standardCapture, standardCapture.size());
+	benchUnframeAndExtract("Unframer+DatasetExtractor standard, 4096-byte chunks", standardCapture, 4096);
+	benchUnframeAndExtract("Unframer+DatasetExtractor standard, 64-byte chunks", standardCapture, 64);
+	benchUnframeAndExtract("Unframer+DatasetExtractor historical, one 100MB push", historicalCapture, historicalCapture.size());
+	benchUnframeAndExtract("Unframer+DatasetExtractor historical, 4096-byte chunks", historicalCapture, 4096);
+	benchUnframeAndExtract("Unframer+DatasetExtractor historical, 64-byte chunks", historicalCapture, 64);
+	benchUnframeAndExtractWithSinks("Sink chain standard, one 100MB push", standardCapture, standardCapture.size());
+	benchUnframeAndExtractWithSinks("Sink chain standard, 64-byte chunks", standardCapture, 64);
+	benchUnframeAndExtractWithSinks("Sink chain historical, one 100MB push", historicalCapture, historicalCapture.size());
+	benchUnframeAndExtractWithSinks("Sink chain historical, 64-byte chunks", historicalCapture, 64);
+	benchUnframeAndExtractByteByByte("Sink chain standard, byte per byte with pushBytes(&c,1)", standardCapture, false);
+	benchUnframeAndExtractByteByByte("Sink chain standard, byte per byte with pushByte()", standardCapture, true);
+	benchUnframeAndExtractByteByByte("Sink chain historical, byte per byte with pushBytes(&c,1)", historicalCapture, false);
+	benchUnframeAndExtractByteByByte("Sink chain historical, byte per byte with pushByte()", historicalCapture, true);
+	benchUnframeBuffered("Buffered Unframer standard, one 100MB push (zero-copy)", standardCapture, standardCapture.size());
+	benchUnframeBuffered("Buffered Unframer standard, 64-byte chunks (copy)", standardCapture, 64);
+}
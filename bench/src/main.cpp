@@ -0,0 +1,13 @@
+extern void runUnframerBenchmarks();
+extern void runDatasetExtractorBenchmarks();
+extern void runDatasetViewBenchmarks();
+extern void runStreamDecoderBenchmarks();
+extern void runMultiStreamDecoderBenchmarks();
+
+int main(void) {
+    runUnframerBenchmarks();
+    runDatasetExtractorBenchmarks();
+    runDatasetViewBenchmarks();
+    runStreamDecoderBenchmarks();
+    runMultiStreamDecoderBenchmarks();
+}
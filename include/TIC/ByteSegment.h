@@ -0,0 +1,23 @@
+/**
+ * @file ByteSegment.h
+ * @brief Description of one contiguous segment of a discontiguous byte stream
+ */
+#pragma once
+#include <stdint.h>
+
+namespace TIC {
+/**
+ * @brief One contiguous segment of bytes, used to push a discontiguous stream (for example the two halves of a wrapped ring buffer) in one call
+ *
+ * This is the portable equivalent of POSIX's struct iovec (that is not available on all targets of this library):
+
+struct iovec iov[2];
+TIC::ByteSegment segments[2];
+for (unsigned int i = 0; i < 2; i++)
+  segments[i] = TIC::ByteSegment{ static_cast<const uint8_t*>(iov[i].iov_base), static_cast<unsigned int>(iov[i].iov_len) };
+ */
+struct ByteSegment {
+    const uint8_t* buffer; /*!< The first byte of the segment */
+    unsigned int len; /*!< The number of bytes in the segment */
+};
+} // namespace TIC
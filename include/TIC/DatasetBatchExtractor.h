@@ -0,0 +1,244 @@
+/**
+ * @file DatasetBatchExtractor.h
+ * @brief Frame-scoped TIC dataset extractor, delivering an index of all datasets of a frame at once
+ */
+#pragma once
+#include <stdint.h>
+
+#include "TIC/DatasetExtractor.h"
+#include "TIC/DatasetSpan.h"
+
+namespace TIC {
+/**
+ * @brief Types and constants common to all TIC::BasicDatasetBatchExtractor template instances
+ */
+class DatasetBatchExtractorBase {
+public:
+/* Types */
+    typedef void(*FOnFrameDatasetsFunc)(const uint8_t* frame, unsigned int frameSize, const DatasetSpan* spans, unsigned int spanCount, void* context); /*!< The prototype of callbacks invoked onFrameDatasets */
+
+/* Constants */
+    static constexpr unsigned int MAX_FRAME_SIZE = 65535; /*!< Max frame size (so that offsets and lengths fit in a DatasetSpan) */
+};
+
+/**
+ * @brief Batch sink invoking a C-style function pointer with a context pointer (this is the sink used by TIC::DatasetBatchExtractor)
+ */
+class DatasetBatchCallbackSink {
+public:
+    DatasetBatchCallbackSink(DatasetBatchExtractorBase::FOnFrameDatasetsFunc onFrameDatasets, void* onFrameDatasetsContext) :
+    onFrameDatasets(onFrameDatasets),
+    onFrameDatasetsContext(onFrameDatasetsContext) { }
+
+    void operator()(const uint8_t* frame, unsigned int frameSize, const DatasetSpan* spans, unsigned int spanCount) {
+        if (this->onFrameDatasets)
+            this->onFrameDatasets(frame, frameSize, spans, spanCount, this->onFrameDatasetsContext);
+    }
+
+private:
+    DatasetBatchExtractorBase::FOnFrameDatasetsFunc onFrameDatasets; /*!< A function pointer invoked once per frame */
+    void* onFrameDatasetsContext; /*!< A context pointer passed to onFrameDatasets() at invokation */
+};
+
+/**
+ * @brief The spans of the datasets found so far in the current frame
+ *
+ * @tparam MaxDatasetsPerFrame The max number of spans stored
+ */
+template<unsigned int MaxDatasetsPerFrame>
+struct DatasetSpanIndex {
+    const uint8_t* frame; /*!< The frame being indexed */
+    DatasetSpan spans[MaxDatasetsPerFrame]; /*!< The spans of datasets found in frame */
+    unsigned int spanCount; /*!< The number of valid entries in spans */
+    uint32_t droppedDatasets; /*!< Total number of datasets that did not fit in spans */
+};
+
+/**
+ * @brief Dataset sink recording the location of each dataset into a DatasetSpanIndex
+ *
+ * @note This sink is stored inside a TIC::BasicDatasetExtractor, and is inlined in its extraction loop
+ */
+template<unsigned int MaxDatasetsPerFrame>
+class DatasetSpanCollector {
+public:
+    explicit DatasetSpanCollector(DatasetSpanIndex<MaxDatasetsPerFrame>* index) :
+    index(index) { }
+
+    void operator()(const uint8_t* buf, unsigned int cnt) {
+        if (this->index->spanCount >= MaxDatasetsPerFrame) {
+            this->index->droppedDatasets++;
+            return;
+        }
+        DatasetSpan& span = this->index->spans[this->index->spanCount++];
+        span.offset = static_cast<uint16_t>(buf - this->index->frame); /* Datasets contained in a single pushBytes() call are delivered without copy, so buf points inside the frame */
+        span.length = static_cast<uint16_t>(cnt);
+    }
+
+private:
+    DatasetSpanIndex<MaxDatasetsPerFrame>* index; /*!< The index to fill */
+};
+
+/**
+ * @brief Class extracting all TIC datasets of a whole frame, and delivering them in one call as a list of spans inside the frame buffer
+ *
+ * Compared to TIC::DatasetExtractor, that invokes a callback for each dataset, this class invokes its sink only once per frame, with:
+ * * The frame buffer (as provided to pushFrame())
+ * * The size of the frame buffer
+ * * An array of DatasetSpan, one per dataset, in the order they appear in the frame (each span locates a dataset payload, excluding start and end markers, inside the frame buffer)
+ * * The number of entries in the above array
+ * Downstream code can thus process all datasets of a frame in a single loop, while the frame is still hot in cache, and knows where frames start and end.
+ *
+ * Datasets are extracted by a TIC::BasicDatasetExtractor (with the default settings of TIC::DatasetExtractor), so the datasets listed are exactly those that TIC::DatasetExtractor would deliver for the same frame.
+ * As the whole frame is pushed at once, no dataset byte is copied.
+ * If a frame contains more than @p MaxDatasetsPerFrame datasets, the extra datasets are not listed, and are counted in getDroppedDatasets()
+ *
+ * Frames are usually provided by a TIC::BasicUnframer in UnframerBufferWholeFrame mode, as it forwards each frame in one chunk, using a UnframerDatasetBatchSink:
+
+void onFrameDatasets(const uint8_t* frame, unsigned int frameSize, const TIC::DatasetSpan* spans, unsigned int spanCount, void* context) {
+  for (unsigned int idx = 0; idx < spanCount; idx++) {
+    TIC::DatasetView dv(frame + spans[idx].offset, spans[idx].length);
+    ...
+  }
+}
+
+TIC::DatasetBatchExtractor batchExtractor(onFrameDatasets, nullptr);
+TIC::BasicUnframer<TIC::UnframerBufferWholeFrame, TIC::UNFRAMER_DEFAULT_MAX_FRAME_SIZE, TIC::UnframerDatasetBatchSink<TIC::DatasetBatchExtractor> > unframer{TIC::UnframerDatasetBatchSink<TIC::DatasetBatchExtractor>(batchExtractor)};
+unframer.pushBytes(inputBytes, sizeof(inputBytes));
+ *
+ * @tparam MaxDatasetsPerFrame The max number of datasets listed for each frame
+ * @tparam BatchSink The callable type invoked once per frame, as sink(frame, frameSize, spans, spanCount)
+ */
+template<unsigned int MaxDatasetsPerFrame, typename BatchSink = DatasetBatchCallbackSink>
+class BasicDatasetBatchExtractor : public DatasetBatchExtractorBase {
+public:
+/* Types */
+    typedef BasicDatasetExtractor<DatasetExtractorTruncateAndDeliver, DATASET_EXTRACTOR_DEFAULT_MAX_DATASET_SIZE, DatasetSpanCollector<MaxDatasetsPerFrame> > SpanExtractor; /*!< The dataset extractor used internally */
+
+/* Constants */
+    static constexpr unsigned int MAX_DATASETS_PER_FRAME = MaxDatasetsPerFrame; /*!< The max number of datasets listed for each frame */
+
+/* Methods */
+    /**
+     * @brief Construct a new TIC::BasicDatasetBatchExtractor object invoking a function pointer (only available with DatasetBatchCallbackSink)
+     *
+     * @param onFrameDatasets A FOnFrameDatasetsFunc function to invoke once per frame
+     * @param onFrameDatasetsContext A user-defined pointer that will be passed as last argument when invoking onFrameDatasets()
+     */
+    BasicDatasetBatchExtractor(FOnFrameDatasetsFunc onFrameDatasets = nullptr, void* onFrameDatasetsContext = nullptr);
+
+    /**
+     * @brief Construct a new TIC::BasicDatasetBatchExtractor object invoking a compile-time sink
+     *
+     * @param onFrameDatasets The callable to invoke once per frame (it is copied into the extractor)
+     */
+    explicit BasicDatasetBatchExtractor(const BatchSink& onFrameDatasets);
+
+    /* The internal dataset extractor refers to our own span index, so instances cannot be copied */
+    BasicDatasetBatchExtractor(const BasicDatasetBatchExtractor&) = delete;
+    BasicDatasetBatchExtractor& operator=(const BasicDatasetBatchExtractor&) = delete;
+
+    /**
+     * @brief Extract all datasets of a whole frame, and deliver their spans to the sink
+     *
+     * @param frame The frame payload (start and end of frame markers excluded)
+     * @param frameSize The number of bytes in @p frame (at most MAX_FRAME_SIZE)
+     * @return The number of datasets listed
+     */
+    unsigned int pushFrame(const uint8_t* frame, unsigned int frameSize);
+
+    /**
+     * @brief Get the total number of datasets that could not be listed because their frame contained more than MAX_DATASETS_PER_FRAME datasets
+     */
+    uint32_t getDroppedDatasets() const;
+
+    /**
+     * @brief Get the error counters of the internal dataset extractor
+     */
+    const DecodeErrorCounters& getErrorCounters() const;
+
+    /**
+     * @brief Set the function to invoke for each error detected by the internal dataset extractor
+     *
+     * @param onError A FOnDecodeErrorFunc function to invoke for each error, or nullptr to only update error counters
+     * @param onErrorContext A user-defined pointer that will be passed as last argument when invoking onError()
+     */
+    void setErrorCallback(FOnDecodeErrorFunc onError, void* onErrorContext = nullptr);
+
+private:
+/* Attributes */
+    BatchSink onFrameDatasets; /*!< The sink invoked once per frame */
+    DatasetSpanIndex<MaxDatasetsPerFrame> index; /*!< The spans of the datasets of the current frame */
+    SpanExtractor extractor; /*!< The dataset extractor filling index */
+};
+
+template<unsigned int MaxDatasetsPerFrame, typename BatchSink>
+BasicDatasetBatchExtractor<MaxDatasetsPerFrame, BatchSink>::BasicDatasetBatchExtractor(FOnFrameDatasetsFunc onFrameDatasets, void* onFrameDatasetsContext) :
+onFrameDatasets(onFrameDatasets, onFrameDatasetsContext),
+index(),
+extractor(DatasetSpanCollector<MaxDatasetsPerFrame>(&(this->index))) {
+}
+
+template<unsigned int MaxDatasetsPerFrame, typename BatchSink>
+BasicDatasetBatchExtractor<MaxDatasetsPerFrame, BatchSink>::BasicDatasetBatchExtractor(const BatchSink& onFrameDatasets) :
+onFrameDatasets(onFrameDatasets),
+index(),
+extractor(DatasetSpanCollector<MaxDatasetsPerFrame>(&(this->index))) {
+}
+
+template<unsigned int MaxDatasetsPerFrame, typename BatchSink>
+unsigned int BasicDatasetBatchExtractor<MaxDatasetsPerFrame, BatchSink>::pushFrame(const uint8_t* frame, unsigned int frameSize) {
+    if (frameSize > MAX_FRAME_SIZE)
+        frameSize = MAX_FRAME_SIZE; /* Offsets beyond would not fit in a DatasetSpan */
+    this->index.frame = frame;
+    this->index.spanCount = 0;
+    this->extractor.reset(); /* Any unterminated dataset of the previous frame is discarded */
+    this->extractor.pushBytes(frame, frameSize);
+    this->onFrameDatasets(frame, frameSize, this->index.spans, this->index.spanCount);
+    return this->index.spanCount;
+}
+
+template<unsigned int MaxDatasetsPerFrame, typename BatchSink>
+uint32_t BasicDatasetBatchExtractor<MaxDatasetsPerFrame, BatchSink>::getDroppedDatasets() const {
+    return this->index.droppedDatasets;
+}
+
+template<unsigned int MaxDatasetsPerFrame, typename BatchSink>
+const DecodeErrorCounters& BasicDatasetBatchExtractor<MaxDatasetsPerFrame, BatchSink>::getErrorCounters() const {
+    return this->extractor.getErrorCounters();
+}
+
+template<unsigned int MaxDatasetsPerFrame, typename BatchSink>
+void BasicDatasetBatchExtractor<MaxDatasetsPerFrame, BatchSink>::setErrorCallback(FOnDecodeErrorFunc onError, void* onErrorContext) {
+    this->extractor.setErrorCallback(onError, onErrorContext);
+}
+
+/**
+ * @brief Frame sink forwarding each whole frame to a dataset batch extractor
+ *
+ * @warning This sink must be used with a TIC::BasicUnframer in UnframerBufferWholeFrame mode, so that each frame is received in a single onNewFrameBytes() call
+ *
+ * @tparam DatasetBatchExtractorType The type of the dataset batch extractor (for example a TIC::BasicDatasetBatchExtractor)
+ */
+template<typename DatasetBatchExtractorType>
+class UnframerDatasetBatchSink {
+public:
+    explicit UnframerDatasetBatchSink(DatasetBatchExtractorType& batchExtractor) :
+    batchExtractor(&batchExtractor) { }
+
+    void onNewFrameBytes(const uint8_t* buf, unsigned int cnt) {
+        this->batchExtractor->pushFrame(buf, cnt);
+    }
+
+    void onFrameComplete() { } /* Datasets have already been delivered along with the whole frame */
+
+private:
+    DatasetBatchExtractorType* batchExtractor; /*!< The dataset batch extractor to feed */
+};
+
+static constexpr unsigned int DATASET_BATCH_DEFAULT_MAX_DATASETS_PER_FRAME = 128; /*!< Max number of datasets per frame used by TIC::DatasetBatchExtractor */
+
+typedef BasicDatasetBatchExtractor<DATASET_BATCH_DEFAULT_MAX_DATASETS_PER_FRAME> DatasetBatchExtractor; /*!< The dataset batch extractor with default settings, invoking a C-style function pointer */
+
+/* The default flavour is instanciated once in DatasetBatchExtractor.cpp */
+extern template class BasicDatasetBatchExtractor<DATASET_BATCH_DEFAULT_MAX_DATASETS_PER_FRAME>;
+} // namespace TIC
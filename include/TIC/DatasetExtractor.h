@@ -4,18 +4,214 @@
  */
 #pragma once
 #include <stdint.h>
+#include <string.h> // For memcpy() and memchr()
+#include "TIC/ByteSegment.h"
+#include "TIC/DecodeErrors.h"
+#include "TIC/MarkerScanner.h"
+#include "TIC/DatasetView.h" // For DatasetPrescan
+#include "TIC/DatasetLabelFilter.h"
+#include "TIC/TicModeDetector.h"
 
 namespace TIC {
+/**
+ * @brief Types and constants common to all TIC::BasicDatasetExtractor template instances
+ */
+class DatasetExtractorBase {
+public:
+/* Types */
+    typedef void(*FDatasetParserFunc)(const uint8_t* buf, unsigned int cnt, void* context); /*!< The prototype of callbacks invoked onDatasetExtracted */
+    typedef void(*FDatasetPrescanParserFunc)(const uint8_t* buf, unsigned int cnt, const DatasetPrescan& prescan, void* context); /*!< The prototype of callbacks invoked onDatasetExtracted, with the prescan of the dataset */
+    typedef void(*FDatasetViewFunc)(const DatasetView& dataset, void* context); /*!< The prototype of callbacks invoked onDatasetExtracted, with the decoded dataset */
+    typedef TIC::TicMode TicMode; /*!< The TIC mode of the stream, selecting which bytes can end a dataset */
+
+/* Constants */
+    static constexpr uint8_t LF = 0x0a;
+    static constexpr uint8_t CR = 0x0d;
+    static constexpr uint8_t START_MARKER = LF; /*!< Dataset start marker (line feed) */
+    static constexpr uint8_t END_MARKER_TIC_1 = CR; /*!< 1st possible dataset end marker for TIC (carriage return) */
+    static constexpr uint8_t END_MARKER_TIC_2 = LF; /*!< 2nd possible dataset end marker for TIC (line feed) */
+    static constexpr uint8_t HT = 0x09; /*!< Horizontal tab, the delimiter inside standard TIC datasets */
+    static constexpr uint8_t SP = 0x20; /*!< Space, the delimiter inside historical TIC datasets */
+};
+
+/**
+ * @brief Dataset sink invoking a C-style function pointer with a context pointer (this is the sink used by TIC::DatasetExtractor)
+ */
+class DatasetExtractorCallbackSink {
+public:
+    DatasetExtractorCallbackSink(DatasetExtractorBase::FDatasetParserFunc onDatasetExtracted, void* onDatasetExtractedContext) :
+    onDatasetExtracted(onDatasetExtracted),
+    onDatasetExtractedContext(onDatasetExtractedContext) { }
+
+    void operator()(const uint8_t* buf, unsigned int cnt) {
+        if (this->onDatasetExtracted)
+            this->onDatasetExtracted(buf, cnt, this->onDatasetExtractedContext);
+    }
+
+private:
+    DatasetExtractorBase::FDatasetParserFunc onDatasetExtracted; /*!< A function pointer invoked for each valid TIC dataset extracted */
+    void* onDatasetExtractedContext; /*!< A context pointer passed to onDatasetExtracted() at invokation */
+};
+
+/**
+ * @brief Dataset sink invoking a C-style function pointer with the dataset, its prescan, and a context pointer (this is the sink used by TIC::PrescanDatasetExtractor)
+ *
+ * The prescan can be provided to the TIC::DatasetView constructors taking a DatasetPrescan, that then check and split the dataset without reading it again
+ */
+class DatasetExtractorPrescanCallbackSink {
+public:
+    DatasetExtractorPrescanCallbackSink(DatasetExtractorBase::FDatasetPrescanParserFunc onDatasetExtracted, void* onDatasetExtractedContext) :
+    onDatasetExtracted(onDatasetExtracted),
+    onDatasetExtractedContext(onDatasetExtractedContext) { }
+
+    void operator()(const uint8_t* buf, unsigned int cnt, const DatasetPrescan& prescan) {
+        if (this->onDatasetExtracted)
+            this->onDatasetExtracted(buf, cnt, prescan, this->onDatasetExtractedContext);
+    }
+
+private:
+    DatasetExtractorBase::FDatasetPrescanParserFunc onDatasetExtracted; /*!< A function pointer invoked for each valid TIC dataset extracted */
+    void* onDatasetExtractedContext; /*!< A context pointer passed to onDatasetExtracted() at invokation */
+};
+
+/**
+ * @brief Dataset sink invoking a C-style function pointer with the decoded dataset and a context pointer (this is the sink used by TIC::ViewDatasetExtractor)
+ *
+ * The dataset is decoded by the extractor from the prescan collected while searching its end marker, with the TIC::DatasetView flavour specialised for the TIC mode locked on the stream
+ */
+class DatasetExtractorViewCallbackSink {
+public:
+    DatasetExtractorViewCallbackSink(DatasetExtractorBase::FDatasetViewFunc onDatasetExtracted, void* onDatasetExtractedContext) :
+    onDatasetExtracted(onDatasetExtracted),
+    onDatasetExtractedContext(onDatasetExtractedContext) { }
+
+    void operator()(const DatasetView& dataset) {
+        if (this->onDatasetExtracted)
+            this->onDatasetExtracted(dataset, this->onDatasetExtractedContext);
+    }
+
+private:
+    DatasetExtractorBase::FDatasetViewFunc onDatasetExtracted; /*!< A function pointer invoked for each TIC dataset extracted */
+    void* onDatasetExtractedContext; /*!< A context pointer passed to onDatasetExtracted() at invokation */
+};
+
+/**
+ * @brief Compile-time properties of a dataset sink used by TIC::BasicDatasetExtractor
+ *
+ * By default, a sink is invoked as sink(buf, cnt). Specialize this template with WANTS_PRESCAN set to true for sinks to be invoked as sink(buf, cnt, prescan) instead,
+ * or with WANTS_VIEW set to true for sinks to be invoked as sink(dataset), dataset being the TIC::DatasetView decoded by the extractor
+ *
+ * @tparam DatasetSink The sink type
+ */
+template<typename DatasetSink>
+struct DatasetSinkTraits {
+    typedef DatasetExtractorBase::FDatasetParserFunc FParserFunc; /*!< The function pointer type accepted by the extractor's function pointer constructor */
+    static constexpr bool WANTS_PRESCAN = false; /*!< Is the sink invoked with the prescan of each dataset? */
+    static constexpr bool WANTS_VIEW = false; /*!< Is the sink invoked with the decoded dataset? */
+};
+
+template<>
+struct DatasetSinkTraits<DatasetExtractorPrescanCallbackSink> {
+    typedef DatasetExtractorBase::FDatasetPrescanParserFunc FParserFunc; /*!< The function pointer type accepted by the extractor's function pointer constructor */
+    static constexpr bool WANTS_PRESCAN = true; /*!< Is the sink invoked with the prescan of each dataset? */
+    static constexpr bool WANTS_VIEW = false; /*!< Is the sink invoked with the decoded dataset? */
+};
+
+template<>
+struct DatasetSinkTraits<DatasetExtractorViewCallbackSink> {
+    typedef DatasetExtractorBase::FDatasetViewFunc FParserFunc; /*!< The function pointer type accepted by the extractor's function pointer constructor */
+    static constexpr bool WANTS_PRESCAN = false; /*!< Is the sink invoked with the prescan of each dataset? */
+    static constexpr bool WANTS_VIEW = true; /*!< Is the sink invoked with the decoded dataset? */
+};
+
+/**
+ * @brief Invoke a dataset sink with a complete dataset (see DatasetSinkTraits)
+ *
+ * Datasets delivered to sinks getting their prescan or the decoded dataset are also accounted into the TIC mode detector of the extractor, as their type is then known at almost no cost (see DatasetView::typeFromPrescan()).
+ * Datasets delivered to raw sinks are not checked, so the extraction itself does not read them twice, their sink can account them instead (see BasicDatasetExtractor::accountDataset())
+ */
+template<bool WantsPrescan, bool WantsView>
+struct DatasetSinkInvoker {
+    template<typename DatasetSink>
+    static void invoke(DatasetSink& sink, TicModeDetector&, const uint8_t* buf, unsigned int cnt, const DatasetPrescan&) {
+        sink(buf, cnt);
+    }
+};
+
+template<>
+struct DatasetSinkInvoker<true, false> {
+    template<typename DatasetSink>
+    static void invoke(DatasetSink& sink, TicModeDetector& modeDetector, const uint8_t* buf, unsigned int cnt, const DatasetPrescan& prescan) {
+        modeDetector.account(DatasetView::typeFromPrescan(buf, cnt, prescan));
+        sink(buf, cnt, prescan);
+    }
+};
+
+template<>
+struct DatasetSinkInvoker<false, true> {
+    template<typename DatasetSink>
+    static void invoke(DatasetSink& sink, TicModeDetector& modeDetector, const uint8_t* buf, unsigned int cnt, const DatasetPrescan& prescan) {
+        /* Decode with the code path specialised for the locked TIC mode (the result is the same as with the generic path) */
+        TicMode mode = modeDetector.getMode();
+        DatasetView dataset = (mode == TicMode::Historical) ? DatasetView(buf, cnt, prescan, HistoricalTicFormat()) :
+                              (mode == TicMode::Standard) ? DatasetView(buf, cnt, prescan, StandardTicFormat()) :
+                              DatasetView(buf, cnt, prescan);
+        modeDetector.account(dataset.decodedType);
+        sink(dataset);
+    }
+};
+
+static constexpr unsigned int DATASET_EXTRACTOR_DEFAULT_MAX_DATASET_SIZE = 128; /*!< Max dataset size used by TIC::DatasetExtractor */
+
+/**
+ * @brief Overflow policy delivering the first bytes of a dataset that does not fit in the extractor's buffer (truncated), and dropping the others
+ */
+struct DatasetExtractorTruncateAndDeliver {
+    static constexpr bool DELIVER_TRUNCATED = true; /*!< Are overflowed datasets delivered (truncated)? */
+    static constexpr bool RESYNC_AT_NEXT_START_MARKER = false; /*!< Are bytes skipped up to the next start marker as soon as the dataset overflows? */
+};
+
+/**
+ * @brief Overflow policy discarding a dataset that does not fit in the extractor's buffer when its end marker is received, without delivering it
+ */
+struct DatasetExtractorDropAndCount {
+    static constexpr bool DELIVER_TRUNCATED = false; /*!< Are overflowed datasets delivered (truncated)? */
+    static constexpr bool RESYNC_AT_NEXT_START_MARKER = false; /*!< Are bytes skipped up to the next start marker as soon as the dataset overflows? */
+};
+
+/**
+ * @brief Overflow policy discarding a dataset as soon as it does not fit in the extractor's buffer, and skipping bytes up to the next start marker
+ *
+ * As an overflow is usually caused by a lost end marker, this resynchronizes on the next dataset, even in standard TIC where only CR ends a dataset
+ */
+struct DatasetExtractorDropUntilNextStartMarker {
+    static constexpr bool DELIVER_TRUNCATED = false; /*!< Are overflowed datasets delivered (truncated)? */
+    static constexpr bool RESYNC_AT_NEXT_START_MARKER = true; /*!< Are bytes skipped up to the next start marker as soon as the dataset overflows? */
+};
+
 /**
  * @brief Class to process a continuous stream of bytes and extract TIC datasets out of this stream
  * 
  * Incoming TiC bytes should be input via the pushBytes() method
  * When a TIC dataset payload is correctly parsed, it will be sent to the onDatasetExtracted() function provided as argument to the constructor.
  * That function will be invoked with 3 arguments matching with the prototype FDatasetParserFunc
- * * The first argument is a buffer containing the dataset payload (start and end markers are excluded)
+ * * The first argument is a buffer containing the dataset payload (start and end markers are excluded). When the whole dataset was inside a single buffer provided to pushBytes(), this points directly into that buffer (no copy is made), otherwise it points to our internal buffer. In both cases, it is only valid during the callback
  * * The second argument is the number of valid payload bytes in the above buffer
  * * The third argument is a generic context pointer, identical to the onDatasetExtractedContext provided as argument to the constructor. It can be used to provide context to onDatasetExtracted() that, in turn, for example, can read data structures from this context pointer.
  * 
+ * Datasets are stored in a buffer of @p MaxDatasetSize bytes inside each instance (only used for datasets that span several pushBytes() calls). When a dataset does not fit in that buffer, @p OverflowPolicy selects what happens:
+ * 1. With DatasetExtractorTruncateAndDeliver, its first @p MaxDatasetSize bytes are delivered (they will most likely fail the checksum verification in TIC::DatasetView)
+ * 2. With DatasetExtractorDropAndCount, it is discarded when its end marker is received
+ * 3. With DatasetExtractorDropUntilNextStartMarker, it is discarded as soon as it overflows, and bytes are skipped up to the next start marker
+ * In all cases, the overflow is accounted in the error counters (see getErrorCounters()).
+ * 
+ * TIC::DatasetExtractor is an alias to this template using DatasetExtractorTruncateAndDeliver, a max dataset size of DATASET_EXTRACTOR_DEFAULT_MAX_DATASET_SIZE bytes, and a DatasetExtractorCallbackSink, that invokes a C-style function pointer (as described above)
+ * Any other callable type can be used as @p DatasetSink, and will be stored by value inside the extractor. It is invoked as sink(buf, cnt) for each dataset.
+ * As the sink type is known at compile time, the compiler can inline it inside the extraction loop.
+ * Sinks for which DatasetSinkTraits::WANTS_PRESCAN is true (as DatasetExtractorPrescanCallbackSink, used by TIC::PrescanDatasetExtractor) are invoked as sink(buf, cnt, prescan) instead.
+ * The DatasetPrescan (byte sum and first delimiter positions) is then collected in the same pass as the search for the dataset end marker, so that a TIC::DatasetView built from it does not read the dataset again.
+ * Sinks for which DatasetSinkTraits::WANTS_VIEW is true (as DatasetExtractorViewCallbackSink, used by TIC::ViewDatasetExtractor) are invoked as sink(dataset), with the dataset decoded by the extractor from its prescan, using the TIC::DatasetView flavour specialised for the locked TIC mode.
+ * 
  * Sample code to count al TIC datasets from a TIC byte stream:
 
 void onDatasetExtracted(const uint8_t* buf, unsigned int cnt, void* context) {
@@ -35,37 +231,71 @@ uint8_t inputBytes[]={TIC::Unframer::STX, TIC::DatasetExtractor::START_MARKER, 0
 unframer.pushBytes(inputBytes, sizeof(inputBytes));
 	
 printf("%u\n", datasetCount); // Two TIC datasets have been parsed inside one signal frame, this line will thus print datasetCount that equals 2
+ * 
+ * Sample code to do the same with compile-time sinks (see also UnframerDatasetExtractorSink in Unframer.h):
+
+struct DatasetCounter {
+  unsigned int* datasetCount;
+  void operator()(const uint8_t* buf, unsigned int cnt) { (*datasetCount)++; }
+};
+
+typedef TIC::BasicDatasetExtractor<TIC::DatasetExtractorTruncateAndDeliver, TIC::DATASET_EXTRACTOR_DEFAULT_MAX_DATASET_SIZE, DatasetCounter> CountingDatasetExtractor;
+typedef TIC::UnframerDatasetExtractorSink<CountingDatasetExtractor> CountingFrameSink;
+
+unsigned int datasetCount = 0;
+CountingDatasetExtractor datasetExtractor(DatasetCounter{&datasetCount});
+TIC::BasicUnframer<TIC::UnframerForwardOnTheFly, TIC::UNFRAMER_DEFAULT_MAX_FRAME_SIZE, CountingFrameSink> unframer(CountingFrameSink(datasetExtractor));
+unframer.pushBytes(inputBytes, sizeof(inputBytes)); // The whole Unframer->DatasetExtractor->DatasetCounter chain can be inlined
  * 
  * @note This class is able to parse historical and standard TIC datasets
+ *       The TIC mode of the stream is tracked by a TIC::TicModeDetector. With sinks getting the prescan or the decoded dataset, it is fed by the extractor with the type of each dataset delivered (computed from the prescan).
+ *       With raw sinks, the extractor does not check the datasets it delivers, and the mode stays unknown unless the sink, that usually decodes them anyway, feeds it with accountDataset().
+ *       Once standard TIC is locked, a LF only ends a dataset if the bytes received before it form a valid standard dataset (its CR has been lost), otherwise it is a spurious LF, kept as data (so that it cannot end a dataset early).
+ *       The same rule is applied by TIC::StreamDecoder, so that both decoders split a stream into the same datasets
+ *
+ * @note On noisy lines, dataset markers can be lost or spurious ones can be received. As a LF always starts a dataset and a CR always ends one, the extractor resynchronizes within one dataset:
+ *       * A dataset ended by a LF is delivered, and if that LF is not followed by another LF, the CR of the dataset is missing (or the LF is spurious): that LF starts the next dataset (instead of having the next dataset skipped). An empty dataset ended by a LF (duplicated LF) is not delivered.
+ *         In standard TIC, this only applies to a LF that completes a valid dataset, so a lost CR only loses that CR
+ *       * A CR received while waiting for the LF that follows a dataset means that the start marker of a dataset has been lost: the bytes of that dataset are skipped (and accounted as lost)
+ *       Each of these events is accounted as DecodeError::DatasetResync in the error counters (see getErrorCounters())
+ * 
+ * @note A TIC::DatasetLabelFilter can be attached with setLabelFilter(), so that only datasets whose label is in its allowlist are delivered. The label is matched on the first bytes after the start marker,
+ *       and other datasets are skipped up to the next start marker, without being copied, searched for their end marker or delivered.
+ *       Accepted and filtered datasets are counted by the extractor (see getLabelFilterCounters()), so one filter can be shared by several extractors, even running in different threads
  * 
  * @warning At the beginning of each TIC frame that contains the byte stream fed into this class, the reset() method should be invoked to discard any previously stored incoming bytes and start from scratch
+ *
+ * @tparam OverflowPolicy The behaviour when a dataset does not fit in our internal buffer (DatasetExtractorTruncateAndDeliver, DatasetExtractorDropAndCount or DatasetExtractorDropUntilNextStartMarker)
+ * @tparam MaxDatasetSize Max acceptable TIC dataset size (excluding start and end markers)
+ * @tparam DatasetSink The callable type invoked for each dataset extracted
  */
 
-class DatasetExtractor {
+template<typename OverflowPolicy, unsigned int MaxDatasetSize, typename DatasetSink = DatasetExtractorCallbackSink>
+class BasicDatasetExtractor : public DatasetExtractorBase {
 public:
-/* Types */
-    typedef void(*FDatasetParserFunc)(const uint8_t* buf, unsigned int cnt, void* context); /*!< The prototype of callbacks invoked onDatasetExtracted */
-    
 /* Constants */
-    static constexpr uint8_t LF = 0x0a;
-    static constexpr uint8_t CR = 0x0d;
-    static constexpr uint8_t START_MARKER = LF; /*!< Dataset start marker (line feed) */
-    static constexpr uint8_t END_MARKER_TIC_1 = CR; /*!< 1st possible dataset end marker for TIC (carriage return) */
-    static constexpr uint8_t END_MARKER_TIC_2 = LF; /*!< 2nd possible dataset end marker for TIC (line feed) */
-    static constexpr unsigned int MAX_DATASET_SIZE = 128; /*!< Max size for a dataset storage (in bytes) */
+    static constexpr unsigned int MAX_DATASET_SIZE = MaxDatasetSize; /*!< Max acceptable TIC dataset size (excluding start and end markers) */
+    static constexpr bool COLLECT_PRESCAN = DatasetSinkTraits<DatasetSink>::WANTS_PRESCAN || DatasetSinkTraits<DatasetSink>::WANTS_VIEW; /*!< Is the prescan of each dataset collected while searching its end marker? (only if the sink wants it, or the decoded dataset) */
 
 /* Methods */
     /**
-     * @brief Construct a new TIC::DatasetExtractor object
+     * @brief Construct a new TIC::BasicDatasetExtractor object invoking a function pointer (only available with DatasetExtractorCallbackSink and DatasetExtractorPrescanCallbackSink)
      * 
-     * @param onDatasetExtracted A FFrameParserFunc function to invoke for each valid TIC dataset extracted
+     * @param onDatasetExtracted A FDatasetParserFunc (or FDatasetPrescanParserFunc with DatasetExtractorPrescanCallbackSink) function to invoke for each valid TIC dataset extracted
      * @param onDatasetExtractedContext A user-defined pointer that will be passed as last argument when invoking onDatasetExtracted()
      * 
      * @note We are using C-style function pointers here (with data-encapsulation via a context pointer)
      *       This is because we don't have 100% guarantee that exceptions are allowed (especially on embedded targets) and using std::function requires enabling exceptions.
      *       We can still use non-capturing lambdas as function pointer if needed (see https://stackoverflow.com/questions/28746744/passing-capturing-lambda-as-function-pointer)
      */
-    DatasetExtractor(FDatasetParserFunc onDatasetExtracted = nullptr, void* onDatasetExtractedContext = nullptr);
+    BasicDatasetExtractor(typename DatasetSinkTraits<DatasetSink>::FParserFunc onDatasetExtracted = nullptr, void* onDatasetExtractedContext = nullptr);
+
+    /**
+     * @brief Construct a new TIC::BasicDatasetExtractor object invoking a compile-time sink
+     * 
+     * @param onDatasetExtracted The callable to invoke for each TIC dataset extracted (it is copied into the extractor)
+     */
+    explicit BasicDatasetExtractor(const DatasetSink& onDatasetExtracted);
 
     /**
      * @brief Reset the label parser state
@@ -75,6 +305,7 @@ public:
      *       Historical TIC frames pose a problem here because at the very beginning of a frame, we get an leading end of dataset marker, and at the very end, a trailing start of dataset marker
      *       so concatenating these two extra dataset markers across a frame boundary will led to a concatenated empty dataset (containing only 2 bytes: start, then end markers).
      *       By resetting, we get rid of the trailing byte (frame being over, it is wiped away)
+     * @note The locked TIC mode is kept (see getMode())
      */
     void reset();
 
@@ -87,6 +318,29 @@ public:
      */
     unsigned int pushBytes(const uint8_t* buffer, unsigned int len);
 
+    /**
+     * @brief Take one new incoming byte into account
+     *
+     * This gives the same result as pushBytes(&byte, 1), but is much cheaper when bytes are received one at a time (for example from a UART receive interrupt):
+     * there is no marker search, the byte is directly appended to the internal dataset buffer, and the sink is only invoked when a dataset is complete
+     *
+     * @param byte The new input TIC byte
+     * @return The number of bytes used (0 if the byte could not be processed due to a full buffer. This is an error case)
+     */
+    unsigned int pushByte(uint8_t byte);
+
+    /**
+     * @brief Take new incoming bytes, split into several discontiguous segments, into account
+     *
+     * The segments are processed in order, as one logical stream (this gives the same result as calling pushBytes() on each segment). This avoids copying a wrapped ring buffer (or DMA buffer) into a linear buffer first.
+     * Only a dataset that straddles a segment boundary is copied into the internal buffer, datasets entirely inside one segment are delivered in place
+     *
+     * @param segments The segments of new input TIC bytes
+     * @param segmentCount The number of segments in @p segments
+     * @return The number of bytes used from all segments (if it is < the total length of the segments, some bytes could not be processed due to a full buffer. This is an error case)
+     */
+    unsigned int pushBytesv(const ByteSegment* segments, unsigned int segmentCount);
+
     /**
      * @brief Are we synchronized with a TIC dataset
      * 
@@ -94,6 +348,79 @@ public:
      */
     bool isInSync() const;
 
+    /**
+     * @brief Get the TIC mode locked on this stream
+     *
+     * @return The locked mode, or TicMode::Unknown while it is being detected (see TIC::TicModeDetector)
+     */
+    TicMode getMode() const;
+
+    /**
+     * @brief Take the type of a dataset decoded by the sink into account for the TIC mode detection
+     *
+     * Datasets delivered to raw sinks (as with TIC::DatasetExtractor) are not checked by the extractor. A sink that decodes them can feed the result back from its callback, so that the mode is tracked as with the other sinks:
+
+void onDatasetExtracted(const uint8_t* buf, unsigned int cnt, void* context) {
+  TIC::DatasetExtractor* datasetExtractor = static_cast<TIC::DatasetExtractor*>(context);
+  TIC::DatasetView dv(buf, cnt);
+  datasetExtractor->accountDataset(dv.decodedType);
+  ...
+}
+     *
+     * @param decodedType The type of the dataset just delivered (see DatasetView::decodedType)
+     * @return true if the locked mode has changed (getMode() returns the new mode)
+     * @note Datasets delivered to sinks getting their prescan or the decoded dataset are already accounted by the extractor, they must not be accounted again
+     */
+    bool accountDataset(DatasetView::DatasetType decodedType);
+
+    /**
+     * @brief Lock the TIC mode of this stream, instead of waiting for it to be detected
+     *
+     * @param mode The TIC mode (TicMode::Unknown to detect it again)
+     * @note As a detected mode, a forced mode is unlocked after TicModeDetector::REDETECT_AFTER_FAILURES consecutive datasets that are not valid datasets of this mode
+     */
+    void setMode(TicMode mode);
+
+    /**
+     * @brief Only deliver datasets whose label is in an allowlist
+     *
+     * @param labelFilter The allowlist (that must remain valid while attached, and is never modified by the extractor), or nullptr to deliver all datasets
+     * @note The filter should be attached or detached between frames (after reset())
+     */
+    void setLabelFilter(const DatasetLabelFilter* labelFilter);
+
+    /**
+     * @brief Get the counters of datasets accepted and filtered out by the label filter
+     *
+     * @return The counters updated by this extractor since construction (or since the last call to resetLabelFilterCounters())
+     */
+    const DatasetLabelFilterCounters& getLabelFilterCounters() const;
+
+    /**
+     * @brief Reset all label filter counters to 0
+     */
+    void resetLabelFilterCounters();
+
+    /**
+     * @brief Set the function to invoke for each error detected (dataset overflow, empty dataset, resynchronization on dataset markers)
+     *
+     * @param onError A FOnDecodeErrorFunc function to invoke for each error, or nullptr to only update error counters
+     * @param onErrorContext A user-defined pointer that will be passed as last argument when invoking onError()
+     */
+    void setErrorCallback(FOnDecodeErrorFunc onError, void* onErrorContext = nullptr);
+
+    /**
+     * @brief Get the error counters
+     *
+     * @return The counters of errors detected since construction (or since the last call to resetErrorCounters())
+     */
+    const DecodeErrorCounters& getErrorCounters() const;
+
+    /**
+     * @brief Reset all error counters to 0
+     */
+    void resetErrorCounters();
+
 private:
     /**
      * @brief Get the remaining free size in our internal buffer currentDataset
@@ -102,6 +429,21 @@ private:
      */
     unsigned int getFreeBytes() const;
 
+    /**
+     * @brief Do the bytes of the current dataset received so far form a valid standard TIC dataset?
+     *
+     * Once standard TIC is locked, a LF only ends a dataset in that case (its CR has been lost), see pushByte()
+     */
+    bool isCurrentDatasetValidStandard() const;
+
+    /**
+     * @brief Take one new byte into account while out of sync (see pushByte())
+     *
+     * @param byte The new input TIC byte
+     * @return The number of bytes used (always 1)
+     */
+    unsigned int pushOutOfSyncByte(uint8_t byte);
+
     /**
      * @brief Take new dataset bytes into account
      * 
@@ -120,11 +462,507 @@ private:
      */
     void processCurrentDataset();
 
+    /**
+     * @brief Process a whole dataset (from start to end markers) that was received within a single input buffer, without copying it into our internal buffer
+     *
+     * @param buffer The buffer to the dataset bytes (start and end markers excluded)
+     * @param len The number of bytes in the dataset
+     * @return The number of bytes used from buffer (if it is <len, the dataset did not fit in MAX_DATASET_SIZE and has been truncated. This is an error case)
+     */
+    unsigned int processContiguousDataset(const uint8_t* buffer, unsigned int len);
+
+    /**
+     * @brief Forward a complete dataset to the sink (accounting it into the TIC mode detection, if the sink gets its prescan or the decoded dataset)
+     *
+     * @param buffer The buffer to the dataset bytes (start and end markers excluded)
+     * @param len The number of bytes in the dataset
+     * @param prescan The prescan of the dataset (only meaningful if COLLECT_PRESCAN is set)
+     */
+    void deliverDataset(const uint8_t* buffer, unsigned int len, const DatasetPrescan& prescan);
+
+    /**
+     * @brief Discard the current dataset, that overflowed our internal buffer, instead of delivering it
+     */
+    void discardDataset();
+
 /* Attributes */
     bool sync;  /*!< Are we currently in sync? (correct parsing) */
-    FDatasetParserFunc onDatasetExtracted; /*!< A function pointer invoked for each valid TIC dataset extracted */
-    void* onDatasetExtractedContext; /*!< A context pointer passed to onDatasetExtracted() at invokation */
+    DatasetSink onDatasetExtracted; /*!< The sink invoked for each valid TIC dataset extracted */
     uint8_t currentDataset[MAX_DATASET_SIZE]; /*!< Our internal accumulating buffer used to store the current dataset */
     unsigned int nextWriteInCurrentDataset; /*!< The index of the next bytes to write in buffer currentDataset */
+    DatasetPrescan currentPrescan; /*!< The prescan of the current dataset, collected while searching its end marker (only if COLLECT_PRESCAN is set) */
+    bool currentDatasetOverflowed; /*!< Have bytes of the current dataset been dropped due to a full buffer? */
+    bool datasetEndedByLf; /*!< While in sync, has the previous dataset been ended by a LF that may also be the start marker of the current dataset? */
+    bool afterDatasetEnd; /*!< While out of sync, has the previous dataset been ended by a CR (so that a CR before the next LF means that a start marker has been lost)? */
+    unsigned int bytesSkippedAfterDatasetEnd; /*!< While afterDatasetEnd is set, the number of bytes skipped since the end of the previous dataset */
+    const DatasetLabelFilter* labelFilter; /*!< The allowlist of labels to deliver (or nullptr to deliver all datasets) */
+    DatasetLabelFilterCounters labelFilterCounters; /*!< Counters of datasets accepted and filtered out by labelFilter */
+    bool currentLabelAccepted; /*!< While in sync with a label filter, has the label of the current dataset been accepted already? */
+    bool skippingFilteredDataset; /*!< While out of sync, are we skipping the bytes of a dataset rejected by the label filter? */
+    TicModeDetector modeDetector; /*!< The TIC mode detection, selecting the dataset end markers */
+    DecodeErrorReporter errors; /*!< Error counters and optional error callback */
 };
-} // namespace TIC
\ No newline at end of file
+template<typename OverflowPolicy, unsigned int MaxDatasetSize, typename DatasetSink>
+BasicDatasetExtractor<OverflowPolicy, MaxDatasetSize, DatasetSink>::BasicDatasetExtractor(typename DatasetSinkTraits<DatasetSink>::FParserFunc onDatasetExtracted, void* onDatasetExtractedContext) :
+sync(false),
+onDatasetExtracted(onDatasetExtracted, onDatasetExtractedContext),
+currentDataset(),
+nextWriteInCurrentDataset(0),
+currentPrescan(),
+currentDatasetOverflowed(false),
+datasetEndedByLf(false),
+afterDatasetEnd(false),
+bytesSkippedAfterDatasetEnd(0),
+labelFilter(nullptr),
+labelFilterCounters(),
+currentLabelAccepted(false),
+skippingFilteredDataset(false),
+modeDetector(),
+errors() {
+}
+
+template<typename OverflowPolicy, unsigned int MaxDatasetSize, typename DatasetSink>
+BasicDatasetExtractor<OverflowPolicy, MaxDatasetSize, DatasetSink>::BasicDatasetExtractor(const DatasetSink& onDatasetExtracted) :
+sync(false),
+onDatasetExtracted(onDatasetExtracted),
+currentDataset(),
+nextWriteInCurrentDataset(0),
+currentPrescan(),
+currentDatasetOverflowed(false),
+datasetEndedByLf(false),
+afterDatasetEnd(false),
+bytesSkippedAfterDatasetEnd(0),
+labelFilter(nullptr),
+labelFilterCounters(),
+currentLabelAccepted(false),
+skippingFilteredDataset(false),
+modeDetector(),
+errors() {
+}
+
+template<typename OverflowPolicy, unsigned int MaxDatasetSize, typename DatasetSink>
+unsigned int BasicDatasetExtractor<OverflowPolicy, MaxDatasetSize, DatasetSink>::pushBytesv(const ByteSegment* segments, unsigned int segmentCount) {
+    unsigned int usedBytes = 0;
+    /* The dataset state is kept between pushBytes() calls, so only datasets straddling a segment boundary are stored */
+    for (unsigned int segmentIdx = 0; segmentIdx < segmentCount; segmentIdx++) {
+        usedBytes += this->pushBytes(segments[segmentIdx].buffer, segments[segmentIdx].len);
+    }
+    return usedBytes;
+}
+
+template<typename OverflowPolicy, unsigned int MaxDatasetSize, typename DatasetSink>
+unsigned int BasicDatasetExtractor<OverflowPolicy, MaxDatasetSize, DatasetSink>::pushBytes(const uint8_t* buffer, unsigned int len) {
+    /* In a TIC frame, TIC labels follow the format:
+    [LF]<dataset>[CR]
+    Where:
+    - LF is the ASCII character 0x0a (line-feed)
+    - <dataset> is the TIC dataset we want to extract
+    - [CR] is the ASCII character 0x0d (carriage return)
+
+    See https://lucidar.me/fr/home-automation/linky-customer-tele-information/
+    */
+    unsigned int usedBytes = 0;
+    bool datasetStartedInBuffer = false; /* Did the current dataset start within buffer (so that all its bytes are in buffer)? */
+    /* Each iteration consumes bytes up to the next dataset boundary (or up to the end of buffer), so the stack usage does not depend on the number of datasets inside buffer */
+    while (len > 0) {
+        if (!this->sync) {  /* We don't record bytes, we'll just look for a start of dataset */
+            const uint8_t* firstStartOfDataset;
+            if (*buffer == DatasetExtractorBase::START_MARKER) { /* Usual case: the start marker immediately follows the end marker of the previous dataset */
+                firstStartOfDataset = buffer;
+            }
+            else if (this->afterDatasetEnd) { /* A CR before the next LF means that the start marker of a dataset has been lost */
+                firstStartOfDataset = TIC::MarkerScanner::findFirstOf(buffer, len, DatasetExtractorBase::START_MARKER, DatasetExtractorBase::END_MARKER_TIC_1);
+            }
+            else {
+                firstStartOfDataset = (const uint8_t*)(memchr(buffer, DatasetExtractorBase::START_MARKER, len));
+            }
+            if (!firstStartOfDataset) {
+                /* Skip all bytes */
+                if (this->afterDatasetEnd) {
+                    this->bytesSkippedAfterDatasetEnd += len;
+                }
+                if (this->skippingFilteredDataset) {
+                    this->labelFilterCounters.filteredBytes += len;
+                }
+                usedBytes += len;
+                break;
+            }
+            unsigned int bytesToSkip = firstStartOfDataset - buffer + 1;  /* Bytes processed (but ignored), including the marker (it won't be included inside the buffered dataset) */
+            usedBytes += bytesToSkip;
+            buffer += bytesToSkip;
+            len -= bytesToSkip;
+            if (*firstStartOfDataset == DatasetExtractorBase::END_MARKER_TIC_1) { /* The bytes skipped were a dataset without its start marker, we are now right after its end marker */
+                this->errors.report(DecodeError::DatasetResync, this->bytesSkippedAfterDatasetEnd + bytesToSkip - 1);
+                this->bytesSkippedAfterDatasetEnd = 0;
+                continue;
+            }
+            if (this->skippingFilteredDataset) {
+                this->labelFilterCounters.filteredBytes += bytesToSkip - 1;
+                this->skippingFilteredDataset = false;
+            }
+            this->sync = true;
+            this->afterDatasetEnd = false;
+            this->bytesSkippedAfterDatasetEnd = 0;
+            datasetStartedInBuffer = true;
+            /* Go on parsing the trailing bytes, now that we are in sync */
+        }
+        else {
+            if (this->datasetEndedByLf) { /* The previous dataset was ended by a LF, the next byte tells if that LF was its end marker or the start marker of the current dataset */
+                this->datasetEndedByLf = false;
+                datasetStartedInBuffer = true; /* No byte of the current dataset has been stored yet */
+                if (*buffer == DatasetExtractorBase::START_MARKER && this->modeDetector.getMode() != TicMode::Standard) { /* LF end marker followed by the start marker of the current dataset (datasets terminated by LF instead of CR), unless standard TIC has been locked by the previous dataset */
+                    usedBytes++;
+                    buffer++;
+                    len--;
+                    continue;
+                }
+                this->errors.report(DecodeError::DatasetResync, 0); /* The CR of the previous dataset is missing (or the LF was spurious), that LF started the current dataset */
+            }
+            if (this->labelFilter != nullptr && !this->currentLabelAccepted && !(this->nextWriteInCurrentDataset == 0 && *buffer == DatasetExtractorBase::START_MARKER && this->modeDetector.getMode() != TicMode::Standard)) {
+                /* Match the label of the current dataset as soon as its first bytes are received (a duplicated start marker, that ends an empty dataset, is left to the end marker search below) */
+                DatasetLabelFilter::Decision decision = this->labelFilter->decide(this->currentDataset, this->nextWriteInCurrentDataset, buffer, len);
+                if (decision == DatasetLabelFilter::Decision::Reject) {
+                    /* Skip the bytes of this dataset up to the next start marker (the CR ending it is skipped as well, it cannot mean that a start marker was lost) */
+                    this->labelFilterCounters.filteredDatasets++;
+                    this->labelFilterCounters.filteredBytes += this->nextWriteInCurrentDataset;
+                    this->nextWriteInCurrentDataset = 0;
+                    this->currentDatasetOverflowed = false;
+                    this->sync = false;
+                    this->afterDatasetEnd = false;
+                    this->skippingFilteredDataset = true;
+                    datasetStartedInBuffer = false;
+                    continue;
+                }
+                if (decision == DatasetLabelFilter::Decision::Accept) {
+                    this->labelFilterCounters.acceptedDatasets++;
+                    this->currentLabelAccepted = true;
+                }
+            }
+            /* We are inside a TIC dataset, search for the end of dataset marker, in one pass over buffer */
+            /* Until standard TIC is locked, the first CR or LF ends the dataset (so the result does not depend on how bytes are chunked), a LF also starting the next dataset. In standard TIC, a LF only does if it completes a valid dataset (see below) */
+            const uint8_t* endOfDataset;
+            if (COLLECT_PRESCAN) { /* Collect the prescan of the dataset in the same pass */
+                if (this->nextWriteInCurrentDataset == 0) {
+                    this->currentPrescan.reset();
+                }
+                endOfDataset = this->currentPrescan.accountBytesUpTo(buffer, len, this->nextWriteInCurrentDataset, DatasetExtractorBase::END_MARKER_TIC_1, DatasetExtractorBase::END_MARKER_TIC_2);
+            }
+            else {
+                endOfDataset = TIC::MarkerScanner::findFirstOf(buffer, len, DatasetExtractorBase::END_MARKER_TIC_1, DatasetExtractorBase::END_MARKER_TIC_2);
+            }
+            if (OverflowPolicy::RESYNC_AT_NEXT_START_MARKER) {
+                unsigned int leadingBytesInCurrentDataset = endOfDataset ? endOfDataset - buffer : len;
+                unsigned int freeBytes = this->getFreeBytes();
+                if (leadingBytesInCurrentDataset > freeBytes) {
+                    /* The current dataset overflows: discard it, and search for the next start marker right after the last byte that fitted */
+                    this->errors.report(DecodeError::DatasetOverflow, leadingBytesInCurrentDataset - freeBytes);
+                    this->discardDataset();
+                    datasetStartedInBuffer = false;
+                    this->nextWriteInCurrentDataset = 0;
+                    this->currentLabelAccepted = false;
+                    this->sync = false;
+                    this->afterDatasetEnd = false; /* The end marker of the discarded dataset may still come */
+                    usedBytes += freeBytes;
+                    buffer += freeBytes;
+                    len -= freeBytes;
+                    continue;
+                }
+            }
+            if (!endOfDataset) { /* No end of dataset marker, copy the whole chunk */
+                usedBytes += this->processIncomingDatasetBytes(buffer, len); /* Process these bytes as valid */
+                break;
+            }
+            /* We have an end of dataset marker in the buffer, we can extract the full dataset */
+            unsigned int leadingBytesInPreviousDataset = endOfDataset - buffer;
+            bool endedByStartMarker = (*endOfDataset == DatasetExtractorBase::START_MARKER);
+            if (endedByStartMarker && this->modeDetector.getMode() == TicMode::Standard) {
+                /* In standard TIC, a LF is either the end of a dataset whose CR has been lost, or a spurious LF kept as data: store the bytes before it, and let pushByte() decide from the stored dataset (this only happens on noisy lines) */
+                usedBytes += this->processIncomingDatasetBytes(buffer, leadingBytesInPreviousDataset);
+                usedBytes += this->pushByte(*endOfDataset);
+                leadingBytesInPreviousDataset++;
+                buffer += leadingBytesInPreviousDataset;
+                len -= leadingBytesInPreviousDataset;
+                datasetStartedInBuffer = (this->nextWriteInCurrentDataset == 0); /* A new dataset may have been started by the LF */
+                continue;
+            }
+            if (endedByStartMarker && leadingBytesInPreviousDataset == 0 && this->nextWriteInCurrentDataset == 0) {
+                /* Empty dataset ended by a LF: this is a duplicated start marker, nothing to deliver (if it is not followed by another LF, a resync will be accounted) */
+            }
+            else if (datasetStartedInBuffer) { /* The whole dataset is in buffer, up to (but excluding) the end of dataset marker */
+                usedBytes += this->processContiguousDataset(buffer, leadingBytesInPreviousDataset);
+            }
+            else {
+                usedBytes += this->processIncomingDatasetBytes(buffer, leadingBytesInPreviousDataset, true);  /* Copy the buffer up to (but exclusing the end of dataset marker), the dataset is complete */
+            }
+            this->nextWriteInCurrentDataset = 0; /* Wipe any data in the current dataset, start over */
+            this->currentDatasetOverflowed = false;
+            this->currentLabelAccepted = false;
+            leadingBytesInPreviousDataset++; /* Skip the end of dataset marker */
+            usedBytes++;
+            if (endedByStartMarker) { /* This LF may also start the next dataset, stay in sync */
+                this->datasetEndedByLf = true;
+            }
+            else {
+                datasetStartedInBuffer = false;
+                this->sync = false; /* Consider we are outside of a dataset now */
+                this->afterDatasetEnd = true;
+            }
+            buffer += leadingBytesInPreviousDataset;
+            len -= leadingBytesInPreviousDataset; /* Go on with the trailing bytes (probably the next dataset) */
+        }
+    }
+    return usedBytes;
+}
+
+template<typename OverflowPolicy, unsigned int MaxDatasetSize, typename DatasetSink>
+unsigned int BasicDatasetExtractor<OverflowPolicy, MaxDatasetSize, DatasetSink>::pushByte(uint8_t byte) {
+    /* Same state machine as pushBytes(), specialized for one byte */
+    if (!this->sync) {
+        return this->pushOutOfSyncByte(byte);
+    }
+    if (this->datasetEndedByLf) { /* See pushBytes() */
+        this->datasetEndedByLf = false;
+        if (byte == DatasetExtractorBase::START_MARKER && this->modeDetector.getMode() != TicMode::Standard) {
+            return 1;
+        }
+        this->errors.report(DecodeError::DatasetResync, 0);
+    }
+    if (this->labelFilter != nullptr && !this->currentLabelAccepted && !(this->nextWriteInCurrentDataset == 0 && byte == DatasetExtractorBase::START_MARKER && this->modeDetector.getMode() != TicMode::Standard)) {
+        DatasetLabelFilter::Decision decision = this->labelFilter->decide(this->currentDataset, this->nextWriteInCurrentDataset, &byte, 1);
+        if (decision == DatasetLabelFilter::Decision::Reject) {
+            this->labelFilterCounters.filteredDatasets++;
+            this->labelFilterCounters.filteredBytes += this->nextWriteInCurrentDataset;
+            this->nextWriteInCurrentDataset = 0;
+            this->currentDatasetOverflowed = false;
+            this->sync = false;
+            this->afterDatasetEnd = false;
+            this->skippingFilteredDataset = true;
+            return this->pushOutOfSyncByte(byte);
+        }
+        if (decision == DatasetLabelFilter::Decision::Accept) {
+            this->labelFilterCounters.acceptedDatasets++;
+            this->currentLabelAccepted = true;
+        }
+    }
+    bool isEndMarker = (byte == DatasetExtractorBase::END_MARKER_TIC_1 ||
+                        (byte == DatasetExtractorBase::END_MARKER_TIC_2 && (this->modeDetector.getMode() != TicMode::Standard || this->isCurrentDatasetValidStandard()))); /* In standard TIC, a spurious LF is kept as data */
+    if (!isEndMarker) {
+        if (this->nextWriteInCurrentDataset >= MAX_DATASET_SIZE) { /* currentDataset overflow */
+            this->errors.report(DecodeError::DatasetOverflow, 1, !this->currentDatasetOverflowed);
+            if (OverflowPolicy::RESYNC_AT_NEXT_START_MARKER) {
+                this->discardDataset();
+                this->nextWriteInCurrentDataset = 0;
+                this->currentLabelAccepted = false;
+                this->sync = false;
+                this->afterDatasetEnd = false;
+                return this->pushOutOfSyncByte(byte);
+            }
+            this->currentDatasetOverflowed = true;
+            return 0;
+        }
+        if (COLLECT_PRESCAN) {
+            if (this->nextWriteInCurrentDataset == 0) {
+                this->currentPrescan.reset();
+            }
+            this->currentPrescan.accountByte(byte, this->nextWriteInCurrentDataset);
+        }
+        this->currentDataset[this->nextWriteInCurrentDataset++] = byte;
+        return 1;
+    }
+    /* End of the current dataset */
+    bool endedByStartMarker = (byte == DatasetExtractorBase::START_MARKER);
+    if (!(endedByStartMarker && this->nextWriteInCurrentDataset == 0)) { /* An empty dataset ended by a LF is a duplicated start marker, nothing to deliver */
+        if (COLLECT_PRESCAN && this->nextWriteInCurrentDataset == 0) {
+            this->currentPrescan.reset();
+        }
+        this->processCurrentDataset();
+    }
+    this->nextWriteInCurrentDataset = 0;
+    this->currentDatasetOverflowed = false;
+    this->currentLabelAccepted = false;
+    if (endedByStartMarker) {
+        this->datasetEndedByLf = true;
+    }
+    else {
+        this->sync = false;
+        this->afterDatasetEnd = true;
+    }
+    return 1;
+}
+
+template<typename OverflowPolicy, unsigned int MaxDatasetSize, typename DatasetSink>
+bool BasicDatasetExtractor<OverflowPolicy, MaxDatasetSize, DatasetSink>::isCurrentDatasetValidStandard() const {
+    /* The prescan, if collected, also accounts the bytes that have been dropped, only use it if there are none */
+    DatasetView::DatasetType type = (COLLECT_PRESCAN && !this->currentDatasetOverflowed) ?
+                                    DatasetView::typeFromPrescan(this->currentDataset, this->nextWriteInCurrentDataset, this->currentPrescan) :
+                                    DatasetView::typeOf(this->currentDataset, this->nextWriteInCurrentDataset);
+    return type == DatasetView::DatasetType::ValidStandard;
+}
+
+template<typename OverflowPolicy, unsigned int MaxDatasetSize, typename DatasetSink>
+unsigned int BasicDatasetExtractor<OverflowPolicy, MaxDatasetSize, DatasetSink>::pushOutOfSyncByte(uint8_t byte) {
+    if (byte == DatasetExtractorBase::START_MARKER) {
+        this->skippingFilteredDataset = false;
+        this->sync = true;
+        this->afterDatasetEnd = false;
+        this->bytesSkippedAfterDatasetEnd = 0;
+        return 1;
+    }
+    if (this->skippingFilteredDataset) {
+        this->labelFilterCounters.filteredBytes++;
+    }
+    if (this->afterDatasetEnd) {
+        if (byte == DatasetExtractorBase::END_MARKER_TIC_1) { /* A CR before the next LF means that the start marker of a dataset has been lost */
+            this->errors.report(DecodeError::DatasetResync, this->bytesSkippedAfterDatasetEnd);
+            this->bytesSkippedAfterDatasetEnd = 0;
+        }
+        else {
+            this->bytesSkippedAfterDatasetEnd++;
+        }
+    }
+    return 1;
+}
+
+template<typename OverflowPolicy, unsigned int MaxDatasetSize, typename DatasetSink>
+unsigned int BasicDatasetExtractor<OverflowPolicy, MaxDatasetSize, DatasetSink>::processIncomingDatasetBytes(const uint8_t* buffer, unsigned int len, bool datasetComplete) {
+    unsigned int maxCopy = this->getFreeBytes();
+    unsigned int szCopy = len;
+    if (szCopy > maxCopy) {  /* currentDataset overflow, trailing bytes are dropped */
+        szCopy = maxCopy;
+        this->errors.report(DecodeError::DatasetOverflow, len - szCopy, !this->currentDatasetOverflowed);
+        this->currentDatasetOverflowed = true;
+    }
+    memcpy(this->currentDataset + this->nextWriteInCurrentDataset, buffer, szCopy);
+    this->nextWriteInCurrentDataset += szCopy;
+
+    if (datasetComplete) {
+        this->processCurrentDataset();
+    }
+    return szCopy;
+}
+
+template<typename OverflowPolicy, unsigned int MaxDatasetSize, typename DatasetSink>
+void BasicDatasetExtractor<OverflowPolicy, MaxDatasetSize, DatasetSink>::processCurrentDataset() {
+    if (!OverflowPolicy::DELIVER_TRUNCATED && this->currentDatasetOverflowed) {
+        this->discardDataset();
+        return;
+    }
+    if (COLLECT_PRESCAN && this->currentDatasetOverflowed) { /* The prescan also accounted the bytes that have been dropped */
+        this->currentPrescan = DatasetPrescan::fromBuffer(this->currentDataset, this->nextWriteInCurrentDataset);
+    }
+    this->deliverDataset(this->currentDataset, this->nextWriteInCurrentDataset, this->currentPrescan);
+}
+
+template<typename OverflowPolicy, unsigned int MaxDatasetSize, typename DatasetSink>
+unsigned int BasicDatasetExtractor<OverflowPolicy, MaxDatasetSize, DatasetSink>::processContiguousDataset(const uint8_t* buffer, unsigned int len) {
+    unsigned int szDeliver = len;
+    if (szDeliver > MAX_DATASET_SIZE) {  /* Same truncation as when the dataset is copied into currentDataset */
+        szDeliver = MAX_DATASET_SIZE;
+        this->errors.report(DecodeError::DatasetOverflow, len - szDeliver);
+        if (!OverflowPolicy::DELIVER_TRUNCATED) {
+            this->discardDataset();
+            return szDeliver;
+        }
+    }
+    if (COLLECT_PRESCAN && szDeliver < len) { /* The prescan also accounted the bytes that have been truncated */
+        this->currentPrescan = DatasetPrescan::fromBuffer(buffer, szDeliver);
+    }
+    this->deliverDataset(buffer, szDeliver, this->currentPrescan);
+    return szDeliver;
+}
+
+template<typename OverflowPolicy, unsigned int MaxDatasetSize, typename DatasetSink>
+void BasicDatasetExtractor<OverflowPolicy, MaxDatasetSize, DatasetSink>::deliverDataset(const uint8_t* buffer, unsigned int len, const DatasetPrescan& prescan) {
+    //std::vector<uint8_t> datasetContent(buffer, buffer+len);
+    //std::cout << "New dataset extracted: " << vectorToHexString(datasetContent) << " (as string: \"" << std::string(datasetContent.begin(), datasetContent.end()) << "\")\n";
+    if (len == 0) {
+        this->errors.report(DecodeError::EmptyDataset, 1);
+    }
+    DatasetSinkInvoker<DatasetSinkTraits<DatasetSink>::WANTS_PRESCAN, DatasetSinkTraits<DatasetSink>::WANTS_VIEW>::invoke(this->onDatasetExtracted, this->modeDetector, buffer, len, prescan);
+}
+
+template<typename OverflowPolicy, unsigned int MaxDatasetSize, typename DatasetSink>
+void BasicDatasetExtractor<OverflowPolicy, MaxDatasetSize, DatasetSink>::discardDataset() {
+    this->errors.report(DecodeError::DatasetDiscarded, MAX_DATASET_SIZE); /* The bytes that fitted are lost as well */
+}
+
+template<typename OverflowPolicy, unsigned int MaxDatasetSize, typename DatasetSink>
+bool BasicDatasetExtractor<OverflowPolicy, MaxDatasetSize, DatasetSink>::isInSync() const {
+    return this->sync;
+}
+
+template<typename OverflowPolicy, unsigned int MaxDatasetSize, typename DatasetSink>
+typename BasicDatasetExtractor<OverflowPolicy, MaxDatasetSize, DatasetSink>::TicMode BasicDatasetExtractor<OverflowPolicy, MaxDatasetSize, DatasetSink>::getMode() const {
+    return this->modeDetector.getMode();
+}
+
+template<typename OverflowPolicy, unsigned int MaxDatasetSize, typename DatasetSink>
+bool BasicDatasetExtractor<OverflowPolicy, MaxDatasetSize, DatasetSink>::accountDataset(DatasetView::DatasetType decodedType) {
+    return this->modeDetector.account(decodedType);
+}
+
+template<typename OverflowPolicy, unsigned int MaxDatasetSize, typename DatasetSink>
+void BasicDatasetExtractor<OverflowPolicy, MaxDatasetSize, DatasetSink>::setMode(TicMode mode) {
+    this->modeDetector.setMode(mode);
+}
+
+template<typename OverflowPolicy, unsigned int MaxDatasetSize, typename DatasetSink>
+unsigned int BasicDatasetExtractor<OverflowPolicy, MaxDatasetSize, DatasetSink>::getFreeBytes() const {
+    return MAX_DATASET_SIZE - this->nextWriteInCurrentDataset;
+}
+
+template<typename OverflowPolicy, unsigned int MaxDatasetSize, typename DatasetSink>
+void BasicDatasetExtractor<OverflowPolicy, MaxDatasetSize, DatasetSink>::reset() {
+    this->sync = false;
+    this->nextWriteInCurrentDataset = 0; /* No need to wipe currentDataset, bytes beyond nextWriteInCurrentDataset are never read */
+    this->currentDatasetOverflowed = false;
+    this->datasetEndedByLf = false;
+    this->afterDatasetEnd = false;
+    this->bytesSkippedAfterDatasetEnd = 0;
+    this->currentLabelAccepted = false;
+    this->skippingFilteredDataset = false;
+}
+
+template<typename OverflowPolicy, unsigned int MaxDatasetSize, typename DatasetSink>
+void BasicDatasetExtractor<OverflowPolicy, MaxDatasetSize, DatasetSink>::setLabelFilter(const DatasetLabelFilter* labelFilter) {
+    this->labelFilter = labelFilter;
+    this->currentLabelAccepted = false;
+    this->skippingFilteredDataset = false;
+}
+
+template<typename OverflowPolicy, unsigned int MaxDatasetSize, typename DatasetSink>
+const DatasetLabelFilterCounters& BasicDatasetExtractor<OverflowPolicy, MaxDatasetSize, DatasetSink>::getLabelFilterCounters() const {
+    return this->labelFilterCounters;
+}
+
+template<typename OverflowPolicy, unsigned int MaxDatasetSize, typename DatasetSink>
+void BasicDatasetExtractor<OverflowPolicy, MaxDatasetSize, DatasetSink>::resetLabelFilterCounters() {
+    this->labelFilterCounters = DatasetLabelFilterCounters();
+}
+
+template<typename OverflowPolicy, unsigned int MaxDatasetSize, typename DatasetSink>
+void BasicDatasetExtractor<OverflowPolicy, MaxDatasetSize, DatasetSink>::setErrorCallback(FOnDecodeErrorFunc onError, void* onErrorContext) {
+    this->errors.setCallback(onError, onErrorContext);
+}
+
+template<typename OverflowPolicy, unsigned int MaxDatasetSize, typename DatasetSink>
+const DecodeErrorCounters& BasicDatasetExtractor<OverflowPolicy, MaxDatasetSize, DatasetSink>::getErrorCounters() const {
+    return this->errors.getCounters();
+}
+
+template<typename OverflowPolicy, unsigned int MaxDatasetSize, typename DatasetSink>
+void BasicDatasetExtractor<OverflowPolicy, MaxDatasetSize, DatasetSink>::resetErrorCounters() {
+    this->errors.resetCounters();
+}
+
+typedef BasicDatasetExtractor<DatasetExtractorTruncateAndDeliver, DATASET_EXTRACTOR_DEFAULT_MAX_DATASET_SIZE> DatasetExtractor; /*!< The dataset extractor with default settings, invoking a C-style function pointer */
+
+typedef BasicDatasetExtractor<DatasetExtractorTruncateAndDeliver, DATASET_EXTRACTOR_DEFAULT_MAX_DATASET_SIZE, DatasetExtractorPrescanCallbackSink> PrescanDatasetExtractor; /*!< The dataset extractor with default settings, invoking a C-style function pointer with the prescan of each dataset */
+
+typedef BasicDatasetExtractor<DatasetExtractorTruncateAndDeliver, DATASET_EXTRACTOR_DEFAULT_MAX_DATASET_SIZE, DatasetExtractorViewCallbackSink> ViewDatasetExtractor; /*!< The dataset extractor with default settings, invoking a C-style function pointer with each dataset decoded */
+
+/* The default flavours are instanciated once in DatasetExtractor.cpp */
+extern template class BasicDatasetExtractor<DatasetExtractorTruncateAndDeliver, DATASET_EXTRACTOR_DEFAULT_MAX_DATASET_SIZE>;
+extern template class BasicDatasetExtractor<DatasetExtractorTruncateAndDeliver, DATASET_EXTRACTOR_DEFAULT_MAX_DATASET_SIZE, DatasetExtractorPrescanCallbackSink>;
+extern template class BasicDatasetExtractor<DatasetExtractorTruncateAndDeliver, DATASET_EXTRACTOR_DEFAULT_MAX_DATASET_SIZE, DatasetExtractorViewCallbackSink>;
+} // namespace TIC
@@ -0,0 +1,144 @@
+/**
+ * @file DatasetLabelFilter.h
+ * @brief Allowlist of TIC labels, used to skip unwanted datasets early in a decoder
+ */
+#pragma once
+#include <stdint.h>
+
+namespace TIC {
+/**
+ * @brief Counters of the datasets accepted and filtered out by a TIC::DatasetLabelFilter, kept by each extractor using the filter (see TIC::BasicDatasetExtractor::getLabelFilterCounters())
+ */
+struct DatasetLabelFilterCounters {
+    uint32_t acceptedDatasets; /*!< Number of datasets whose label is in the allowlist */
+    uint32_t filteredDatasets; /*!< Number of datasets skipped because their label is not in the allowlist */
+    uint32_t filteredBytes; /*!< Number of bytes skipped inside filtered datasets (including their end marker) */
+};
+
+/**
+ * @brief Allowlist of TIC labels, matched on the first bytes of each dataset (the label, followed by a HT or SP delimiter)
+ *
+ * When a filter is attached to a TIC::BasicDatasetExtractor (see setLabelFilter()), the extractor checks the label of each dataset as soon as it is received,
+ * and datasets whose label is not in the allowlist are skipped up to the next dataset start marker: they are not copied, not searched for their end marker and not delivered.
+ * This makes decoding much cheaper for consumers that only need a few labels out of each frame.
+ *
+ * Labels are stored as pointers, so the strings provided to addLabel() must remain valid while the filter is in use (string literals are usually used).
+ * A filter is never modified by extractors (each extractor keeps its own counters, see TIC::BasicDatasetExtractor::getLabelFilterCounters()).
+ * Once its labels have been added, a filter can thus be shared by several extractors, including extractors running in different threads.
+ *
+ * Sample code to only get the energy and apparent power datasets from a standard TIC stream:
+
+TIC::DatasetLabelFilter filter;
+filter.addLabel("EAST");
+filter.addLabel("SINSTS");
+TIC::DatasetExtractor datasetExtractor(onDatasetExtracted, &context);
+datasetExtractor.setLabelFilter(&filter);
+ */
+class DatasetLabelFilter {
+public:
+/* Types */
+    /**
+     * @brief The result of matching the first bytes of a dataset against the allowlist
+     */
+    enum class Decision : uint8_t {
+        Accept, /*!< The dataset label is in the allowlist */
+        Reject, /*!< The dataset label is not in the allowlist */
+        Undecided, /*!< More bytes of the dataset are needed to decide */
+    };
+
+/* Constants */
+    static constexpr unsigned int MAX_LABELS = 16; /*!< Max number of labels in the allowlist */
+    static constexpr unsigned int MAX_LABEL_SIZE = 16; /*!< Max size of each label in the allowlist (in bytes) */
+    static constexpr uint8_t HT = 0x09; /*!< Horizontal tab, the delimiter after the label in standard TIC datasets */
+    static constexpr uint8_t SP = 0x20; /*!< Space, the delimiter after the label in historical TIC datasets */
+
+/* Methods */
+    DatasetLabelFilter() :
+    labels(),
+    labelSizes(),
+    labelCount(0) { }
+
+    /**
+     * @brief Add a label to the allowlist
+     *
+     * @param label The label, as a NUL-terminated string (that must remain valid while the filter is in use)
+     * @return false if the label could not be added (allowlist full, empty or too long label, or label containing control characters or delimiters)
+     */
+    bool addLabel(const char* label) {
+        if (label == nullptr || this->labelCount >= MAX_LABELS)
+            return false;
+        unsigned int labelSize = 0;
+        while (label[labelSize] != '\0') {
+            if (static_cast<uint8_t>(label[labelSize]) <= SP || labelSize >= MAX_LABEL_SIZE) /* Markers and delimiters cannot be part of a label */
+                return false;
+            labelSize++;
+        }
+        if (labelSize == 0)
+            return false;
+        this->labels[this->labelCount] = reinterpret_cast<const uint8_t*>(label);
+        this->labelSizes[this->labelCount] = static_cast<uint8_t>(labelSize);
+        this->labelCount++;
+        return true;
+    }
+
+    /**
+     * @brief Remove all labels from the allowlist (all datasets are then rejected)
+     */
+    void clear() {
+        this->labelCount = 0;
+    }
+
+    /**
+     * @brief Get the number of labels in the allowlist
+     */
+    unsigned int getLabelCount() const {
+        return this->labelCount;
+    }
+
+    /**
+     * @brief Match the first bytes of a dataset (right after its start marker) against the allowlist
+     *
+     * The available bytes are provided in two parts (as a dataset can be split between an internal buffer and incoming bytes). They can extend past the end of the dataset
+     *
+     * @param head The first available bytes of the dataset (may be empty)
+     * @param headLen The number of bytes in @p head
+     * @param tail The next available bytes of the dataset (may be empty)
+     * @param tailLen The number of bytes in @p tail
+     * @return Decision::Accept if a label of the allowlist followed by a delimiter starts the dataset, Decision::Reject if none can, Decision::Undecided if more bytes are needed
+     */
+    Decision decide(const uint8_t* head, unsigned int headLen, const uint8_t* tail, unsigned int tailLen) const {
+        unsigned int available = headLen + tailLen;
+        bool undecided = false;
+        for (unsigned int labelIdx = 0; labelIdx < this->labelCount; labelIdx++) {
+            const uint8_t* label = this->labels[labelIdx];
+            unsigned int labelSize = this->labelSizes[labelIdx];
+            unsigned int pos = 0;
+            while (pos < labelSize && pos < available && byteAt(head, headLen, tail, pos) == label[pos])
+                pos++;
+            if (pos < labelSize && pos < available)
+                continue; /* Mismatch */
+            if (pos >= available) { /* Label or delimiter not received yet */
+                undecided = true;
+                continue;
+            }
+            uint8_t delimiter = byteAt(head, headLen, tail, labelSize);
+            if (delimiter == HT || delimiter == SP)
+                return Decision::Accept;
+        }
+        return undecided ? Decision::Undecided : Decision::Reject;
+    }
+
+private:
+    /**
+     * @brief Get the byte at @p pos in the concatenation of @p head and @p tail
+     */
+    static uint8_t byteAt(const uint8_t* head, unsigned int headLen, const uint8_t* tail, unsigned int pos) {
+        return (pos < headLen) ? head[pos] : tail[pos - headLen];
+    }
+
+/* Attributes */
+    const uint8_t* labels[MAX_LABELS]; /*!< The labels in the allowlist (not NUL-terminated, see labelSizes) */
+    uint8_t labelSizes[MAX_LABELS]; /*!< The size of each label in labels */
+    unsigned int labelCount; /*!< The number of labels in the allowlist */
+};
+} // namespace TIC
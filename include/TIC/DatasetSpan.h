@@ -0,0 +1,16 @@
+/**
+ * @file DatasetSpan.h
+ * @brief Location of one dataset inside a frame buffer
+ */
+#pragma once
+#include <stdint.h>
+
+namespace TIC {
+/**
+ * @brief The location of one dataset inside a frame buffer
+ */
+struct DatasetSpan {
+    uint16_t offset; /*!< The offset of the first dataset byte (after the start marker) from the beginning of the frame */
+    uint16_t length; /*!< The number of bytes in the dataset (excluding start and end markers) */
+};
+} // namespace TIC
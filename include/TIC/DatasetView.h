@@ -7,6 +7,7 @@
 #include <string>
 #endif
 #include <stdint.h>
+#include "TIC/LabelId.h"
 
 #ifndef ARDUINO
 #define STATIC_CONSTEXPR static constexpr
@@ -88,6 +89,114 @@ public:
     uint8_t second;
 };
 
+/**
+ * @brief Information about a dataset buffer collected while its bytes were received
+ *
+ * Decoders that already touch each byte of a dataset (for example to copy it) can accumulate this information on the fly using accountByte(),
+ * then provide it to DatasetView so that the dataset is checked and split without having to read the buffer again
+ */
+struct DatasetPrescan {
+/* Constants */
+    STATIC_CONSTEXPR unsigned int NO_POS = (unsigned int)(-1); /*!< Position value meaning that no such delimiter was found */
+
+/* Methods */
+    DatasetPrescan() :
+    byteSum(0),
+    htPos{NO_POS, NO_POS},
+    spPos{NO_POS, NO_POS} { }
+
+    /**
+     * @brief Restart the collection for a new dataset buffer
+     */
+    void reset() {
+        *this = DatasetPrescan();
+    }
+
+    /**
+     * @brief Take into account one more byte of the dataset buffer
+     *
+     * @param byte The new byte
+     * @param pos The position of @p byte within the dataset buffer (bytes must be accounted in increasing position order)
+     */
+    void accountByte(uint8_t byte, unsigned int pos) {
+        this->byteSum += byte;
+        this->accountDelimiter(byte, pos);
+    }
+
+    /**
+     * @brief Take into account the position of one more byte of the dataset buffer, without adding it to byteSum
+     *
+     * This allows callers to sum bytes by blocks, and only call this method for the delimiter bytes
+     *
+     * @param byte The new byte (it is ignored if it is not a delimiter)
+     * @param pos The position of @p byte within the dataset buffer (bytes must be accounted in increasing position order)
+     */
+    void accountDelimiter(uint8_t byte, unsigned int pos) {
+        if (byte == 0x09) {
+            if (this->htPos[0] == NO_POS)
+                this->htPos[0] = pos;
+            else if (this->htPos[1] == NO_POS)
+                this->htPos[1] = pos;
+        }
+        else if (byte == 0x20) {
+            if (this->spPos[0] == NO_POS)
+                this->spPos[0] = pos;
+            else if (this->spPos[1] == NO_POS)
+                this->spPos[1] = pos;
+        }
+    }
+
+    /**
+     * @brief Take into account the next bytes of the dataset buffer, up to (but excluding) the first end marker found in them
+     *
+     * This allows decoders that search the end of a dataset to collect its prescan in the same pass.
+     * The result is the same as invoking accountByte() for each byte before the end marker, but when SSE2 is available (and __TIC_MARKER_SCANNER_NO_SIMD__ is not defined), 16 bytes are processed per iteration
+     *
+     * @param bytes The new bytes
+     * @param count The number of bytes in @p bytes
+     * @param firstPos The position of the first byte of @p bytes within the dataset buffer (blocks must be accounted in increasing position order)
+     * @param endMarker1 A byte value ending the dataset
+     * @param endMarker2 Another byte value ending the dataset (can be equal to @p endMarker1)
+     * @return A pointer to the first end marker in @p bytes, or nullptr if there is none (all @p count bytes have then been accounted)
+     */
+    const uint8_t* accountBytesUpTo(const uint8_t* bytes, unsigned int count, unsigned int firstPos, uint8_t endMarker1, uint8_t endMarker2);
+
+    /**
+     * @brief Collect the information for a whole dataset buffer at once
+     *
+     * @param datasetBuf A pointer to a byte buffer containing a full dataset
+     * @param datasetBufSz The number of valid bytes in @p datasetBuf
+     * @return The resulting prescan
+     */
+    static DatasetPrescan fromBuffer(const uint8_t* datasetBuf, unsigned int datasetBufSz) {
+        DatasetPrescan result;
+        for (unsigned int pos = 0; pos < datasetBufSz; pos++)
+            result.accountByte(datasetBuf[pos], pos);
+        return result;
+    }
+
+/* Attributes */
+    uint8_t byteSum; /*!< The sum (modulo 256) of all bytes accounted */
+    unsigned int htPos[2]; /*!< The positions of the first two horizontal tabs accounted, or NO_POS */
+    unsigned int spPos[2]; /*!< The positions of the first two spaces accounted, or NO_POS */
+};
+
+/**
+ * @brief Historical TIC dataset format, used to decode datasets with the delimiter and checksum rules known at compile time (see DatasetView)
+ */
+struct HistoricalTicFormat {
+    STATIC_CONSTEXPR uint8_t DELIMITER = 0x20; /*!< The delimiter between dataset fields (space) */
+    STATIC_CONSTEXPR bool IS_STANDARD = false; /*!< Standard TIC? (if so, the delimiter just before the CRC byte is included in the CRC) */
+};
+
+/**
+ * @brief Standard TIC dataset format, used to decode datasets with the delimiter and checksum rules known at compile time (see DatasetView)
+ */
+struct StandardTicFormat {
+    STATIC_CONSTEXPR uint8_t DELIMITER = 0x09; /*!< The delimiter between dataset fields (horizontal tab) */
+    STATIC_CONSTEXPR bool IS_STANDARD = true; /*!< Standard TIC? (if so, the delimiter just before the CRC byte is included in the CRC) */
+};
+
 class DatasetView {
 public:
 /* Types */
@@ -114,6 +223,53 @@ public:
      */
     DatasetView(const uint8_t* datasetBuf, unsigned int datasetBufSz);
 
+    /**
+     * @brief Construct a new TIC::DatasetView object from a dataset buffer, for which a prescan has already been collected
+     *
+     * The result is identical to DatasetView(datasetBuf, datasetBufSz), but the CRC and delimiter positions are taken from @p prescan instead of being searched in the buffer
+     *
+     * @param datasetBuf A pointer to a byte buffer containing a full dataset
+     * @param datasetBufSz The number of valid bytes in @p datasetBuf
+     * @param prescan The prescan collected on exactly the @p datasetBufSz bytes of @p datasetBuf
+     */
+    DatasetView(const uint8_t* datasetBuf, unsigned int datasetBufSz, const DatasetPrescan& prescan);
+
+    /**
+     * @brief Construct a new TIC::DatasetView object from a dataset buffer, expecting a historical TIC dataset
+     *
+     * The result is identical to DatasetView(datasetBuf, datasetBufSz), but the delimiter and CRC rules of historical TIC are known at compile time.
+     * If the dataset turns out not to be delimited by spaces, it is decoded by the generic (slower) path instead
+     *
+     * @param datasetBuf A pointer to a byte buffer containing a full dataset
+     * @param datasetBufSz The number of valid bytes in @p datasetBuf
+     */
+    DatasetView(const uint8_t* datasetBuf, unsigned int datasetBufSz, HistoricalTicFormat);
+
+    /**
+     * @brief Construct a new TIC::DatasetView object from a dataset buffer, expecting a standard TIC dataset
+     *
+     * Same as the HistoricalTicFormat flavour above, for datasets delimited by horizontal tabs
+     */
+    DatasetView(const uint8_t* datasetBuf, unsigned int datasetBufSz, StandardTicFormat);
+
+    /**
+     * @brief Construct a new TIC::DatasetView object from a dataset buffer and its prescan, expecting a historical TIC dataset
+     *
+     * The result is identical to DatasetView(datasetBuf, datasetBufSz, prescan), but only the space positions of @p prescan are used (horizontal tabs do not need to be accounted)
+     *
+     * @param datasetBuf A pointer to a byte buffer containing a full dataset
+     * @param datasetBufSz The number of valid bytes in @p datasetBuf
+     * @param prescan The prescan collected on exactly the @p datasetBufSz bytes of @p datasetBuf
+     */
+    DatasetView(const uint8_t* datasetBuf, unsigned int datasetBufSz, const DatasetPrescan& prescan, HistoricalTicFormat);
+
+    /**
+     * @brief Construct a new TIC::DatasetView object from a dataset buffer and its prescan, expecting a standard TIC dataset
+     *
+     * Same as the HistoricalTicFormat flavour above, only the horizontal tab positions of @p prescan are used
+     */
+    DatasetView(const uint8_t* datasetBuf, unsigned int datasetBufSz, const DatasetPrescan& prescan, StandardTicFormat);
+
     /**
      * @brief Does the dataset buffer used at constructor contain a properly formatted dataset?
      * 
@@ -137,8 +293,74 @@ public:
      */
     uint32_t dataToUint32() const;
 
+    /**
+     * @brief Converts the current data value to a 32-bit unsigned int, reporting errors separately
+     *
+     * Unlike dataToUint32() above, the whole 32-bit range is available (4294967295 is a valid value)
+     *
+     * @param[out] ok Set to true if the value has been decoded, false in case of errors (value does not contain a positive number, does not fit in 32 bits, or dataset is invalid)
+     * @return The decoded value (0 in case of errors)
+     */
+    uint32_t dataToUint32(bool& ok) const;
+
+    /**
+     * @brief Converts the current data value to a 64-bit unsigned int, reporting errors separately
+     *
+     * @param[out] ok Set to true if the value has been decoded, false in case of errors (value does not contain a positive number, does not fit in 64 bits, or dataset is invalid)
+     * @return The decoded value (0 in case of errors)
+     */
+    uint64_t dataToUint64(bool& ok) const;
+
+    /**
+     * @brief Get the type a dataset buffer decodes to, from its prescan, without splitting its fields
+     *
+     * The result is identical to DatasetView(datasetBuf, datasetBufSz, prescan).decodedType, but only the delimiter and CRC bytes of the buffer are read.
+     * This is used by decoders that need to know whether a dataset is valid (for example to feed a TIC::TicModeDetector) without decoding it
+     *
+     * @param datasetBuf A pointer to a byte buffer containing a full dataset
+     * @param datasetBufSz The number of valid bytes in @p datasetBuf
+     * @param prescan The prescan collected on exactly the @p datasetBufSz bytes of @p datasetBuf
+     * @return The type of the dataset
+     */
+    static DatasetType typeFromPrescan(const uint8_t* datasetBuf, unsigned int datasetBufSz, const DatasetPrescan& prescan);
+
+    /**
+     * @brief Get the type a dataset buffer decodes to, without splitting its fields
+     *
+     * The result is identical to DatasetView(datasetBuf, datasetBufSz).decodedType, but the buffer is only summed (16 bytes per iteration when SSE2 is available) to check its CRC, then searched for its first delimiter.
+     * Use typeFromPrescan() instead when the prescan of the dataset is available
+     *
+     * @param datasetBuf A pointer to a byte buffer containing a full dataset
+     * @param datasetBufSz The number of valid bytes in @p datasetBuf
+     * @return The type of the dataset
+     */
+    static DatasetType typeOf(const uint8_t* datasetBuf, unsigned int datasetBufSz);
 
 protected:
+    /**
+     * @brief Decode a dataset buffer, in any TIC format (this is the generic path used by the DatasetView(datasetBuf, datasetBufSz) constructor)
+     *
+     * @param datasetBuf A pointer to a byte buffer containing a full dataset
+     * @param datasetBufSz The number of valid bytes in @p datasetBuf
+     */
+    void decode(const uint8_t* datasetBuf, unsigned int datasetBufSz);
+
+    /**
+     * @brief Decode a dataset buffer with the delimiter and CRC rules of @p TicFormat
+     *
+     * @param datasetBuf A pointer to a byte buffer containing a full dataset
+     * @param datasetBufSz The number of valid bytes in @p datasetBuf
+     * @return false if the delimiter before the CRC byte is not TicFormat::DELIMITER (nothing has been decoded), true otherwise
+     */
+    template<typename TicFormat>
+    bool decodeAs(const uint8_t* datasetBuf, unsigned int datasetBufSz);
+
+    /**
+     * @brief Same as decodeAs() above, using the CRC and delimiter positions of @p prescan instead of searching them in the buffer
+     */
+    template<typename TicFormat>
+    bool decodeAs(const uint8_t* datasetBuf, unsigned int datasetBufSz, const DatasetPrescan& prescan);
+
     /**
      * @brief Compute a TIC label+data CRC
      * 
@@ -159,10 +381,24 @@ public:
      */
     static uint32_t uint32FromValueBuffer(const uint8_t* buf, unsigned int cnt);
 
+    /**
+     * @brief Compute a 64-bit unsigned int value from a dataset value buffer
+     *
+     * Values of 8 digits or more are checked and converted 8 digits at a time, in 64-bit integers (SWAR)
+     *
+     * @param buf A pointer to the dataset value buffer
+     * @param cnt The number of digits in @p buf (leading zeros are allowed)
+     * @param[out] ok Set to true if the value has been decoded, false in case of errors (no digit at all, non-digit characters, or value not fitting in 64 bits)
+     * @return The decoded value (0 in case of errors)
+     */
+    static uint64_t uint64FromValueBuffer(const uint8_t* buf, unsigned int cnt, bool& ok);
+
 /* Attributes */
     DatasetType decodedType;  /*!< What is the resulting type of the parsed dataset? */
     const uint8_t* labelBuffer; /*!< A pointer to the label buffer */
     unsigned int labelSz; /*!< The size of the label in bytes */
+    uint64_t labelKey; /*!< The label packed into an integer key, to match it with a single comparison against TIC::labelKey() (NO_LABEL_KEY if the label cannot be packed, or the dataset is invalid) */
+    LabelId labelId; /*!< The identifier of the label (LabelId::Unknown if the label is not a known one, or the dataset is invalid) */
     const uint8_t* dataBuffer; /*!< A pointer to the data buffer associated with the label */
     unsigned int dataSz; /*!< The size of the label in bytes */
     Horodate horodate; /*!< The horodate for this dataset */
@@ -0,0 +1,121 @@
+/**
+ * @file DecodeErrors.h
+ * @brief Accounting of errors detected while decoding a TIC stream
+ */
+#pragma once
+#include <stdint.h>
+
+namespace TIC {
+/**
+ * @brief A category of error detected while decoding a TIC stream
+ */
+enum class DecodeError : uint8_t {
+    FrameOverflow, /*!< Frame bytes were dropped because the frame did not fit in the unframer's buffer */
+    InterruptedFrame, /*!< A frame was interrupted by the start of the next frame (its end marker is missing) */
+    OutOfSyncBytes, /*!< Bytes received outside of any frame were skipped */
+    DatasetOverflow, /*!< Dataset bytes were dropped because the dataset did not fit in the extractor's buffer */
+    EmptyDataset, /*!< A dataset without any byte (start marker immediately followed by an end marker) was received */
+    DatasetDiscarded, /*!< A dataset that overflowed the extractor's buffer was discarded instead of being delivered (depending on the extractor's overflow policy) */
+    DatasetResync, /*!< The extractor resynchronized on dataset markers after a missing or spurious marker (an end marker missing before a start marker, or a start marker missing before an end marker) */
+};
+
+typedef void(*FOnDecodeErrorFunc)(DecodeError error, unsigned int count, void* context); /*!< The prototype of callbacks invoked for each error, count being the number of bytes involved (dropped or skipped), or 1 for InterruptedFrame and EmptyDataset, or the number of buffered bytes lost for DatasetDiscarded, or the number of bytes lost (possibly 0) for DatasetResync */
+
+/**
+ * @brief Error counters of one decoder instance
+ */
+struct DecodeErrorCounters {
+    uint32_t overflowedFrames; /*!< Number of frames for which bytes have been dropped (FrameOverflow) */
+    uint32_t droppedFrameBytes; /*!< Number of frame bytes dropped (FrameOverflow) */
+    uint32_t interruptedFrames; /*!< Number of frames interrupted by the start of the next frame (InterruptedFrame) */
+    uint32_t outOfSyncBytes; /*!< Number of bytes skipped outside of any frame (OutOfSyncBytes) */
+    uint32_t overflowedDatasets; /*!< Number of datasets for which bytes have been dropped (DatasetOverflow) */
+    uint32_t droppedDatasetBytes; /*!< Number of dataset bytes dropped (DatasetOverflow and DatasetDiscarded) */
+    uint32_t discardedDatasets; /*!< Number of overflowed datasets that were not delivered (DatasetDiscarded) */
+    uint32_t emptyDatasets; /*!< Number of empty datasets received (EmptyDataset) */
+    uint32_t datasetResyncs; /*!< Number of resynchronizations on dataset markers (DatasetResync) */
+    uint32_t resyncLostBytes; /*!< Number of bytes lost during resynchronizations on dataset markers (DatasetResync) */
+};
+
+/**
+ * @brief Error counters, with an optional callback invoked for each error
+ *
+ * Accounting an error is only a few increments (and a call to the callback if one has been set), so it can stay enabled in production
+ */
+class DecodeErrorReporter {
+public:
+    DecodeErrorReporter() :
+    counters(),
+    onError(nullptr),
+    onErrorContext(nullptr) { }
+
+    /**
+     * @brief Set the function to invoke for each error detected
+     *
+     * @param onError A FOnDecodeErrorFunc function to invoke for each error, or nullptr to only update counters
+     * @param onErrorContext A user-defined pointer that will be passed as last argument when invoking onError()
+     */
+    void setCallback(FOnDecodeErrorFunc onError, void* onErrorContext) {
+        this->onError = onError;
+        this->onErrorContext = onErrorContext;
+    }
+
+    /**
+     * @brief Account for an error
+     *
+     * @param error The error category
+     * @param count The number of bytes involved (dropped or skipped), or 1 for InterruptedFrame and EmptyDataset, or the number of buffered bytes lost for DatasetDiscarded, or the number of bytes lost (possibly 0) for DatasetResync
+     * @param firstInItem For FrameOverflow and DatasetOverflow, is this the first overflow in the current frame or dataset (so that it is counted in overflowedFrames or overflowedDatasets)?
+     */
+    void report(DecodeError error, unsigned int count, bool firstInItem = true) {
+        switch (error) {
+        case DecodeError::FrameOverflow:
+            this->counters.overflowedFrames += firstInItem ? 1 : 0;
+            this->counters.droppedFrameBytes += count;
+            break;
+        case DecodeError::InterruptedFrame:
+            this->counters.interruptedFrames += count;
+            break;
+        case DecodeError::OutOfSyncBytes:
+            this->counters.outOfSyncBytes += count;
+            break;
+        case DecodeError::DatasetOverflow:
+            this->counters.overflowedDatasets += firstInItem ? 1 : 0;
+            this->counters.droppedDatasetBytes += count;
+            break;
+        case DecodeError::EmptyDataset:
+            this->counters.emptyDatasets += count;
+            break;
+        case DecodeError::DatasetDiscarded:
+            this->counters.discardedDatasets++;
+            this->counters.droppedDatasetBytes += count;
+            break;
+        case DecodeError::DatasetResync:
+            this->counters.datasetResyncs++;
+            this->counters.resyncLostBytes += count;
+            break;
+        }
+        if (this->onError != nullptr)
+            this->onError(error, count, this->onErrorContext);
+    }
+
+    /**
+     * @brief Get the error counters
+     */
+    const DecodeErrorCounters& getCounters() const {
+        return this->counters;
+    }
+
+    /**
+     * @brief Reset all error counters to 0
+     */
+    void resetCounters() {
+        this->counters = DecodeErrorCounters();
+    }
+
+private:
+    DecodeErrorCounters counters; /*!< The error counters */
+    FOnDecodeErrorFunc onError; /*!< A function pointer invoked for each error (may be nullptr) */
+    void* onErrorContext; /*!< A context pointer passed to onError() at invokation */
+};
+} // namespace TIC
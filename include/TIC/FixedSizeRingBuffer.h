@@ -0,0 +1,108 @@
+/**
+ * @file FixedSizeRingBuffer.h
+ * @brief Statically allocated ring buffer keeping the most recent values
+ */
+#pragma once
+
+namespace TIC {
+/**
+ * @brief A ring buffer of @p SZ elements of type @p T, where pushing a new element into a full buffer overwrites the oldest one
+ *
+ * Storage is allocated inside the instance (no dynamic allocation), pushing is O(1)
+ *
+ * @tparam T The type of elements stored
+ * @tparam SZ The max number of elements stored
+ */
+template<typename T, unsigned int SZ>
+class FixedSizeRingBuffer {
+public:
+    static_assert(SZ > 0, "FixedSizeRingBuffer requires a non-zero size");
+
+/* Methods */
+    FixedSizeRingBuffer() :
+    data(),
+    nextWrite(0),
+    count(0) { }
+
+    /**
+     * @brief Append a new element, discarding the oldest one if the buffer is full
+     *
+     * @param value The element to append
+     */
+    void push(const T& value) {
+        this->data[this->nextWrite] = value;
+        this->nextWrite++;
+        if (this->nextWrite >= SZ)
+            this->nextWrite = 0;
+        if (this->count < SZ)
+            this->count++;
+    }
+
+    /**
+     * @brief Get the number of elements currently stored
+     *
+     * @return The number of elements stored (at most SZ)
+     */
+    unsigned int getCount() const {
+        return this->count;
+    }
+
+    /**
+     * @brief Is the buffer full (the next push() will discard the oldest element)
+     *
+     * @return true if the buffer contains SZ elements
+     */
+    bool isFull() const {
+        return this->count == SZ;
+    }
+
+    /**
+     * @brief Get the element at a given age
+     *
+     * @param index The index of the element to retrieve, 0 being the oldest element stored, and getCount()-1 the most recent one
+     * @return The element at @p index
+     *
+     * @warning @p index must be less than getCount()
+     */
+    const T& at(unsigned int index) const {
+        unsigned int pos = this->nextWrite + SZ - this->count + index;
+        if (pos >= SZ)
+            pos -= SZ;
+        if (pos >= SZ)
+            pos -= SZ;
+        return this->data[pos];
+    }
+
+    /**
+     * @brief Get the oldest element stored
+     *
+     * @warning The buffer must not be empty
+     */
+    const T& oldest() const {
+        return this->at(0);
+    }
+
+    /**
+     * @brief Get the most recent element stored
+     *
+     * @warning The buffer must not be empty
+     */
+    const T& newest() const {
+        return this->at(this->count - 1);
+    }
+
+    /**
+     * @brief Discard all elements
+     */
+    void clear() {
+        this->nextWrite = 0;
+        this->count = 0;
+    }
+
+/* Attributes */
+private:
+    T data[SZ]; /*!< The storage for elements */
+    unsigned int nextWrite; /*!< The index in data of the next element to write */
+    unsigned int count; /*!< The number of valid elements in data */
+};
+} // namespace TIC
@@ -0,0 +1,87 @@
+/**
+ * @file FrameValidator.h
+ * @brief Batch checksum validation of all datasets of a TIC frame
+ */
+#pragma once
+#include <stdint.h>
+
+#include "TIC/DatasetSpan.h"
+
+namespace TIC {
+/* Constants */
+constexpr unsigned int FRAME_VALIDATOR_MAX_FRAME_SIZE = 65535; /*!< Max frame size (so that offsets and lengths fit in a DatasetSpan) */
+
+/**
+ * @brief The datasets of a frame, and the result of their checksum validation (see validateFrame())
+ *
+ * @tparam MaxDatasetsPerFrame The max number of datasets listed for a frame
+ */
+template<unsigned int MaxDatasetsPerFrame>
+struct FrameValidation {
+/* Constants */
+    static constexpr unsigned int MAX_DATASETS_PER_FRAME = MaxDatasetsPerFrame; /*!< The max number of datasets listed for a frame */
+    static constexpr unsigned int VALID_BITMAP_WORDS = (MaxDatasetsPerFrame + 31) / 32; /*!< The number of 32-bit words in validBitmap */
+
+/* Methods */
+    /**
+     * @brief Does dataset @p idx have a correct checksum?
+     *
+     * @param idx The index of the dataset (in spans)
+     * @return true if the checksum is correct, false if it is incorrect (or if @p idx is not a listed dataset)
+     */
+    bool isValid(unsigned int idx) const {
+        return idx < this->spanCount && ((this->validBitmap[idx / 32] >> (idx % 32)) & 1U) != 0;
+    }
+
+/* Attributes */
+    DatasetSpan spans[MaxDatasetsPerFrame]; /*!< The spans of the datasets found in the frame, in the order they appear */
+    uint32_t validBitmap[VALID_BITMAP_WORDS]; /*!< Bit (idx % 32) of validBitmap[idx / 32] is set if the dataset at spans[idx] has a correct checksum */
+    unsigned int spanCount; /*!< The number of valid entries in spans */
+};
+
+/**
+ * @brief Locate all datasets of a frame, and check their checksums, in a single pass over the frame
+ *
+ * A dataset is made of the bytes between a start marker (LF) and the next end marker (CR or LF), like the datasets delivered by TIC::DatasetBatchExtractor for well-formed frames.
+ * A LF end marker also starts the next dataset, unless it is directly followed by another LF (datasets terminated by LF instead of CR).
+ * Bytes outside of datasets are ignored, and an unterminated dataset at the end of the frame is not listed.
+ *
+ * A dataset has a correct checksum if it ends with a delimiter (HT for standard TIC, SP for historical TIC) followed by a checksum byte matching the checksum computed with the rules of this TIC format.
+ * This is the same checksum check as in TIC::DatasetView (a dataset with an incorrect checksum is decoded as DatasetView::WrongCRC or DatasetView::Malformed), but the fields of the dataset are not split, so DatasetView still needs to be used to decode it.
+ *
+ * When SSE2 is available (and __TIC_MARKER_SCANNER_NO_SIMD__ is not defined), the end marker search and the checksum sum are computed together, 16 bytes per iteration, otherwise bytes are processed one by one
+ *
+ * @param frame The frame payload (start and end of frame markers excluded)
+ * @param frameSize The number of bytes in @p frame (at most FRAME_VALIDATOR_MAX_FRAME_SIZE, bytes beyond are ignored)
+ * @param[out] spans An array of @p maxDatasets entries, filled with the spans of the datasets found in @p frame
+ * @param[out] validBitmap An array of (@p maxDatasets + 31) / 32 words, where bit (idx % 32) of validBitmap[idx / 32] is set if the dataset at spans[idx] has a correct checksum (all other bits are cleared)
+ * @param maxDatasets The max number of datasets listed (datasets beyond are ignored)
+ * @return The number of datasets listed in @p spans
+ */
+unsigned int validateFrame(const uint8_t* frame, unsigned int frameSize, DatasetSpan* spans, uint32_t* validBitmap, unsigned int maxDatasets);
+
+/**
+ * @brief Locate all datasets of a frame, and check their checksums, into a FrameValidation
+ *
+ * This is the same as the validateFrame() above, using the arrays of @p result:
+
+TIC::FrameValidation<64> validation;
+TIC::validateFrame(frame, frameSize, validation);
+for (unsigned int idx = 0; idx < validation.spanCount; idx++) {
+  if (validation.isValid(idx)) {
+    TIC::DatasetView dv(frame + validation.spans[idx].offset, validation.spans[idx].length);
+    ...
+  }
+}
+ *
+ * @param frame The frame payload (start and end of frame markers excluded)
+ * @param frameSize The number of bytes in @p frame
+ * @param[out] result The datasets found, and their checksum validation result
+ * @return The number of datasets listed in @p result
+ */
+template<unsigned int MaxDatasetsPerFrame>
+unsigned int validateFrame(const uint8_t* frame, unsigned int frameSize, FrameValidation<MaxDatasetsPerFrame>& result) {
+    result.spanCount = validateFrame(frame, frameSize, result.spans, result.validBitmap, MaxDatasetsPerFrame);
+    return result.spanCount;
+}
+} // namespace TIC
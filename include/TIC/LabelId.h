@@ -0,0 +1,171 @@
+/**
+ * @file LabelId.h
+ * @brief Compile-time identifiers for the labels of historical and standard TIC
+ */
+#pragma once
+#include <stdint.h>
+#include "TIC/LabelKey.h"
+
+/**
+ * @brief List of all labels known by the library, as X(<LabelId enumerator>, <label string>) entries
+ *
+ * Labels that are not valid C++ identifiers get an enumerator where '-' is replaced by '_' and '+' by "_PLUS_"
+ */
+#define TIC_KNOWN_LABELS(X) \
+    /* Historical TIC */ \
+    X(ADCO, "ADCO") \
+    X(OPTARIF, "OPTARIF") \
+    X(ISOUSC, "ISOUSC") \
+    X(BASE, "BASE") \
+    X(HCHC, "HCHC") \
+    X(HCHP, "HCHP") \
+    X(EJPHN, "EJPHN") \
+    X(EJPHPM, "EJPHPM") \
+    X(BBRHCJB, "BBRHCJB") \
+    X(BBRHPJB, "BBRHPJB") \
+    X(BBRHCJW, "BBRHCJW") \
+    X(BBRHPJW, "BBRHPJW") \
+    X(BBRHCJR, "BBRHCJR") \
+    X(BBRHPJR, "BBRHPJR") \
+    X(PEJP, "PEJP") \
+    X(PTEC, "PTEC") \
+    X(DEMAIN, "DEMAIN") \
+    X(IINST, "IINST") \
+    X(IINST1, "IINST1") \
+    X(IINST2, "IINST2") \
+    X(IINST3, "IINST3") \
+    X(ADPS, "ADPS") \
+    X(ADIR1, "ADIR1") \
+    X(ADIR2, "ADIR2") \
+    X(ADIR3, "ADIR3") \
+    X(IMAX, "IMAX") \
+    X(IMAX1, "IMAX1") \
+    X(IMAX2, "IMAX2") \
+    X(IMAX3, "IMAX3") \
+    X(PMAX, "PMAX") \
+    X(PAPP, "PAPP") \
+    X(HHPHC, "HHPHC") \
+    X(MOTDETAT, "MOTDETAT") \
+    X(PPOT, "PPOT") \
+    X(GAZ, "GAZ") \
+    X(AUTRE, "AUTRE") \
+    /* Standard TIC */ \
+    X(ADSC, "ADSC") \
+    X(VTIC, "VTIC") \
+    X(DATE, "DATE") \
+    X(NGTF, "NGTF") \
+    X(LTARF, "LTARF") \
+    X(EAST, "EAST") \
+    X(EASF01, "EASF01") \
+    X(EASF02, "EASF02") \
+    X(EASF03, "EASF03") \
+    X(EASF04, "EASF04") \
+    X(EASF05, "EASF05") \
+    X(EASF06, "EASF06") \
+    X(EASF07, "EASF07") \
+    X(EASF08, "EASF08") \
+    X(EASF09, "EASF09") \
+    X(EASF10, "EASF10") \
+    X(EASD01, "EASD01") \
+    X(EASD02, "EASD02") \
+    X(EASD03, "EASD03") \
+    X(EASD04, "EASD04") \
+    X(EAIT, "EAIT") \
+    X(ERQ1, "ERQ1") \
+    X(ERQ2, "ERQ2") \
+    X(ERQ3, "ERQ3") \
+    X(ERQ4, "ERQ4") \
+    X(IRMS1, "IRMS1") \
+    X(IRMS2, "IRMS2") \
+    X(IRMS3, "IRMS3") \
+    X(URMS1, "URMS1") \
+    X(URMS2, "URMS2") \
+    X(URMS3, "URMS3") \
+    X(PREF, "PREF") \
+    X(PCOUP, "PCOUP") \
+    X(SINSTS, "SINSTS") \
+    X(SINSTS1, "SINSTS1") \
+    X(SINSTS2, "SINSTS2") \
+    X(SINSTS3, "SINSTS3") \
+    X(SMAXSN, "SMAXSN") \
+    X(SMAXSN1, "SMAXSN1") \
+    X(SMAXSN2, "SMAXSN2") \
+    X(SMAXSN3, "SMAXSN3") \
+    X(SMAXSN_1, "SMAXSN-1") \
+    X(SMAXSN1_1, "SMAXSN1-1") \
+    X(SMAXSN2_1, "SMAXSN2-1") \
+    X(SMAXSN3_1, "SMAXSN3-1") \
+    X(SINSTI, "SINSTI") \
+    X(SMAXIN, "SMAXIN") \
+    X(SMAXIN_1, "SMAXIN-1") \
+    X(CCASN, "CCASN") \
+    X(CCASN_1, "CCASN-1") \
+    X(CCAIN, "CCAIN") \
+    X(CCAIN_1, "CCAIN-1") \
+    X(UMOY1, "UMOY1") \
+    X(UMOY2, "UMOY2") \
+    X(UMOY3, "UMOY3") \
+    X(STGE, "STGE") \
+    X(DPM1, "DPM1") \
+    X(FPM1, "FPM1") \
+    X(DPM2, "DPM2") \
+    X(FPM2, "FPM2") \
+    X(DPM3, "DPM3") \
+    X(FPM3, "FPM3") \
+    X(MSG1, "MSG1") \
+    X(MSG2, "MSG2") \
+    X(PRM, "PRM") \
+    X(RELAIS, "RELAIS") \
+    X(NTARF, "NTARF") \
+    X(NJOURF, "NJOURF") \
+    X(NJOURF_PLUS_1, "NJOURF+1") \
+    X(PJOURF_PLUS_1, "PJOURF+1") \
+    X(PPOINTE, "PPOINTE")
+
+namespace TIC {
+/**
+ * @brief Identifier of a known TIC label, to dispatch datasets with a switch instead of comparing label strings
+ *
+ * Identifiers are dense (in the order of TIC_KNOWN_LABELS, starting at 1), so a switch on them compiles to a jump table.
+ * They are looked up from the label key (see LabelKey.h) with a perfect hash built at compile time, so getting the identifier of a label costs about as much as a single label comparison
+ *
+ * Sample code:
+
+switch (datasetView.labelId) {
+  case TIC::LabelId::EAST: onEnergy(datasetView.dataToUint32()); break;
+  case TIC::LabelId::SINSTS: onPower(datasetView.dataToUint32()); break;
+  default: break;
+}
+ */
+enum class LabelId : uint8_t {
+    Unknown = 0, /*!< A label that is not in TIC_KNOWN_LABELS (or the label of an invalid dataset) */
+#define TIC_LABEL_ID_ENUMERATOR(id, label) id,
+    TIC_KNOWN_LABELS(TIC_LABEL_ID_ENUMERATOR)
+#undef TIC_LABEL_ID_ENUMERATOR
+};
+
+/**
+ * @brief Get the identifier of a label
+ *
+ * @param label A pointer to the label bytes (not NUL-terminated)
+ * @param labelSz The number of bytes in @p label
+ * @return The identifier of the label, or LabelId::Unknown if it is not a known label
+ */
+LabelId labelIdFromBuffer(const uint8_t* label, unsigned int labelSz);
+
+/**
+ * @brief Get the identifier of a label from its key
+ *
+ * @param key The key of the label (see labelKey() and labelKeyFromBuffer())
+ * @return The identifier of the label, or LabelId::Unknown if it is not a known label
+ */
+LabelId labelIdFromKey(uint64_t key);
+
+/**
+ * @brief Get the label string of an identifier
+ *
+ * @param id The label identifier
+ * @return The label, as a NUL-terminated string (an empty string for LabelId::Unknown)
+ */
+const char* labelName(LabelId id);
+} // namespace TIC
@@ -0,0 +1,67 @@
+/**
+ * @file LabelKey.h
+ * @brief TIC labels packed into 64-bit integer keys
+ */
+#pragma once
+#include <stdint.h>
+
+namespace TIC {
+/* Constants */
+constexpr unsigned int MAX_LABEL_KEY_SIZE = 9; /*!< The size of the longest label that can be packed into a key (in bytes), this includes all labels of historical and standard TIC */
+constexpr uint64_t NO_LABEL_KEY = 0; /*!< The key of labels that cannot be packed (empty, too long or non-ASCII labels), it never matches a valid label */
+
+/**
+ * @brief Can a label be packed into a key? (compile-time helper for labelKey())
+ */
+constexpr bool isPackableLabel(const char* label, unsigned int pos = 0) {
+    return (label[pos] == '\0') ? (pos > 0) : (pos < MAX_LABEL_KEY_SIZE && static_cast<uint8_t>(label[pos]) < 0x80 && isPackableLabel(label, pos + 1));
+}
+
+/**
+ * @brief Pack the characters of a label, 7 bits each (compile-time helper for labelKey())
+ */
+constexpr uint64_t packLabelChars(const char* label, unsigned int pos = 0) {
+    return (label[pos] == '\0') ? 0 : ((static_cast<uint64_t>(static_cast<uint8_t>(label[pos])) << (7 * pos)) | packLabelChars(label, pos + 1));
+}
+
+/**
+ * @brief Get the key of a label, at compile time
+ *
+ * TIC labels are ASCII and at most 9 characters long, so a label fits in 63 bits (7 bits per character, the first character in the least significant bits).
+ * Two labels are thus equal if and only if their keys are equal, and keys can be used as integer keys in hash maps or sorted containers without hashing strings.
+ *
+ * As this function is constexpr, keys can be used as switch cases:
+
+switch (datasetView.labelKey) {
+  case TIC::labelKey("EAST"): onEnergy(datasetView.dataToUint32()); break;
+  case TIC::labelKey("SINSTS"): onPower(datasetView.dataToUint32()); break;
+  default: break;
+}
+ *
+ * @param label The label, as a NUL-terminated string
+ * @return The key of @p label, or NO_LABEL_KEY if it cannot be packed (empty, longer than MAX_LABEL_KEY_SIZE, or containing non-ASCII characters)
+ */
+constexpr uint64_t labelKey(const char* label) {
+    return isPackableLabel(label) ? packLabelChars(label) : NO_LABEL_KEY;
+}
+
+/**
+ * @brief Get the key of a label received in a buffer
+ *
+ * @param label A pointer to the label bytes (not NUL-terminated)
+ * @param labelSz The number of bytes in @p label
+ * @return The key of the label (identical to labelKey() on the same characters), or NO_LABEL_KEY if it cannot be packed (empty, longer than MAX_LABEL_KEY_SIZE, or containing NUL or non-ASCII bytes)
+ */
+inline uint64_t labelKeyFromBuffer(const uint8_t* label, unsigned int labelSz) {
+    if (labelSz == 0 || labelSz > MAX_LABEL_KEY_SIZE)
+        return NO_LABEL_KEY;
+    uint64_t key = 0;
+    for (unsigned int pos = 0; pos < labelSz; pos++) {
+        uint8_t c = label[pos];
+        if (c == 0 || c >= 0x80) /* A NUL byte would make the key of a shorter label */
+            return NO_LABEL_KEY;
+        key |= static_cast<uint64_t>(c) << (7 * pos);
+    }
+    return key;
+}
+} // namespace TIC
@@ -0,0 +1,126 @@
+/**
+ * @file LazyDatasetView.h
+ * @brief TIC dataset decoder splitting the horodate and value fields only when they are used
+ */
+#pragma once
+#include <stdint.h>
+#include "TIC/DatasetView.h"
+#include "TIC/LabelId.h"
+#include "TIC/LabelKey.h"
+
+namespace TIC {
+/**
+ * @brief A view on a dataset buffer, that only checks the dataset and splits its label at construction
+ *
+ * Compared to TIC::DatasetView, that splits all fields of the dataset and parses its horodate when constructed, the horodate and value fields are only located (and the horodate parsed) when first accessed, then cached.
+ * This is cheaper when most datasets are dropped after looking at their label:
+
+void onDatasetExtracted(const uint8_t* buf, unsigned int cnt, void* context) {
+  TIC::LazyDatasetView dv(buf, cnt);
+  if (dv.labelId != TIC::LabelId::SINSTS)
+    return; // The horodate and value of this dataset are never split nor parsed
+  onPower(dv.getHorodate(), dv.dataToUint32());
+}
+ *
+ * For valid datasets, the results (decodedType, label, horodate and value) are identical to those of TIC::DatasetView.
+ * For invalid datasets, the label and value are empty.
+ *
+ * @note The dataset buffer must stay valid as long as the view is used, as the value and horodate are read from it on first access
+ */
+class LazyDatasetView {
+public:
+/* Types */
+    typedef DatasetView::DatasetType DatasetType; /*!< A category resulting of the analysis of a dataset (same as for TIC::DatasetView) */
+
+/* Methods */
+    /**
+     * @brief Construct a new TIC::LazyDatasetView object from a dataset buffer, checking its CRC and splitting its label
+     *
+     * @param datasetBuf A pointer to a byte buffer containing a full dataset
+     * @param datasetBufSz The number of valid bytes in @p datasetBuf
+     */
+    LazyDatasetView(const uint8_t* datasetBuf, unsigned int datasetBufSz);
+
+    /**
+     * @brief Does the dataset buffer used at constructor contain a properly formatted dataset?
+     *
+     * @return false if the buffer is malformed
+     */
+    bool isValid() const;
+
+    /**
+     * @brief Check if the current data label matches the one provided as argument
+     *
+     * @param cString The C-style string to compare to
+     *
+     * @return true if the data is valid and matches the provided string
+     */
+    bool labelEquals(const char* cString) const;
+
+    /**
+     * @brief Get a pointer to the data buffer associated with the label (the fields are split on first access)
+     */
+    const uint8_t* getDataBuffer() const;
+
+    /**
+     * @brief Get the size of the data buffer in bytes (the fields are split on first access)
+     */
+    unsigned int getDataSz() const;
+
+    /**
+     * @brief Get the horodate of this dataset (it is parsed on first access)
+     *
+     * @return The horodate (invalid if the dataset has no horodate, or is invalid)
+     */
+    const Horodate& getHorodate() const;
+
+    /**
+     * @brief Converts the current data value to an 32-bit unsigned int (see DatasetView::dataToUint32())
+     *
+     * @return The decoded unsigned int value, or -1 in case of errors (value does not contain a positive number or dataset is invalid)
+     */
+    uint32_t dataToUint32() const;
+
+    /**
+     * @brief Converts the current data value to a 32-bit unsigned int, reporting errors separately (see DatasetView::dataToUint32(bool&))
+     *
+     * @param[out] ok Set to true if the value has been decoded, false in case of errors
+     * @return The decoded value (0 in case of errors)
+     */
+    uint32_t dataToUint32(bool& ok) const;
+
+    /**
+     * @brief Converts the current data value to a 64-bit unsigned int, reporting errors separately (see DatasetView::dataToUint64(bool&))
+     *
+     * @param[out] ok Set to true if the value has been decoded, false in case of errors
+     * @return The decoded value (0 in case of errors)
+     */
+    uint64_t dataToUint64(bool& ok) const;
+
+private:
+    /**
+     * @brief Locate the optional horodate and the data inside the value fields, if not done yet
+     */
+    void splitValueFields() const;
+
+public:
+/* Attributes */
+    DatasetType decodedType;  /*!< What is the resulting type of the parsed dataset? */
+    const uint8_t* labelBuffer; /*!< A pointer to the label buffer */
+    unsigned int labelSz; /*!< The size of the label in bytes */
+    uint64_t labelKey; /*!< The label packed into an integer key (see DatasetView::labelKey) */
+    LabelId labelId; /*!< The identifier of the label (see DatasetView::labelId) */
+
+private:
+    const uint8_t* valueFieldsBuffer; /*!< The fields following the label: optional horodate+delimiter, then data */
+    unsigned int valueFieldsSz; /*!< The size of valueFieldsBuffer in bytes */
+    uint8_t delimiter; /*!< The delimiter between fields of this dataset */
+    mutable bool valueFieldsSplit; /*!< Have horodateBuffer, horodateSz, dataBuffer and dataSz been computed? */
+    mutable bool horodateParsed; /*!< Has horodate been parsed? */
+    mutable const uint8_t* horodateBuffer; /*!< A pointer to the horodate field */
+    mutable unsigned int horodateSz; /*!< The size of the horodate field in bytes (0 if there is none) */
+    mutable const uint8_t* dataBuffer; /*!< A pointer to the data buffer associated with the label */
+    mutable unsigned int dataSz; /*!< The size of the data in bytes */
+    mutable Horodate horodate; /*!< The horodate for this dataset */
+};
+} // namespace TIC
@@ -0,0 +1,47 @@
+/**
+ * @file MarkerScanner.h
+ * @brief Fast search of TIC marker bytes inside a byte buffer
+ */
+#pragma once
+#include <stdint.h>
+
+namespace TIC {
+/**
+ * @brief Utility class to locate the first occurence of any byte out of a small set of marker bytes in a buffer, in a single pass
+ *
+ * This is used to replace successive memchr() calls on the same buffer (one per marker), that would read each byte several times when no marker is present
+ *
+ * The implementation is selected at compile time, depending on the target instruction set:
+ * * AVX2 (32 bytes per iteration) if __AVX2__ is defined
+ * * SSE2 (16 bytes per iteration) if __SSE2__ is defined
+ * * NEON (16 bytes per iteration) if __ARM_NEON is defined
+ * * SWAR (SIMD within a register, 8 bytes per iteration using 64-bit integer arithmetic) otherwise
+ *
+ * Defining the __TIC_MARKER_SCANNER_NO_SIMD__ preprocessor directive forces the SWAR implementation, even if SIMD instructions are available
+ */
+class MarkerScanner {
+public:
+    /**
+     * @brief Find the first byte equal to @p marker1 or @p marker2 inside a buffer
+     *
+     * @param buffer The buffer to search
+     * @param len The number of bytes to search in @p buffer
+     * @param marker1 The first marker byte to search for
+     * @param marker2 The second marker byte to search for (can be equal to @p marker1 to search for only one marker)
+     * @return A pointer to the first matching byte in @p buffer, or nullptr if none of the markers is found
+     */
+    static const uint8_t* findFirstOf(const uint8_t* buffer, unsigned int len, uint8_t marker1, uint8_t marker2);
+
+    /**
+     * @brief Find the first byte equal to @p marker inside a buffer
+     *
+     * @param buffer The buffer to search
+     * @param len The number of bytes to search in @p buffer
+     * @param marker The marker byte to search for
+     * @return A pointer to the first matching byte in @p buffer, or nullptr if @p marker is not found
+     */
+    static const uint8_t* find(const uint8_t* buffer, unsigned int len, uint8_t marker) {
+        return findFirstOf(buffer, len, marker, marker);
+    }
+};
+} // namespace TIC
@@ -0,0 +1,141 @@
+/**
+ * @file MultiStreamDecoder.h
+ * @brief Parallel decoding of many independent TIC streams on a pool of worker threads
+ */
+#pragma once
+#include <stdint.h>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "TIC/DatasetView.h"
+
+namespace TIC {
+/**
+ * @brief Class decoding many independent TIC byte streams (for example one per meter line) using a work-stealing pool of threads
+ *
+ * Each stream owns its own decoder state (a TIC::StreamDecoder). Bytes for a given stream are submitted as batches via pushBytes(), from any thread.
+ * Batches are copied, so the caller's buffer can be reused as soon as pushBytes() returns.
+ *
+ * Decoding is performed by worker threads. Each worker has its own task queue, holding the streams that have pending bytes.
+ * A worker first processes its own queue (most recent submission first), then steals the oldest tasks from the other workers' queues when its own queue is empty.
+ * A stream receiving bytes while being decoded is queued again behind all other tasks of its worker's queue (where it is also the first to be stolen), so that a continuously fed stream cannot starve the others.
+ *
+ * For a given stream, batches are decoded in submission order and never by two workers at the same time, so datasets are reported in stream order.
+ * Different streams are decoded in parallel.
+ *
+ * For each dataset decoded, the onDatasetDecoded() callback is invoked from a worker thread, with the stream identifier, the dataset, and the context pointer provided at construction.
+ * This callback can thus be invoked concurrently for different streams, but is never invoked concurrently for the same stream.
+ *
+ * @note Unlike the rest of the library, this class relies on threads and dynamic allocation, and is thus meant for hosted platforms (it is not available on Arduino)
+ */
+class MultiStreamDecoder {
+public:
+/* Types */
+    typedef void(*FOnStreamDatasetFunc)(unsigned int streamId, const DatasetView& dataset, void* context); /*!< The prototype of callbacks invoked onDatasetDecoded */
+
+/* Methods */
+    /**
+     * @brief Construct a new TIC::MultiStreamDecoder object, and start its worker threads
+     *
+     * @param streamCount The number of streams handled, stream identifiers are in range [0;streamCount-1]
+     * @param workerCount The number of worker threads to start (0 means one per hardware thread)
+     * @param onDatasetDecoded A FOnStreamDatasetFunc function to invoke for each TIC dataset decoded
+     * @param onDatasetDecodedContext A user-defined pointer that will be passed as last argument when invoking onDatasetDecoded()
+     */
+    MultiStreamDecoder(unsigned int streamCount, unsigned int workerCount, FOnStreamDatasetFunc onDatasetDecoded, void* onDatasetDecodedContext = nullptr);
+
+    /**
+     * @brief Destroy the TIC::MultiStreamDecoder object, after all pending batches have been decoded
+     */
+    ~MultiStreamDecoder();
+
+    MultiStreamDecoder(const MultiStreamDecoder&) = delete;
+    MultiStreamDecoder& operator=(const MultiStreamDecoder&) = delete;
+
+    /**
+     * @brief Submit new incoming bytes for one stream (this method can be called from any thread)
+     *
+     * @param streamId The identifier of the stream the bytes belong to
+     * @param buffer The new input TIC bytes
+     * @param len The number of bytes to read from @p buffer
+     * @return true if the bytes have been queued, false if @p streamId is out of range
+     */
+    bool pushBytes(unsigned int streamId, const uint8_t* buffer, unsigned int len);
+
+    /**
+     * @brief Wait until all batches submitted so far have been decoded
+     */
+    void flush();
+
+    /**
+     * @brief Get the number of streams handled
+     */
+    unsigned int getStreamCount() const;
+
+    /**
+     * @brief Get the number of worker threads
+     */
+    unsigned int getWorkerCount() const;
+
+    /**
+     * @brief Get the number of tasks that were stolen by a worker from another worker's queue (for statistics)
+     */
+    uint64_t getStolenTaskCount() const;
+
+private:
+    struct StreamState;
+    struct Worker;
+
+    /**
+     * @brief Queue a stream having pending bytes for decoding
+     *
+     * @param streamId The stream to queue
+     * @param workerIndex The worker on which queue the stream is pushed
+     * @param requeue true if the stream is queued again by the worker that just decoded it, in which case it is queued behind the other tasks of this worker
+     */
+    void schedule(unsigned int streamId, unsigned int workerIndex, bool requeue);
+
+    /**
+     * @brief Get the next stream to decode for a worker, from its own queue or stolen from another worker
+     *
+     * @param workerIndex The worker requesting a task
+     * @param[out] streamId The stream to decode
+     * @return true if a task was found
+     */
+    bool takeTask(unsigned int workerIndex, unsigned int& streamId);
+
+    /**
+     * @brief Decode all pending bytes of a stream, then either queue it again (if new bytes arrived meanwhile) or mark it as idle
+     *
+     * @param workerIndex The worker running this task
+     * @param streamId The stream to decode
+     */
+    void runTask(unsigned int workerIndex, unsigned int streamId);
+
+    /**
+     * @brief The main loop of a worker thread
+     *
+     * @param workerIndex The index of this worker
+     */
+    void workerLoop(unsigned int workerIndex);
+
+/* Attributes */
+    FOnStreamDatasetFunc onDatasetDecoded; /*!< A function pointer invoked for each TIC dataset decoded */
+    void* onDatasetDecodedContext; /*!< A context pointer passed to onDatasetDecoded() at invokation */
+    std::vector<std::unique_ptr<StreamState>> streams; /*!< The per-stream states */
+    std::vector<std::unique_ptr<Worker>> workers; /*!< The worker threads and their task queues */
+    std::atomic<unsigned int> nextSubmitWorker; /*!< Round-robin index of the worker queue receiving streams scheduled by pushBytes() */
+    std::atomic<unsigned int> queuedTasks; /*!< The number of tasks currently queued, in all workers' queues */
+    std::atomic<unsigned int> sleepingWorkers; /*!< The number of workers waiting (or about to wait) on wakeWorkers */
+    std::atomic<unsigned int> busyStreams; /*!< The number of streams either queued or being decoded */
+    std::atomic<uint64_t> stolenTasks; /*!< The number of tasks stolen from another worker's queue */
+    std::atomic<bool> stopping; /*!< Set to request worker threads to exit */
+    std::mutex sleepLock; /*!< Protects waits on wakeWorkers and flushed */
+    std::condition_variable wakeWorkers; /*!< Notified when a task is queued while a worker sleeps (or at shutdown) */
+    std::condition_variable flushed; /*!< Notified when busyStreams drops to 0 */
+};
+} // namespace TIC
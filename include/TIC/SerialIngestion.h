@@ -0,0 +1,171 @@
+/**
+ * @file SerialIngestion.h
+ * @brief Linux epoll-based ingestion of TIC bytes from serial ports (tty) or pseudo-terminals (pty)
+ */
+#pragma once
+#include <stdint.h>
+#include <vector>
+
+namespace TIC {
+/**
+ * @brief Class reading TIC bytes from many serial file descriptors, multiplexed with epoll
+ *
+ * File descriptors (serial ports opened with openSerial(), or any other readable descriptor, like a pty) are registered with addFd(), along with a callback.
+ * Each call to poll() waits for readable descriptors, then reads all available bytes from each of them, using reads as large as the read buffer, and forwards them to the descriptor's callback.
+ * The callback has the same prototype as TIC::Unframer's onNewFrameBytes, so it will usually push bytes into this line's own decoder:
+
+void onSerialBytes(const uint8_t* buf, unsigned int cnt, void* context) {
+  static_cast<TIC::Unframer*>(context)->pushBytes(buf, cnt);
+}
+
+TIC::SerialIngestion ingestion;
+TIC::Unframer unframer(onFrameNewBytes, onFrameComplete, &datasetExtractor);
+int fd = TIC::SerialIngestion::openSerial("/dev/ttyUSB0", TIC::SerialIngestion::Mode::Historical);
+ingestion.addFd(fd, onSerialBytes, &unframer);
+while (ingestion.poll(-1) >= 0) { }
+ *
+ * Statistics are collected for each descriptor (read syscalls and read sizes) and globally (epoll_wait() and read() syscalls), to tune the read buffer size and polling rate
+ *
+ * When a descriptor reaches end of file or a read error (for example when the other side of a pty is closed), it is removed from the epoll set and flagged as closed in its statistics.
+ * Descriptors are never closed by this class, this is up to the caller.
+ *
+ * @note This class is only available on Linux, and relies on dynamic allocation
+ */
+class SerialIngestion {
+public:
+/* Types */
+    typedef void(*FOnNewBytesFunc)(const uint8_t* buf, unsigned int cnt, void* context); /*!< The prototype of callbacks invoked with bytes read from a descriptor */
+
+    /**
+     * @brief The TIC mode of a serial line, selecting its serial port settings
+     */
+    enum class Mode {
+        Historical, /*!< Historical TIC: 1200 bauds, 7 data bits, even parity, 1 stop bit */
+        Standard, /*!< Standard TIC: 9600 bauds, 7 data bits, even parity, 1 stop bit */
+    };
+
+/* Constants */
+    static constexpr unsigned int DEFAULT_READ_BUFFER_SIZE = 4096; /*!< Default size of the buffer used for each read() syscall */
+    static constexpr unsigned int READ_SIZE_BUCKETS = 16; /*!< Number of buckets in read size histograms */
+
+    /**
+     * @brief Statistics collected for one file descriptor
+     */
+    struct FdStatistics {
+        uint64_t readCalls; /*!< Number of read() syscalls performed on this descriptor */
+        uint64_t emptyReads; /*!< Number of read() syscalls that returned no byte (EAGAIN) */
+        uint64_t bytesRead; /*!< Total number of bytes read */
+        unsigned int maxReadSize; /*!< Largest number of bytes returned by a single read() */
+        uint64_t readSizeHistogram[READ_SIZE_BUCKETS]; /*!< Number of non-empty reads per size: bucket n counts reads of [2^n;2^(n+1)-1] bytes (the last bucket also counts larger reads) */
+        bool closed; /*!< Has the descriptor been removed after end of file or a read error? */
+    };
+
+/* Methods */
+    /**
+     * @brief Construct a new TIC::SerialIngestion object
+     *
+     * @param readBufferSize The size of the buffer used for each read() syscall
+     */
+    SerialIngestion(unsigned int readBufferSize = DEFAULT_READ_BUFFER_SIZE);
+
+    /**
+     * @brief Destroy the TIC::SerialIngestion object (registered descriptors are not closed)
+     */
+    ~SerialIngestion();
+
+    SerialIngestion(const SerialIngestion&) = delete;
+    SerialIngestion& operator=(const SerialIngestion&) = delete;
+
+    /**
+     * @brief Has the epoll instance been properly created?
+     *
+     * @return false if the object is unusable
+     */
+    bool isValid() const;
+
+    /**
+     * @brief Open a serial port in non-blocking mode, and configure it for TIC
+     *
+     * @param path The path to the serial device (for example /dev/ttyUSB0)
+     * @param mode The TIC mode, selecting the baud rate
+     * @return The opened file descriptor, or -1 in case of error
+     */
+    static int openSerial(const char* path, Mode mode);
+
+    /**
+     * @brief Configure an already opened serial file descriptor for TIC (raw mode, 7E1, at the baud rate corresponding to @p mode)
+     *
+     * @param fd The file descriptor of a tty (or pty)
+     * @param mode The TIC mode, selecting the baud rate
+     * @return true on success
+     */
+    static bool configureSerial(int fd, Mode mode);
+
+    /**
+     * @brief Register a file descriptor to read from
+     *
+     * @param fd The file descriptor (it will be switched to non-blocking mode)
+     * @param onNewBytes The function to invoke with bytes read from @p fd
+     * @param onNewBytesContext A user-defined pointer that will be passed as last argument when invoking onNewBytes()
+     * @return The index of this descriptor (to be used with getStatistics()), or -1 in case of error
+     */
+    int addFd(int fd, FOnNewBytesFunc onNewBytes, void* onNewBytesContext = nullptr);
+
+    /**
+     * @brief Wait for readable descriptors, and forward all bytes available on them to their callbacks
+     *
+     * @param timeoutMs The max time to wait for a descriptor to become readable, in milliseconds (-1 to wait forever, 0 to return immediately)
+     * @return The number of bytes forwarded to callbacks, or -1 in case of error (or if no descriptor remains open)
+     */
+    int poll(int timeoutMs);
+
+    /**
+     * @brief Get the number of descriptors registered (including closed ones)
+     */
+    unsigned int getFdCount() const;
+
+    /**
+     * @brief Get the statistics for one descriptor
+     *
+     * @param index The index returned by addFd()
+     */
+    const FdStatistics& getStatistics(unsigned int index) const;
+
+    /**
+     * @brief Get the number of epoll_wait() syscalls performed
+     */
+    uint64_t getEpollWaitCount() const;
+
+    /**
+     * @brief Get the total number of read() syscalls performed, on all descriptors
+     */
+    uint64_t getReadCount() const;
+
+private:
+    /**
+     * @brief A registered file descriptor
+     */
+    struct Source {
+        int fd; /*!< The file descriptor */
+        FOnNewBytesFunc onNewBytes; /*!< The function invoked with bytes read from fd */
+        void* onNewBytesContext; /*!< A context pointer passed to onNewBytes() at invokation */
+        FdStatistics stats; /*!< Statistics for this descriptor */
+    };
+
+    /**
+     * @brief Read all bytes available on one source, and forward them to its callback
+     *
+     * @param source The source to read from
+     * @return The number of bytes forwarded
+     */
+    unsigned int drain(Source& source);
+
+/* Attributes */
+    int epollFd; /*!< The epoll instance file descriptor, or -1 if it could not be created */
+    std::vector<uint8_t> readBuffer; /*!< The buffer used for each read() syscall */
+    std::vector<Source> sources; /*!< The registered descriptors */
+    unsigned int openSources; /*!< The number of registered descriptors that are not closed */
+    uint64_t epollWaitCount; /*!< The number of epoll_wait() syscalls performed */
+    uint64_t readCount; /*!< The number of read() syscalls performed */
+};
+} // namespace TIC
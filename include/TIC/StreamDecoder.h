@@ -0,0 +1,302 @@
+/**
+ * @file StreamDecoder.h
+ * @brief Single-pass TIC stream decoder (unframing, dataset extraction and dataset decoding fused together)
+ */
+#pragma once
+#include <stdint.h>
+
+#include "TIC/MarkerScanner.h"
+#include "TIC/DatasetExtractor.h"
+#include "TIC/DatasetView.h"
+#include "TIC/TicModeDetector.h"
+
+namespace TIC {
+/**
+ * @brief Types and constants common to all TIC::BasicStreamDecoder template instances
+ */
+class StreamDecoderBase {
+public:
+/* Types */
+    typedef void(*FDatasetViewFunc)(const DatasetView& dataset, void* context); /*!< The prototype of callbacks invoked onDatasetDecoded */
+    typedef DatasetExtractorBase::TicMode TicMode;
+
+/* Constants */
+    static constexpr uint8_t STX = 0x02; /*!< Frame start marker */
+    static constexpr uint8_t ETX = 0x03; /*!< Frame end marker */
+    static constexpr uint8_t LF = DatasetExtractorBase::LF; /*!< Dataset start marker (and historical end marker) */
+    static constexpr uint8_t CR = DatasetExtractorBase::CR; /*!< Dataset end marker */
+    static constexpr unsigned int MAX_DATASET_SIZE = DATASET_EXTRACTOR_DEFAULT_MAX_DATASET_SIZE; /*!< Max size for a dataset storage (in bytes), bytes beyond this size are dropped, as done by TIC::DatasetExtractor */
+
+protected:
+    /**
+     * @brief Accumulate dataset content bytes, up to the next marker (CR, LF, STX or ETX)
+     *
+     * Bytes are copied to @p dataset and accounted into @p prescan in the same pass. Bytes that do not fit in @p dataset (beyond MAX_DATASET_SIZE) are consumed but dropped.
+     * When SSE2 is available (and __TIC_MARKER_SCANNER_NO_SIMD__ is not defined), 16 bytes are processed per iteration, otherwise bytes are processed one by one
+     *
+     * @tparam Mode The TIC mode locked on the stream: with TicMode::Historical (resp. TicMode::Standard), only spaces (resp. horizontal tabs) are located in @p prescan, with TicMode::Unknown, both are
+     *
+     * @param buffer The input bytes
+     * @param len The number of bytes to read from @p buffer
+     * @param[out] dataset The dataset storage buffer (MAX_DATASET_SIZE bytes)
+     * @param[in,out] datasetLen The number of bytes already stored in @p dataset, updated with the bytes appended
+     * @param[in,out] prescan The prescan for the bytes already stored in @p dataset, updated with the bytes appended
+     * @return The number of bytes consumed from @p buffer (if less than @p len, the next byte in @p buffer is a marker)
+     */
+    template<TicMode Mode>
+    static unsigned int accumulateDatasetBytes(const uint8_t* buffer, unsigned int len, uint8_t* dataset, unsigned int& datasetLen, DatasetPrescan& prescan);
+};
+
+/**
+ * @brief Dataset sink invoking a C-style function pointer with a context pointer (this is the sink used by TIC::StreamDecoder)
+ */
+class StreamDecoderCallbackSink {
+public:
+    StreamDecoderCallbackSink(StreamDecoderBase::FDatasetViewFunc onDatasetDecoded, void* onDatasetDecodedContext) :
+    onDatasetDecoded(onDatasetDecoded),
+    onDatasetDecodedContext(onDatasetDecodedContext) { }
+
+    void operator()(const DatasetView& dataset) {
+        if (this->onDatasetDecoded)
+            this->onDatasetDecoded(dataset, this->onDatasetDecodedContext);
+    }
+
+private:
+    StreamDecoderBase::FDatasetViewFunc onDatasetDecoded; /*!< A function pointer invoked for each TIC dataset decoded */
+    void* onDatasetDecodedContext; /*!< A context pointer passed to onDatasetDecoded() at invokation */
+};
+
+/**
+ * @brief Class to decode a raw TIC byte stream into datasets in a single pass
+ *
+ * This performs the same job as chaining TIC::Unframer, TIC::DatasetExtractor and TIC::DatasetView, but each input byte is read only once:
+ * frame and dataset markers are detected, the dataset is copied, its checksum is summed and its delimiters are located by the same loop (see accumulateDatasetBytes()).
+ * The resulting TIC::DatasetView is then built from this prescan without reading the dataset again.
+ *
+ * The TIC mode of the stream is tracked by a TIC::TicModeDetector: once it is locked, bytes are accumulated and datasets are decoded by code paths specialised for this mode
+ * (only the delimiter of this mode is located, and the CRC rules are known at compile time). The decoded datasets are the same as without a locked mode.
+ *
+ * For each dataset found inside a frame, the sink is invoked with a TIC::DatasetView (including malformed datasets or datasets with a wrong CRC, use DatasetView::isValid() to filter them out)
+ * The sequence of datasets is the same as the one produced by the three stages pipeline when it is fed one byte at a time (with the DatasetView types fed back to the extractor with DatasetExtractor::accountDataset(), or with TIC::ViewDatasetExtractor, so that it tracks the TIC mode as well):
+ * * A frame starts with STX and ends with ETX, or with a STX starting the next (truncated) frame
+ * * Inside a frame, a dataset starts after LF and ends on the first CR or LF (a LF ending a dataset also starts the next one, and an empty dataset ended by a LF is ignored)
+ * * Once standard TIC is locked, a LF only ends a dataset if the bytes before it form a valid standard dataset (its CR has been lost), otherwise it is kept as data (as TIC::DatasetExtractor does, both decoders lock the mode on the same datasets)
+ * * A dataset that is not terminated when its frame ends is discarded
+ *
+ * TIC::StreamDecoder is an alias to this template using a StreamDecoderCallbackSink, that invokes a C-style function pointer with a context pointer
+ * Any other callable type can be used as @p DatasetViewSink, and will be stored by value inside the decoder. It is invoked as sink(dataset) for each dataset.
+ *
+ * Sample code to count valid TIC datasets from a TIC byte stream:
+
+struct ValidDatasetCounter {
+  unsigned int* datasetCount;
+  void operator()(const TIC::DatasetView& dataset) { if (dataset.isValid()) (*datasetCount)++; }
+};
+
+unsigned int datasetCount = 0;
+TIC::BasicStreamDecoder<ValidDatasetCounter> decoder(ValidDatasetCounter{&datasetCount});
+decoder.pushBytes(inputBytes, sizeof(inputBytes));
+ *
+ * @tparam DatasetViewSink The callable type invoked for each dataset decoded
+ */
+template<typename DatasetViewSink>
+class BasicStreamDecoder : public StreamDecoderBase {
+public:
+/* Methods */
+    /**
+     * @brief Construct a new TIC::BasicStreamDecoder object invoking a function pointer (only available with StreamDecoderCallbackSink)
+     *
+     * @param onDatasetDecoded A FDatasetViewFunc function to invoke for each TIC dataset decoded
+     * @param onDatasetDecodedContext A user-defined pointer that will be passed as last argument when invoking onDatasetDecoded()
+     */
+    BasicStreamDecoder(FDatasetViewFunc onDatasetDecoded = nullptr, void* onDatasetDecodedContext = nullptr) :
+    onDatasetDecoded(onDatasetDecoded, onDatasetDecodedContext),
+    state(State::OutOfFrame),
+    currentDataset(),
+    nextWriteInCurrentDataset(0),
+    prescan(),
+    modeDetector() { }
+
+    /**
+     * @brief Construct a new TIC::BasicStreamDecoder object invoking a compile-time sink
+     *
+     * @param onDatasetDecoded The callable to invoke for each TIC dataset decoded (it is copied into the decoder)
+     */
+    explicit BasicStreamDecoder(const DatasetViewSink& onDatasetDecoded) :
+    onDatasetDecoded(onDatasetDecoded),
+    state(State::OutOfFrame),
+    currentDataset(),
+    nextWriteInCurrentDataset(0),
+    prescan(),
+    modeDetector() { }
+
+    /**
+     * @brief Take new incoming bytes into account
+     *
+     * @param buffer The new input TIC bytes
+     * @param len The number of bytes to read from @p buffer
+     * @return The number of bytes used from buffer (always @p len)
+     */
+    unsigned int pushBytes(const uint8_t* buffer, unsigned int len);
+
+    /**
+     * @brief Discard any partially received frame, and wait for the next start of frame
+     *
+     * @note The locked TIC mode is kept (see getMode())
+     */
+    void reset() {
+        this->state = State::OutOfFrame;
+        this->startDataset();
+    }
+
+    /**
+     * @brief Are we synchronized with a TIC frame
+     *
+     * @return true When we have received a start of frame marker and we are supposedly parsing the TIC frame content
+     */
+    bool isInSync() const {
+        return this->state != State::OutOfFrame;
+    }
+
+    /**
+     * @brief Get the TIC mode locked on this stream
+     *
+     * @return The locked mode, or TicMode::Unknown while it is being detected (see TIC::TicModeDetector)
+     */
+    TicMode getMode() const {
+        return this->modeDetector.getMode();
+    }
+
+private:
+/* Types */
+    enum class State {
+        OutOfFrame, /*!< Waiting for a start of frame marker */
+        InFrame, /*!< Inside a frame, waiting for a start of dataset marker */
+        InDataset, /*!< Inside a dataset, accumulating its bytes */
+    };
+
+    /**
+     * @brief Discard the current dataset content, getting ready to accumulate a new one
+     */
+    void startDataset() {
+        this->nextWriteInCurrentDataset = 0;
+        this->prescan.reset();
+    }
+
+    /**
+     * @brief Do the bytes of the current dataset received so far form a valid standard TIC dataset? (in standard TIC, a LF only ends a dataset in that case)
+     */
+    bool isCurrentDatasetValidStandard() const {
+        return DatasetView::typeFromPrescan(this->currentDataset, this->nextWriteInCurrentDataset, this->prescan) == DatasetView::DatasetType::ValidStandard;
+    }
+
+    /**
+     * @brief Append one byte to the current dataset, that accumulateDatasetBytes() stopped on (a LF kept as data in standard TIC)
+     */
+    void appendDatasetByte(uint8_t byte) {
+        if (this->nextWriteInCurrentDataset < MAX_DATASET_SIZE) { /* Bytes beyond MAX_DATASET_SIZE are dropped */
+            this->currentDataset[this->nextWriteInCurrentDataset] = byte;
+            this->prescan.accountByte(byte, this->nextWriteInCurrentDataset);
+            this->nextWriteInCurrentDataset++;
+        }
+    }
+
+    /**
+     * @brief Accumulate dataset bytes with the code path specialised for the locked TIC mode (see StreamDecoderBase::accumulateDatasetBytes())
+     */
+    unsigned int accumulateCurrentDatasetBytes(const uint8_t* buffer, unsigned int len) {
+        switch (this->modeDetector.getMode()) {
+        case TicMode::Historical:
+            return StreamDecoderBase::accumulateDatasetBytes<TicMode::Historical>(buffer, len, this->currentDataset, this->nextWriteInCurrentDataset, this->prescan);
+        case TicMode::Standard:
+            return StreamDecoderBase::accumulateDatasetBytes<TicMode::Standard>(buffer, len, this->currentDataset, this->nextWriteInCurrentDataset, this->prescan);
+        default:
+            return StreamDecoderBase::accumulateDatasetBytes<TicMode::Unknown>(buffer, len, this->currentDataset, this->nextWriteInCurrentDataset, this->prescan);
+        }
+    }
+
+    /**
+     * @brief Decode the current dataset (that has been completely received) with the code path specialised for the locked TIC mode, and forward it to the sink
+     */
+    void decodeCurrentDataset() {
+        TicMode mode = this->modeDetector.getMode();
+        DatasetView dataset = (mode == TicMode::Historical) ? DatasetView(this->currentDataset, this->nextWriteInCurrentDataset, this->prescan, HistoricalTicFormat()) :
+                              (mode == TicMode::Standard) ? DatasetView(this->currentDataset, this->nextWriteInCurrentDataset, this->prescan, StandardTicFormat()) :
+                              DatasetView(this->currentDataset, this->nextWriteInCurrentDataset, this->prescan);
+        this->modeDetector.account(dataset.decodedType);
+        this->onDatasetDecoded(dataset);
+    }
+
+/* Attributes */
+    DatasetViewSink onDatasetDecoded; /*!< The sink invoked for each TIC dataset decoded */
+    State state; /*!< The current parsing state */
+    uint8_t currentDataset[MAX_DATASET_SIZE]; /*!< Our internal accumulating buffer used to store the current dataset */
+    unsigned int nextWriteInCurrentDataset; /*!< The index of the next bytes to write in buffer currentDataset */
+    DatasetPrescan prescan; /*!< The checksum and delimiter positions collected while accumulating currentDataset */
+    TicModeDetector modeDetector; /*!< The TIC mode detection, selecting the specialised code paths */
+};
+
+template<typename DatasetViewSink>
+unsigned int BasicStreamDecoder<DatasetViewSink>::pushBytes(const uint8_t* buffer, unsigned int len) {
+    const uint8_t* pos = buffer;
+    const uint8_t* const end = buffer + len;
+    while (pos < end) {
+        switch (this->state) {
+        case State::OutOfFrame: {
+            const uint8_t* startOfFrame = MarkerScanner::find(pos, end - pos, STX);
+            if (!startOfFrame) {
+                pos = end; /* Skip all bytes */
+                break;
+            }
+            pos = startOfFrame + 1;
+            this->state = State::InFrame;
+            break;
+        }
+        case State::InFrame: { /* Between datasets, there are only a few bytes (if any), process them one by one */
+            uint8_t byte = *pos++;
+            if (byte == LF) {
+                this->startDataset();
+                this->state = State::InDataset;
+            }
+            else if (byte == ETX) {
+                this->state = State::OutOfFrame;
+            }
+            /* A STX inside a frame starts a new frame, we are already in the expected state */
+            break;
+        }
+        case State::InDataset: {
+            pos += this->accumulateCurrentDatasetBytes(pos, end - pos);
+            if (pos == end)
+                break; /* Dataset continues in the next chunk */
+            uint8_t marker = *pos++;
+            if (marker == LF && this->modeDetector.getMode() == TicMode::Standard && !this->isCurrentDatasetValidStandard()) { /* In standard TIC, a LF only ends a dataset whose CR has been lost, a spurious LF is kept as data (and will fail the dataset checksum) */
+                this->appendDatasetByte(marker);
+                break;
+            }
+            if (marker == CR) {
+                this->decodeCurrentDataset();
+                this->state = State::InFrame;
+            }
+            else if (marker == LF) { /* The CR of the dataset is missing (or the LF is spurious), this LF starts the next dataset */
+                if (this->nextWriteInCurrentDataset != 0)
+                    this->decodeCurrentDataset();
+            }
+            else if (marker == STX) { /* Truncated frame, the unterminated dataset is discarded, and a new frame starts */
+                this->state = State::InFrame;
+            }
+            else { /* ETX, the unterminated dataset is discarded */
+                this->state = State::OutOfFrame;
+            }
+            this->startDataset();
+            break;
+        }
+        }
+    }
+    return len;
+}
+
+typedef BasicStreamDecoder<StreamDecoderCallbackSink> StreamDecoder; /*!< The stream decoder invoking a C-style function pointer */
+
+/* The function pointer flavour is instanciated once in StreamDecoder.cpp */
+extern template class BasicStreamDecoder<StreamDecoderCallbackSink>;
+} // namespace TIC
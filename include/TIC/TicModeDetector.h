@@ -0,0 +1,128 @@
+/**
+ * @file TicModeDetector.h
+ * @brief Stream-level detection of the TIC mode (historical or standard)
+ */
+#pragma once
+#include <stdint.h>
+
+#include "TIC/DatasetView.h"
+
+namespace TIC {
+/**
+ * @brief The TIC mode of a stream, selecting which bytes can end a dataset
+ */
+enum class TicMode : uint8_t {
+    Unknown, /*!< Mode not detected yet: a dataset ends at the first CR or LF (a LF also starts the next dataset) */
+    Historical, /*!< Historical TIC (datasets delimited by SP): a dataset ends at the first CR or LF (a LF also starts the next dataset) */
+    Standard, /*!< Standard TIC (datasets delimited by HT): a dataset ends at the first CR only, a LF inside a dataset is kept as data (and will fail the dataset checksum) */
+};
+
+/**
+ * @brief Class locking onto the TIC mode (historical or standard) of a stream, from the datasets decoded on that stream
+ *
+ * A TIC line never changes mode, so once a few valid datasets of the same mode have been decoded, decoders can use code paths specialised for this mode
+ * (see the HistoricalTicFormat and StandardTicFormat flavours of TIC::DatasetView). TIC::StreamDecoder and TIC::BasicDatasetExtractor each embed a detector (fed with the datasets they deliver, or by the sink for extractors delivering raw datasets, see BasicDatasetExtractor::accountDataset()).
+ * Each decoded dataset is accounted with account():
+ * * While no mode is locked, the mode is locked after LOCK_AFTER_VALID_DATASETS consecutive valid datasets of the same mode (invalid datasets in between are ignored)
+ * * Once a mode is locked, it is unlocked (and detected again) after REDETECT_AFTER_FAILURES consecutive datasets that are not valid datasets of the locked mode
+ *
+ * Sample code to decode the datasets listed by a TIC::DatasetBatchExtractor with the specialised TIC::DatasetView flavours:
+
+void onFrameDatasets(const uint8_t* frame, unsigned int frameSize, const TIC::DatasetSpan* spans, unsigned int spanCount, void* context) {
+  TIC::TicModeDetector* modeDetector = static_cast<TIC::TicModeDetector*>(context);
+  for (unsigned int idx = 0; idx < spanCount; idx++) {
+    const uint8_t* buf = frame + spans[idx].offset;
+    TIC::DatasetView dv = (modeDetector->getMode() == TIC::TicMode::Standard) ? TIC::DatasetView(buf, spans[idx].length, TIC::StandardTicFormat()) : TIC::DatasetView(buf, spans[idx].length);
+    modeDetector->account(dv.decodedType);
+    ...
+  }
+}
+ */
+class TicModeDetector {
+public:
+/* Types */
+    typedef TIC::TicMode TicMode;
+
+/* Constants */
+    static constexpr unsigned int LOCK_AFTER_VALID_DATASETS = 3; /*!< Number of consecutive valid datasets of the same mode needed to lock onto that mode */
+    static constexpr unsigned int REDETECT_AFTER_FAILURES = 8; /*!< Number of consecutive datasets not matching the locked mode after which the mode is detected again */
+
+/* Methods */
+    TicModeDetector() :
+    mode(TicMode::Unknown),
+    candidateMode(TicMode::Unknown),
+    streak(0) { }
+
+    /**
+     * @brief Take a new decoded dataset into account
+     *
+     * @param decodedType The type of the decoded dataset (see DatasetView::decodedType)
+     * @return true if the locked mode has changed (getMode() returns the new mode)
+     */
+    bool account(DatasetView::DatasetType decodedType) {
+        TicMode datasetMode = TicMode::Unknown;
+        if (decodedType == DatasetView::DatasetType::ValidHistorical)
+            datasetMode = TicMode::Historical;
+        else if (decodedType == DatasetView::DatasetType::ValidStandard)
+            datasetMode = TicMode::Standard;
+
+        if (this->mode != TicMode::Unknown) { /* Locked, streak counts the consecutive failures */
+            if (datasetMode == this->mode) {
+                this->streak = 0;
+                return false;
+            }
+            if (++this->streak < REDETECT_AFTER_FAILURES)
+                return false;
+            this->reset();
+            return true;
+        }
+        /* Not locked yet, streak counts the consecutive valid datasets of candidateMode */
+        if (datasetMode == TicMode::Unknown)
+            return false;
+        if (datasetMode != this->candidateMode) {
+            this->candidateMode = datasetMode;
+            this->streak = 0;
+        }
+        if (++this->streak < LOCK_AFTER_VALID_DATASETS)
+            return false;
+        this->mode = datasetMode;
+        this->streak = 0;
+        return true;
+    }
+
+    /**
+     * @brief Get the locked mode
+     *
+     * @return The locked TIC mode, or TicMode::Unknown if no mode is locked
+     */
+    TicMode getMode() const {
+        return this->mode;
+    }
+
+    /**
+     * @brief Lock onto a mode, as if it had been detected
+     *
+     * @param mode The mode to lock onto (TicMode::Unknown to unlock it, see reset())
+     * @note The locked mode is still unlocked after REDETECT_AFTER_FAILURES consecutive datasets not matching it
+     */
+    void setMode(TicMode mode) {
+        this->reset();
+        this->mode = mode;
+    }
+
+    /**
+     * @brief Unlock the mode, and start detecting it again
+     */
+    void reset() {
+        this->mode = TicMode::Unknown;
+        this->candidateMode = TicMode::Unknown;
+        this->streak = 0;
+    }
+
+private:
+/* Attributes */
+    TicMode mode; /*!< The locked mode (or TicMode::Unknown) */
+    TicMode candidateMode; /*!< While no mode is locked, the mode of the last valid datasets */
+    unsigned int streak; /*!< The number of consecutive valid datasets of candidateMode (not locked), or of consecutive failures (locked) */
+};
+} // namespace TIC
@@ -4,11 +4,275 @@
  */
 #pragma once
 #include <stdint.h>
+#include <string.h> // For memcpy()
+#include "TIC/ByteSegment.h"
+#include "TIC/DecodeErrors.h"
+#include "TIC/FixedSizeRingBuffer.h"
+#include "TIC/MarkerScanner.h"
 
+#ifndef __TIC_UNFRAMER_BUFFER_WHOLE_FRAMES__
 #define __TIC_UNFRAMER_FORWARD_FRAME_BYTES_ON_THE_FLY__
+#endif
 
 /* Use catch2 framework for unit testing? https://github.com/catchorg/Catch2 */
 namespace TIC {
+/**
+ * @brief Types and constants common to all TIC::BasicUnframer template instances
+ */
+class UnframerBase {
+public:
+/* Types */
+    typedef void(*FOnNewFrameBytesFunc)(const uint8_t* buf, unsigned int cnt, void* context); /*!< The prototype of callbacks invoked onNewFrameBytes */
+    typedef void(*FOnFrameCompleteFunc)(void* context); /*!< The prototype of callbacks invoked onFrameComplete */
+
+/* Constants */
+    static constexpr uint8_t STX = 0x02; /*!< The STX marker */
+    static constexpr uint8_t ETX = 0x03; /*!< The ETX marker */
+    static constexpr uint8_t START_MARKER = STX; /*!< Frame start marker (STX) */
+    static constexpr uint8_t END_MARKER = ETX; /*!< Frame end marker (ETX) */
+    static constexpr unsigned int FRAME_HISTORY_SIZE = 16; /*!< Number of recent frames taken into account for statistics *FromRecentHistory() */
+};
+
+/**
+ * @brief Frame sink invoking C-style function pointers with a context pointer (this is the sink used by TIC::Unframer)
+ *
+ * Any frame sink type used with TIC::BasicUnframer must provide the two methods onNewFrameBytes(buf, cnt) and onFrameComplete() below
+ * (and onNewFrameByte(byte) if TIC::BasicUnframer::pushByte() is used)
+ */
+class UnframerCallbackSink {
+public:
+    UnframerCallbackSink(UnframerBase::FOnNewFrameBytesFunc onNewFrameBytes, UnframerBase::FOnFrameCompleteFunc onFrameComplete, void* parserFuncContext) :
+    onNewFrameBytesFunc(onNewFrameBytes),
+    onFrameCompleteFunc(onFrameComplete),
+    parserFuncContext(parserFuncContext) { }
+
+    void onNewFrameBytes(const uint8_t* buf, unsigned int cnt) {
+        if (this->onNewFrameBytesFunc != nullptr)
+            this->onNewFrameBytesFunc(buf, cnt, this->parserFuncContext);
+    }
+
+    void onNewFrameByte(uint8_t byte) {
+        this->onNewFrameBytes(&byte, 1);
+    }
+
+    void onFrameComplete() {
+        if (this->onFrameCompleteFunc != nullptr)
+            this->onFrameCompleteFunc(this->parserFuncContext);
+    }
+
+private:
+    UnframerBase::FOnNewFrameBytesFunc onNewFrameBytesFunc; /*!< Pointer to a function invoked at each new byte block added inside the current frame */
+    UnframerBase::FOnFrameCompleteFunc onFrameCompleteFunc; /*!< Pointer to a function invoked for each full TIC frame received */
+    void* parserFuncContext; /*!< A context pointer passed to onNewFrameBytes() and onFrameComplete() at invokation */
+};
+
+/**
+ * @brief Frame sink invoking two callables (for example lambdas), stored by value
+ *
+ * @tparam FNewFrameBytes A callable invoked as f(buf, cnt) for each new byte block of the current frame
+ * @tparam FFrameComplete A callable invoked as f() for each full TIC frame received
+ */
+template<typename FNewFrameBytes, typename FFrameComplete>
+class UnframerCallableSink {
+public:
+    UnframerCallableSink(const FNewFrameBytes& onNewFrameBytes, const FFrameComplete& onFrameComplete) :
+    onNewFrameBytesCallable(onNewFrameBytes),
+    onFrameCompleteCallable(onFrameComplete) { }
+
+    void onNewFrameBytes(const uint8_t* buf, unsigned int cnt) {
+        this->onNewFrameBytesCallable(buf, cnt);
+    }
+
+    void onNewFrameByte(uint8_t byte) {
+        this->onNewFrameBytesCallable(&byte, 1);
+    }
+
+    void onFrameComplete() {
+        this->onFrameCompleteCallable();
+    }
+
+private:
+    FNewFrameBytes onNewFrameBytesCallable;
+    FFrameComplete onFrameCompleteCallable;
+};
+
+/**
+ * @brief Build an UnframerCallableSink, deducing the callable types
+ */
+template<typename FNewFrameBytes, typename FFrameComplete>
+UnframerCallableSink<FNewFrameBytes, FFrameComplete> makeUnframerSink(const FNewFrameBytes& onNewFrameBytes, const FFrameComplete& onFrameComplete) {
+    return UnframerCallableSink<FNewFrameBytes, FFrameComplete>(onNewFrameBytes, onFrameComplete);
+}
+
+/**
+ * @brief Frame sink forwarding frame bytes to a dataset extractor, and resetting it at the end of each frame
+ *
+ * This is the usual glue between an unframer and a dataset extractor. As the extractor type is known at compile time, the whole chain can be inlined.
+ *
+ * @tparam DatasetExtractorType The type of the dataset extractor (for example a TIC::BasicDatasetExtractor)
+ */
+template<typename DatasetExtractorType>
+class UnframerDatasetExtractorSink {
+public:
+    explicit UnframerDatasetExtractorSink(DatasetExtractorType& datasetExtractor) :
+    datasetExtractor(&datasetExtractor) { }
+
+    void onNewFrameBytes(const uint8_t* buf, unsigned int cnt) {
+        this->datasetExtractor->pushBytes(buf, cnt);
+    }
+
+    void onNewFrameByte(uint8_t byte) {
+        this->datasetExtractor->pushByte(byte);
+    }
+
+    void onFrameComplete() {
+        /* We have finished parsing a frame, if there is an open dataset, we should discard it and start over at the following frame */
+        this->datasetExtractor->reset();
+    }
+
+private:
+    DatasetExtractorType* datasetExtractor; /*!< The dataset extractor to feed */
+};
+
+/**
+ * @brief Unframer mode of operation forwarding frame bytes to onNewFrameBytes() as soon as they are received (no frame buffer)
+ */
+struct UnframerForwardOnTheFly { };
+
+/**
+ * @brief Unframer mode of operation caching whole frames, and forwarding them to onNewFrameBytes() in one chunk
+ */
+struct UnframerBufferWholeFrame { };
+
+/**
+ * @brief Storage and handling of frame bytes, specialized for each Unframer mode of operation
+ *
+ * @note TIC::BasicUnframer inherits from this class, so that the empty storage used in UnframerForwardOnTheFly mode does not use any memory
+ */
+template<typename ForwardPolicy, unsigned int MaxFrameSize>
+class UnframerFrameStorage;
+
+template<unsigned int MaxFrameSize>
+class UnframerFrameStorage<UnframerForwardOnTheFly, MaxFrameSize> {
+protected:
+    /**
+     * @brief Take new frame bytes into account (forward them immediately)
+     * 
+     * @return The number of bytes used from buffer (always @p len)
+     */
+    template<typename FrameSink>
+    unsigned int storeFrameBytes(const uint8_t* buffer, unsigned int len, FrameSink& sink) {
+        if (len > 0)
+            sink.onNewFrameBytes(buffer, len);
+        return len;
+    }
+
+    /**
+     * @brief Take one new frame byte into account (forward it immediately)
+     * 
+     * @return The number of bytes used (always 1)
+     */
+    template<typename FrameSink>
+    unsigned int storeFrameByte(uint8_t byte, FrameSink& sink) {
+        sink.onNewFrameByte(byte);
+        return 1;
+    }
+
+    /**
+     * @brief Forward the current frame, now complete (nothing to do, all bytes have already been forwarded)
+     */
+    template<typename FrameSink>
+    void flushFrame(FrameSink& sink) { }
+
+    /**
+     * @brief Forward a whole frame that is available in one contiguous input buffer (same as forwarding bytes on the fly)
+     * 
+     * @return The number of bytes used from buffer (always @p len)
+     */
+    template<typename FrameSink>
+    unsigned int forwardContiguousFrame(const uint8_t* buffer, unsigned int len, FrameSink& sink) {
+        return this->storeFrameBytes(buffer, len, sink);
+    }
+};
+
+template<unsigned int MaxFrameSize>
+class UnframerFrameStorage<UnframerBufferWholeFrame, MaxFrameSize> {
+protected:
+    UnframerFrameStorage() :
+    currentFrame(),
+    nextWriteInCurrentFrame(0) { }
+
+    /**
+     * @brief Get the remaining free size in our internal buffer currentFrame
+     * 
+     * @return The number of bytes that we can still store or 0 if the buffer is full
+     */
+    unsigned int getFreeBytes() const {
+        return MaxFrameSize - this->nextWriteInCurrentFrame;
+    }
+
+    /**
+     * @brief Take new frame bytes into account (append them to currentFrame)
+     * 
+     * @return The number of bytes used from buffer (if it is <len, some bytes could not be processed due to a full buffer. This is an error case)
+     */
+    template<typename FrameSink>
+    unsigned int storeFrameBytes(const uint8_t* buffer, unsigned int len, FrameSink& sink) {
+        unsigned int maxCopy = this->getFreeBytes();
+        unsigned int szCopy = len;
+        if (szCopy > maxCopy) {  /* currentFrame overflow */
+            szCopy = maxCopy; /* The caller accounts for the dropped bytes as a DecodeError::FrameOverflow */
+        }
+        memcpy(this->currentFrame + this->nextWriteInCurrentFrame, buffer, szCopy);
+        this->nextWriteInCurrentFrame += szCopy;
+        return szCopy;
+    }
+
+    /**
+     * @brief Take one new frame byte into account (append it to currentFrame)
+     * 
+     * @return The number of bytes used (0 if currentFrame is full. This is an error case)
+     */
+    template<typename FrameSink>
+    unsigned int storeFrameByte(uint8_t byte, FrameSink& sink) {
+        if (this->nextWriteInCurrentFrame >= MaxFrameSize)
+            return 0; /* The caller accounts for the dropped byte as a DecodeError::FrameOverflow */
+        this->currentFrame[this->nextWriteInCurrentFrame++] = byte;
+        return 1;
+    }
+
+    /**
+     * @brief Forward the current frame, now complete, in one chunk, and start over
+     */
+    template<typename FrameSink>
+    void flushFrame(FrameSink& sink) {
+        sink.onNewFrameBytes(this->currentFrame, this->nextWriteInCurrentFrame);
+        this->nextWriteInCurrentFrame = 0; /* Wipe any data in the current frame, start over */
+    }
+
+    /**
+     * @brief Forward a whole frame that is available in one contiguous input buffer, without copying it into currentFrame
+     * 
+     * @note The frame is truncated to MaxFrameSize bytes, exactly as if it had been stored into currentFrame
+     * @warning This can only be invoked when no byte of the current frame has been stored yet
+     * 
+     * @return The number of bytes used from buffer (if it is <len, some bytes could not be processed due to a full buffer. This is an error case)
+     */
+    template<typename FrameSink>
+    unsigned int forwardContiguousFrame(const uint8_t* buffer, unsigned int len, FrameSink& sink) {
+        unsigned int szForward = len;
+        if (szForward > MaxFrameSize) {  /* Frame would not fit in currentFrame */
+            szForward = MaxFrameSize;
+        }
+        sink.onNewFrameBytes(buffer, szForward); /* Zero-copy: point directly into the caller's buffer */
+        return szForward;
+    }
+
+/* Attributes */
+    uint8_t currentFrame[MaxFrameSize]; /*!< Our internal accumulating buffer used to store the current frame */
+    unsigned int nextWriteInCurrentFrame; /*!< The index of the next bytes to receive in buffer currentFrame */
+};
+
 /**
  * @brief Class to process a continuous stream of bytes and extract TIC frames payload out of this stream
  * 
@@ -17,14 +281,19 @@ namespace TIC {
  * Note that onNewFrameBytes() and onFrameComplete() functions referred to below are the function pointer that have been provided as constructor argument.
  * Both may be null, in which case, related function calls won't be performed.
  * 
- * There are two modes of operation, selected by the __TIC_UNFRAMER_FORWARD_FRAME_BYTES_ON_THE_FLY__ preprocessor directive
- * 1. If __TIC_UNFRAMER_FORWARD_FRAME_BYTES_ON_THE_FLY__ is defined, each time new bytes are parsed within a valid frame, they are forwarded to onNewFrameBytes()
+ * There are two modes of operation, selected by the @p ForwardPolicy template argument
+ * 1. With UnframerForwardOnTheFly, each time new bytes are parsed within a valid frame, they are forwarded to onNewFrameBytes()
  *    When the end-of-frame is met, a call to onFrameComplete() is performed as well.
- * 2. If __TIC_UNFRAMER_FORWARD_FRAME_BYTES_ON_THE_FLY__ is undefined, bytes for each frame will be cached by instances of this class and forwarded as a whole chunk to onNewFrameBytes(), immediately followed by a call to onFrameComplete()
+ * 2. With UnframerBufferWholeFrame, bytes for each frame will be cached by instances of this class and forwarded as a whole chunk to onNewFrameBytes(), immediately followed by a call to onFrameComplete()
  * 
- * Defining __TIC_UNFRAMER_FORWARD_FRAME_BYTES_ON_THE_FLY__ will be more adapted to embedded systems and avoids having to determine the maximum size of a TIC frame.
+ * UnframerForwardOnTheFly will be more adapted to embedded systems and avoids having to determine the maximum size of a TIC frame.
  * However, the caller will have to cope with determining datasets that below to the same frame (by implementing a state machine based on calls to onFrameComplete)
- * Undefining __TIC_UNFRAMER_FORWARD_FRAME_BYTES_ON_THE_FLY__ will allocate a fixed sized buffer for storing whole frames. Bytes belonging to the same frame will however be sent altogether.
+ * UnframerBufferWholeFrame will allocate a fixed sized buffer of @p MaxFrameSize bytes inside each instance for storing whole frames. Bytes belonging to the same frame will however be sent altogether.
+ * In that mode, frames that are entirely contained in the buffer provided to one pushBytes() call are not copied: onNewFrameBytes() directly receives a pointer inside the caller's buffer.
+ * The internal buffer is only used for frames that span several pushBytes() calls. In all cases, the frame buffer provided to onNewFrameBytes() is only valid during that call.
+ * 
+ * TIC::Unframer is an alias to this template using the default mode, selected by the __TIC_UNFRAMER_FORWARD_FRAME_BYTES_ON_THE_FLY__ preprocessor directive (defined by default, unless __TIC_UNFRAMER_BUFFER_WHOLE_FRAMES__ is defined),
+ * and a max frame size of UNFRAMER_DEFAULT_MAX_FRAME_SIZE bytes. Instances using different modes can co-exist in the same program by using BasicUnframer directly.
  * 
  * onNewFrameBytes() will be invoked with 3 arguments (see its the prototype FOnNewFrameBytesFunc)
  * * The first argument is a buffer containing the frame payload (start and end markers are never sent)
@@ -48,23 +317,20 @@ unframer.pushBytes(inputBytes, sizeof(inputBytes));
 printf("%u\n", frameCount); // Two TIC frames have been parsed, this line will thus print frameCount that equals 2
  * 
  * @note This class is able to parse historical and standard TIC frames
+ *
+ * @tparam ForwardPolicy The mode of operation (UnframerForwardOnTheFly or UnframerBufferWholeFrame)
+ * @tparam MaxFrameSize Max acceptable TIC frame payload size (excluding STX and ETX markers) in UnframerBufferWholeFrame mode
+ * @tparam FrameSink The type receiving frame bytes and end of frame events, stored by value (UnframerCallbackSink invokes the function pointers described above)
  */
-class Unframer {
+template<typename ForwardPolicy, unsigned int MaxFrameSize, typename FrameSink = UnframerCallbackSink>
+class BasicUnframer : public UnframerBase, private UnframerFrameStorage<ForwardPolicy, MaxFrameSize> {
 public:
-/* Types */
-    typedef void(*FOnNewFrameBytesFunc)(const uint8_t* buf, unsigned int cnt, void* context); /*!< The prototype of callbacks invoked onNewFrameBytes */
-    typedef void(*FOnFrameCompleteFunc)(void* context); /*!< The prototype of callbacks invoked onFrameComplete */
-
 /* Constants */
-    static constexpr uint8_t STX = 0x02; /*!< The STX marker */
-    static constexpr uint8_t ETX = 0x03; /*!< The ETX marker */
-    static constexpr uint8_t START_MARKER = STX; /*!< Frame start marker (STX) */
-    static constexpr uint8_t END_MARKER = ETX; /*!< Frame end marker (ETX) */
-    static constexpr unsigned int MAX_FRAME_SIZE = 2048; /* Max acceptable TIC frame payload size (excluding STX and ETX markers) */
+    static constexpr unsigned int MAX_FRAME_SIZE = MaxFrameSize; /*!< Max acceptable TIC frame payload size (excluding STX and ETX markers) */
 
 /* Methods */
     /**
-     * @brief Construct a new TIC::Unframer object
+     * @brief Construct a new TIC::BasicUnframer object invoking function pointers (only available with UnframerCallbackSink)
      * 
      * @param onNewFrameBytes A FOnNewFrameBytesFunc function to invoke for each byte received in the current TIC frame
      * @param onFrameComplete A FOnFrameCompleteFunc function to invoke after a full TiC frame has been received
@@ -74,7 +340,16 @@ public:
      *       This is because we don't have 100% guarantee that exceptions are allowed (especially on embedded targets) and using std::function requires enabling exceptions.
      *       We can still use non-capturing lambdas as function pointer if needed (see https://stackoverflow.com/questions/28746744/passing-capturing-lambda-as-function-pointer)
      */
-    Unframer(FOnNewFrameBytesFunc onNewFrameBytes = nullptr, FOnFrameCompleteFunc onFrameComplete = nullptr, void* parserFuncContext = nullptr);
+    BasicUnframer(FOnNewFrameBytesFunc onNewFrameBytes = nullptr, FOnFrameCompleteFunc onFrameComplete = nullptr, void* parserFuncContext = nullptr);
+
+    /**
+     * @brief Construct a new TIC::BasicUnframer object forwarding frames to a compile-time sink
+     * 
+     * @param sink The sink that will receive frame bytes and end of frame events (it is copied into the unframer)
+     * 
+     * @note As the sink type is known at compile time, calls to the sink can be inlined. See UnframerCallableSink and UnframerDatasetExtractorSink
+     */
+    explicit BasicUnframer(const FrameSink& sink);
 
     /**
      * @brief Take new incoming bytes into account
@@ -85,6 +360,29 @@ public:
      */
     unsigned int pushBytes(const uint8_t* buffer, unsigned int len);
 
+    /**
+     * @brief Take one new incoming byte into account
+     *
+     * This gives the same result as pushBytes(&byte, 1), but is much cheaper when bytes are received one at a time (for example from a UART receive interrupt):
+     * there is no marker search, and frame bytes are forwarded to the sink with its onNewFrameByte() method (UnframerDatasetExtractorSink then invokes the extractor's own pushByte())
+     *
+     * @param byte The new input TIC byte
+     * @return The number of bytes used (0 if the byte could not be processed due to a full buffer. This is an error case)
+     */
+    unsigned int pushByte(uint8_t byte);
+
+    /**
+     * @brief Take new incoming bytes, split into several discontiguous segments, into account
+     *
+     * The segments are processed in order, as one logical stream (this gives the same result as calling pushBytes() on each segment). This avoids copying a wrapped ring buffer (or DMA buffer) into a linear buffer first.
+     * With UnframerBufferWholeFrame, only a frame that straddles a segment boundary is copied into the internal buffer, frames entirely inside one segment are forwarded in place
+     *
+     * @param segments The segments of new input TIC bytes
+     * @param segmentCount The number of segments in @p segments
+     * @return The number of bytes used from all segments (if it is < the total length of the segments, some bytes could not be processed due to a full buffer. This is an error case)
+     */
+    unsigned int pushBytesv(const ByteSegment* segments, unsigned int segmentCount);
+
     /**
      * @brief Are we synchronized with a TIC frame stream
      * 
@@ -95,20 +393,87 @@ public:
     /**
      * @brief Get the max TIC frame size from the recent history buffer
      * 
-     * @return The max frame size in bytes
+     * @return The max frame size in bytes (or 0 if no frame has been received yet)
      */
     unsigned int getMaxFrameSizeFromRecentHistory() const;
 
-private:
-#ifndef __TIC_UNFRAMER_FORWARD_FRAME_BYTES_ON_THE_FLY__
     /**
-     * @brief Get the remaining free size in our internal buffer currentFrame
+     * @brief Get the min TIC frame size from the recent history buffer
      * 
-     * @return The number of bytes that we can still store or 0 if the buffer is full
+     * @return The min frame size in bytes (or 0 if no frame has been received yet)
      */
-    unsigned int getFreeBytes() const;
-#endif
+    unsigned int getMinFrameSizeFromRecentHistory() const;
+
+    /**
+     * @brief Get the mean TIC frame size from the recent history buffer
+     * 
+     * @return The mean frame size in bytes, rounded down (or 0 if no frame has been received yet)
+     */
+    unsigned int getMeanFrameSizeFromRecentHistory() const;
+
+    /**
+     * @brief Get the 95th percentile of TIC frame sizes from the recent history buffer
+     * 
+     * @return The smallest frame size that is greater or equal to 95% of the frame sizes in the recent history (nearest-rank method), or 0 if no frame has been received yet
+     */
+    unsigned int getP95FrameSizeFromRecentHistory() const;
+
+    /**
+     * @brief Get the max number of bytes skipped between two frames (out of sync) from the recent history buffer
+     * 
+     * @return The max number of bytes found between the end of a frame and the start of the next frame (or 0 if no frame has been received yet)
+     */
+    unsigned int getMaxInterFrameGapFromRecentHistory() const;
 
+    /**
+     * @brief Get the total number of frames received
+     * 
+     * @return The number of frames for which onFrameComplete() has been invoked (including truncated frames)
+     */
+    uint32_t getFramesSeen() const;
+
+    /**
+     * @brief Get the total number of bytes skipped while being out of sync (outside of any frame)
+     * 
+     * @note This is a statistic since construction, it is not cleared by resetErrorCounters() (unlike DecodeErrorCounters::outOfSyncBytes)
+     *
+     * @return The number of bytes ignored (excluding the frame STX and ETX markers)
+     */
+    uint32_t getBytesSkippedOutOfSync() const;
+
+    /**
+     * @brief Get the total number of truncated frames
+     * 
+     * @note This covers both interrupted frames (DecodeErrorCounters::interruptedFrames) and overflowed frames (DecodeErrorCounters::overflowedFrames), a frame being counted once even if it is both.
+     *       This is a statistic since construction, it is not cleared by resetErrorCounters()
+     *
+     * @return The number of frames that were not terminated by an ETX marker, or that did not fit in our internal frame buffer
+     */
+    uint32_t getTruncatedFrames() const;
+
+    /**
+     * @brief Set the function to invoke for each error detected (frame overflow, interrupted frame, out of sync bytes)
+     *
+     * @param onError A FOnDecodeErrorFunc function to invoke for each error, or nullptr to only update error counters
+     * @param onErrorContext A user-defined pointer that will be passed as last argument when invoking onError()
+     */
+    void setErrorCallback(FOnDecodeErrorFunc onError, void* onErrorContext = nullptr);
+
+    /**
+     * @brief Get the error counters
+     *
+     * @return The counters of errors detected since construction (or since the last call to resetErrorCounters())
+     */
+    const DecodeErrorCounters& getErrorCounters() const;
+
+    /**
+     * @brief Reset all error counters to 0
+     *
+     * @note The frame statistics (getFramesSeen(), getBytesSkippedOutOfSync() and getTruncatedFrames()) are not reset
+     */
+    void resetErrorCounters();
+
+private:
     /**
      * @brief Take new frame bytes into account
      * 
@@ -122,18 +487,361 @@ private:
      * @brief Process a current frame that has been completely received (from start to end markers)
      * 
      * @note This method is called internally when the current frame parsing is complete
-     *       This means that we have a full frame available in buffer currentFrame for a length of nextWriteInCurrentFrame bytes
+     *       In UnframerBufferWholeFrame mode, this means that we have a full frame available in buffer currentFrame for a length of nextWriteInCurrentFrame bytes
      */
     void processCurrentFrame();
 
+    /**
+     * @brief Process a whole frame (from start to end markers) that was received within a single input buffer
+     * 
+     * @param buffer The buffer to the frame bytes (start and end markers excluded)
+     * @param len The number of bytes in the frame
+     * @return The number of bytes used from buffer (if it is <len, some bytes could not be processed due to a full buffer. This is an error case)
+     * 
+     * @note In UnframerBufferWholeFrame mode, the frame is forwarded from @p buffer without being copied into our internal buffer
+     */
+    unsigned int processContiguousFrame(const uint8_t* buffer, unsigned int len);
+
+    /**
+     * @brief Account for frame bytes that could not be processed due to a full buffer
+     *
+     * @param droppedBytes The number of bytes dropped
+     */
+    void recordFrameOverflow(unsigned int droppedBytes);
+
+    /**
+     * @brief Record statistics about the current frame, that has just been completely received, and start over for the next frame
+     */
+    void recordFrameStatistics();
+
 /* Attributes */
     bool sync;  /*!< Are we currently in sync? (correct parsing) */
-    FOnNewFrameBytesFunc onNewFrameBytes; /*!< Pointer to a function invoked at each new byte block added inside the current frame */
-    FOnFrameCompleteFunc onFrameComplete; /*!< Pointer to a function invoked for each full TIC frame received */
-    void* parserFuncContext; /*!< A context pointer passed to onNewFrameBytes() and onFrameComplete() at invokation */
-#ifndef __TIC_UNFRAMER_FORWARD_FRAME_BYTES_ON_THE_FLY__
-    uint8_t currentFrame[MAX_FRAME_SIZE]; /*!< Our internal accumulating buffer used to store the current frame */
-    unsigned int nextWriteInCurrentFrame; /*!< The index of the next bytes to receive in buffer currentFrame */
-#endif
+    FrameSink sink; /*!< The sink receiving frame bytes and end of frame events */
+    unsigned int currentFrameSize; /*!< The number of bytes received so far in the current frame */
+    bool currentFrameTruncated; /*!< Has the current frame been truncated (unexpected start marker or full buffer)? */
+    bool currentFrameOverflowed; /*!< Have bytes of the current frame been dropped due to a full buffer? */
+    unsigned int currentInterFrameGap; /*!< The number of bytes skipped since the end of the last frame */
+    FixedSizeRingBuffer<unsigned int, FRAME_HISTORY_SIZE> frameSizeHistory; /*!< The sizes of the most recent frames */
+    FixedSizeRingBuffer<unsigned int, FRAME_HISTORY_SIZE> interFrameGapHistory; /*!< The number of bytes skipped before each of the most recent frames */
+    uint32_t frameSizeHistorySum; /*!< The sum of all sizes stored in frameSizeHistory */
+    uint32_t framesSeen; /*!< Total number of frames received */
+    uint32_t truncatedFrames; /*!< Total number of truncated frames */
+    uint32_t bytesSkippedOutOfSync; /*!< Total number of bytes skipped outside of any frame */
+    DecodeErrorReporter errors; /*!< Error counters and optional error callback */
 };
+
+template<typename ForwardPolicy, unsigned int MaxFrameSize, typename FrameSink>
+BasicUnframer<ForwardPolicy, MaxFrameSize, FrameSink>::BasicUnframer(FOnNewFrameBytesFunc onNewFrameBytes, FOnFrameCompleteFunc onFrameComplete, void* parserFuncContext) :
+UnframerFrameStorage<ForwardPolicy, MaxFrameSize>(),
+sync(false),
+sink(onNewFrameBytes, onFrameComplete, parserFuncContext),
+currentFrameSize(0),
+currentFrameTruncated(false),
+currentFrameOverflowed(false),
+currentInterFrameGap(0),
+frameSizeHistory(),
+interFrameGapHistory(),
+frameSizeHistorySum(0),
+framesSeen(0),
+truncatedFrames(0),
+bytesSkippedOutOfSync(0),
+errors() {
+}
+
+template<typename ForwardPolicy, unsigned int MaxFrameSize, typename FrameSink>
+BasicUnframer<ForwardPolicy, MaxFrameSize, FrameSink>::BasicUnframer(const FrameSink& sink) :
+UnframerFrameStorage<ForwardPolicy, MaxFrameSize>(),
+sync(false),
+sink(sink),
+currentFrameSize(0),
+currentFrameTruncated(false),
+currentFrameOverflowed(false),
+currentInterFrameGap(0),
+frameSizeHistory(),
+interFrameGapHistory(),
+frameSizeHistorySum(0),
+framesSeen(0),
+truncatedFrames(0),
+bytesSkippedOutOfSync(0),
+errors() {
+}
+
+template<typename ForwardPolicy, unsigned int MaxFrameSize, typename FrameSink>
+unsigned int BasicUnframer<ForwardPolicy, MaxFrameSize, FrameSink>::pushBytesv(const ByteSegment* segments, unsigned int segmentCount) {
+    unsigned int usedBytes = 0;
+    /* The frame state is kept between pushBytes() calls, so a frame straddling a segment boundary is simply forwarded (or stored) in several parts */
+    for (unsigned int segmentIdx = 0; segmentIdx < segmentCount; segmentIdx++) {
+        usedBytes += this->pushBytes(segments[segmentIdx].buffer, segments[segmentIdx].len);
+    }
+    return usedBytes;
+}
+
+template<typename ForwardPolicy, unsigned int MaxFrameSize, typename FrameSink>
+unsigned int BasicUnframer<ForwardPolicy, MaxFrameSize, FrameSink>::pushBytes(const uint8_t* buffer, unsigned int len) {
+    unsigned int usedBytes = 0;
+    bool frameStartedInBuffer = false; /* Did the current frame start within buffer (so that all its bytes are in buffer)? */
+    /* Each iteration consumes bytes up to the next frame boundary (or up to the end of buffer), so the stack usage does not depend on the number of frames inside buffer */
+    while (len > 0) {
+        if (!this->sync) {  /* We don't record bytes, we'll just look for a start of frame */
+            const uint8_t* firstStx = TIC::MarkerScanner::find(buffer, len, UnframerBase::START_MARKER);
+            if (!firstStx) {
+                /* Skip all bytes */
+                this->currentInterFrameGap += len;
+                this->bytesSkippedOutOfSync += len;
+                this->errors.report(DecodeError::OutOfSyncBytes, len);
+                usedBytes += len;
+                break;
+            }
+            this->sync = true;
+            frameStartedInBuffer = true;
+            unsigned int bytesToSkip = firstStx - buffer;  /* Bytes processed (but ignored) */
+            this->currentInterFrameGap += bytesToSkip;
+            if (bytesToSkip > 0) {
+                this->bytesSkippedOutOfSync += bytesToSkip;
+                this->errors.report(DecodeError::OutOfSyncBytes, bytesToSkip);
+            }
+            bytesToSkip++; /* Also skip the STX marker (it won't be included inside the buffered frame) */
+            usedBytes += bytesToSkip;
+            buffer += bytesToSkip;
+            len -= bytesToSkip;  /* Go on parsing the trailing bytes, now that we are in sync */
+        }
+        else {
+            /* We are inside a TIC frame, search for the end of frame (ETX) marker */
+            /* Historical TIC may not contain any ETX, but a STX would also signify that the current frame is over, so search for both markers in one pass */
+            const uint8_t* etx = nullptr;
+            const uint8_t* stx = nullptr;
+            const uint8_t* marker = TIC::MarkerScanner::findFirstOf(buffer, len, UnframerBase::END_MARKER, UnframerBase::START_MARKER);
+            if (marker) {
+                if (*marker == UnframerBase::END_MARKER) {
+                    etx = marker;
+                }
+                else { /* A STX comes first, but an ETX further away still takes precedence as end of frame */
+                    etx = TIC::MarkerScanner::find(marker + 1, len - (marker + 1 - buffer), UnframerBase::END_MARKER);
+                    if (!etx) {
+                        stx = marker;
+                    }
+                }
+            }
+            if (!etx && !stx) { /* No end of frame was found, copy the whole chunk */
+                usedBytes += this->processIncomingFrameBytes(buffer, len); /* Process these bytes as valid */
+                break;
+            }
+            /* We have detected the end of the current frame in the buffer, we can extract the full frame */
+            unsigned int leadingBytesInPreviousFrame = (etx ? etx : stx) - buffer;
+            if (!etx) {
+                this->currentFrameTruncated = true; /* The frame has been interrupted by the start of the next one */
+                this->errors.report(DecodeError::InterruptedFrame, 1);
+            }
+            if (frameStartedInBuffer) { /* The whole frame is in buffer, up to (but excluding) the end of frame marker */
+                usedBytes += this->processContiguousFrame(buffer, leadingBytesInPreviousFrame);
+            }
+            else {
+                usedBytes += this->processIncomingFrameBytes(buffer, leadingBytesInPreviousFrame); /* Copy the buffer up to (but exclusing the end of frame marker) */
+                this->processCurrentFrame(); /* The frame is complete */
+            }
+            frameStartedInBuffer = false;
+            if (etx) {
+                leadingBytesInPreviousFrame++; /* Skip the ETX marker */
+                usedBytes++;
+            }
+            this->sync = false; /* Consider we are outside of a frame now */
+            buffer += leadingBytesInPreviousFrame;
+            len -= leadingBytesInPreviousFrame; /* Go on with the trailing bytes (probably the next frame, starting with STX) */
+        }
+    }
+    return usedBytes;
+}
+
+template<typename ForwardPolicy, unsigned int MaxFrameSize, typename FrameSink>
+unsigned int BasicUnframer<ForwardPolicy, MaxFrameSize, FrameSink>::pushByte(uint8_t byte) {
+    if (!this->sync) {
+        if (byte == UnframerBase::START_MARKER) {
+            this->sync = true;
+        }
+        else {
+            this->currentInterFrameGap++;
+            this->bytesSkippedOutOfSync++;
+            this->errors.report(DecodeError::OutOfSyncBytes, 1);
+        }
+        return 1;
+    }
+    if (byte == UnframerBase::END_MARKER) {
+        this->processCurrentFrame();
+        this->sync = false;
+        return 1;
+    }
+    if (byte == UnframerBase::START_MARKER) { /* The frame has been interrupted by the start of the next one, this STX starts the next frame */
+        this->currentFrameTruncated = true;
+        this->errors.report(DecodeError::InterruptedFrame, 1);
+        this->processCurrentFrame();
+        return 1;
+    }
+    this->currentFrameSize++;
+    if (this->storeFrameByte(byte, this->sink) == 0) {
+        this->recordFrameOverflow(1);
+        return 0;
+    }
+    return 1;
+}
+
+template<typename ForwardPolicy, unsigned int MaxFrameSize, typename FrameSink>
+unsigned int BasicUnframer<ForwardPolicy, MaxFrameSize, FrameSink>::processIncomingFrameBytes(const uint8_t* buffer, unsigned int len) {
+    this->currentFrameSize += len;
+    unsigned int usedBytes = this->storeFrameBytes(buffer, len, this->sink);
+    if (usedBytes < len) {
+        this->recordFrameOverflow(len - usedBytes);
+    }
+    return usedBytes;
+}
+
+template<typename ForwardPolicy, unsigned int MaxFrameSize, typename FrameSink>
+void BasicUnframer<ForwardPolicy, MaxFrameSize, FrameSink>::processCurrentFrame() {
+    this->recordFrameStatistics();
+    this->flushFrame(this->sink);
+    this->sink.onFrameComplete();
+}
+
+template<typename ForwardPolicy, unsigned int MaxFrameSize, typename FrameSink>
+unsigned int BasicUnframer<ForwardPolicy, MaxFrameSize, FrameSink>::processContiguousFrame(const uint8_t* buffer, unsigned int len) {
+    this->currentFrameSize += len;
+    unsigned int usedBytes = this->forwardContiguousFrame(buffer, len, this->sink);
+    if (usedBytes < len) {
+        this->recordFrameOverflow(len - usedBytes);
+    }
+    this->recordFrameStatistics();
+    this->sink.onFrameComplete();
+    return usedBytes;
+}
+
+template<typename ForwardPolicy, unsigned int MaxFrameSize, typename FrameSink>
+bool BasicUnframer<ForwardPolicy, MaxFrameSize, FrameSink>::isInSync() const {
+    return this->sync;
+}
+
+template<typename ForwardPolicy, unsigned int MaxFrameSize, typename FrameSink>
+void BasicUnframer<ForwardPolicy, MaxFrameSize, FrameSink>::recordFrameOverflow(unsigned int droppedBytes) {
+    this->errors.report(DecodeError::FrameOverflow, droppedBytes, !this->currentFrameOverflowed);
+    this->currentFrameTruncated = true;
+    this->currentFrameOverflowed = true;
+}
+
+template<typename ForwardPolicy, unsigned int MaxFrameSize, typename FrameSink>
+void BasicUnframer<ForwardPolicy, MaxFrameSize, FrameSink>::recordFrameStatistics() {
+    if (this->frameSizeHistory.isFull()) {
+        this->frameSizeHistorySum -= this->frameSizeHistory.oldest(); /* The oldest frame size is going to be dropped out of the history */
+    }
+    this->frameSizeHistory.push(this->currentFrameSize);
+    this->frameSizeHistorySum += this->currentFrameSize;
+    this->interFrameGapHistory.push(this->currentInterFrameGap);
+    this->framesSeen++;
+    if (this->currentFrameTruncated) {
+        this->truncatedFrames++;
+    }
+    this->currentFrameSize = 0;
+    this->currentFrameTruncated = false;
+    this->currentFrameOverflowed = false;
+    this->currentInterFrameGap = 0;
+}
+
+template<typename ForwardPolicy, unsigned int MaxFrameSize, typename FrameSink>
+unsigned int BasicUnframer<ForwardPolicy, MaxFrameSize, FrameSink>::getMaxFrameSizeFromRecentHistory() const {
+    unsigned int result = 0;
+    for (unsigned int idx = 0; idx < this->frameSizeHistory.getCount(); idx++) {
+        if (this->frameSizeHistory.at(idx) > result)
+            result = this->frameSizeHistory.at(idx);
+    }
+    return result;
+}
+
+template<typename ForwardPolicy, unsigned int MaxFrameSize, typename FrameSink>
+unsigned int BasicUnframer<ForwardPolicy, MaxFrameSize, FrameSink>::getMinFrameSizeFromRecentHistory() const {
+    if (this->frameSizeHistory.getCount() == 0)
+        return 0;
+    unsigned int result = this->frameSizeHistory.at(0);
+    for (unsigned int idx = 1; idx < this->frameSizeHistory.getCount(); idx++) {
+        if (this->frameSizeHistory.at(idx) < result)
+            result = this->frameSizeHistory.at(idx);
+    }
+    return result;
+}
+
+template<typename ForwardPolicy, unsigned int MaxFrameSize, typename FrameSink>
+unsigned int BasicUnframer<ForwardPolicy, MaxFrameSize, FrameSink>::getMeanFrameSizeFromRecentHistory() const {
+    if (this->frameSizeHistory.getCount() == 0)
+        return 0;
+    return this->frameSizeHistorySum / this->frameSizeHistory.getCount();
+}
+
+template<typename ForwardPolicy, unsigned int MaxFrameSize, typename FrameSink>
+unsigned int BasicUnframer<ForwardPolicy, MaxFrameSize, FrameSink>::getP95FrameSizeFromRecentHistory() const {
+    unsigned int count = this->frameSizeHistory.getCount();
+    if (count == 0)
+        return 0;
+    unsigned int sorted[FRAME_HISTORY_SIZE];
+    for (unsigned int idx = 0; idx < count; idx++) { /* Insertion sort, the history is short */
+        unsigned int value = this->frameSizeHistory.at(idx);
+        unsigned int pos = idx;
+        for (; pos > 0 && sorted[pos - 1] > value; pos--) {
+            sorted[pos] = sorted[pos - 1];
+        }
+        sorted[pos] = value;
+    }
+    unsigned int rank = (count * 95 + 99) / 100; /* Nearest rank: ceil(95% of count), which is at least 1 */
+    return sorted[rank - 1];
+}
+
+template<typename ForwardPolicy, unsigned int MaxFrameSize, typename FrameSink>
+unsigned int BasicUnframer<ForwardPolicy, MaxFrameSize, FrameSink>::getMaxInterFrameGapFromRecentHistory() const {
+    unsigned int result = 0;
+    for (unsigned int idx = 0; idx < this->interFrameGapHistory.getCount(); idx++) {
+        if (this->interFrameGapHistory.at(idx) > result)
+            result = this->interFrameGapHistory.at(idx);
+    }
+    return result;
+}
+
+template<typename ForwardPolicy, unsigned int MaxFrameSize, typename FrameSink>
+uint32_t BasicUnframer<ForwardPolicy, MaxFrameSize, FrameSink>::getFramesSeen() const {
+    return this->framesSeen;
+}
+
+template<typename ForwardPolicy, unsigned int MaxFrameSize, typename FrameSink>
+uint32_t BasicUnframer<ForwardPolicy, MaxFrameSize, FrameSink>::getBytesSkippedOutOfSync() const {
+    return this->bytesSkippedOutOfSync;
+}
+
+template<typename ForwardPolicy, unsigned int MaxFrameSize, typename FrameSink>
+uint32_t BasicUnframer<ForwardPolicy, MaxFrameSize, FrameSink>::getTruncatedFrames() const {
+    return this->truncatedFrames;
+}
+
+template<typename ForwardPolicy, unsigned int MaxFrameSize, typename FrameSink>
+void BasicUnframer<ForwardPolicy, MaxFrameSize, FrameSink>::setErrorCallback(FOnDecodeErrorFunc onError, void* onErrorContext) {
+    this->errors.setCallback(onError, onErrorContext);
+}
+
+template<typename ForwardPolicy, unsigned int MaxFrameSize, typename FrameSink>
+const DecodeErrorCounters& BasicUnframer<ForwardPolicy, MaxFrameSize, FrameSink>::getErrorCounters() const {
+    return this->errors.getCounters();
+}
+
+template<typename ForwardPolicy, unsigned int MaxFrameSize, typename FrameSink>
+void BasicUnframer<ForwardPolicy, MaxFrameSize, FrameSink>::resetErrorCounters() {
+    this->errors.resetCounters();
+}
+
+#ifdef __TIC_UNFRAMER_FORWARD_FRAME_BYTES_ON_THE_FLY__
+typedef UnframerForwardOnTheFly UnframerDefaultForwardPolicy; /*!< The mode of operation used by TIC::Unframer */
+#else
+typedef UnframerBufferWholeFrame UnframerDefaultForwardPolicy; /*!< The mode of operation used by TIC::Unframer */
+#endif
+static constexpr unsigned int UNFRAMER_DEFAULT_MAX_FRAME_SIZE = 2048; /*!< Max frame size used by TIC::Unframer */
+
+typedef BasicUnframer<UnframerDefaultForwardPolicy, UNFRAMER_DEFAULT_MAX_FRAME_SIZE> Unframer; /*!< The unframer with default settings */
+
+/* Both modes are instanciated once with the default frame size in Unframer.cpp */
+extern template class BasicUnframer<UnframerForwardOnTheFly, UNFRAMER_DEFAULT_MAX_FRAME_SIZE>;
+extern template class BasicUnframer<UnframerBufferWholeFrame, UNFRAMER_DEFAULT_MAX_FRAME_SIZE>;
+
 } // namespace TIC
+
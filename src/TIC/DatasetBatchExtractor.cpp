@@ -0,0 +1,3 @@
+#include "TIC/DatasetBatchExtractor.h"
+
+template class TIC::BasicDatasetBatchExtractor<TIC::DATASET_BATCH_DEFAULT_MAX_DATASETS_PER_FRAME>;
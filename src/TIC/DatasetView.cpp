@@ -1,6 +1,96 @@
-#include <string.h> // For memset()
+#include <string.h> // For memset(), memcpy() and memchr()
 #include "TIC/DatasetView.h"
 
+#if !defined(__TIC_MARKER_SCANNER_NO_SIMD__) && defined(__SSE2__)
+#include <emmintrin.h>
+#define __TIC_DATASET_VIEW_SSE2__
+#endif
+
+#ifdef __TIC_DATASET_VIEW_SSE2__
+/**
+ * @brief Record the first two positions found in a delimiter bitmask into @p delimPos (that may already contain positions from previous blocks)
+ *
+ * @param delimPos The positions recorded so far
+ * @param mask A bitmask of the delimiters found in a block (bit n set for the delimiter at @p blockPos + n)
+ * @param blockPos The position of the block within the dataset buffer
+ */
+static inline void recordDelimiterPositions(unsigned int* delimPos, uint32_t mask, unsigned int blockPos) {
+    if (mask == 0 || delimPos[1] != TIC::DatasetPrescan::NO_POS) /* Usual cases: no delimiter in this block, or both positions already known */
+        return;
+    if (delimPos[0] == TIC::DatasetPrescan::NO_POS) {
+        delimPos[0] = blockPos + static_cast<unsigned int>(__builtin_ctz(mask));
+        mask &= mask - 1;
+        if (mask == 0)
+            return;
+    }
+    delimPos[1] = blockPos + static_cast<unsigned int>(__builtin_ctz(mask));
+}
+
+static const uint8_t leadingBytesMasks[32] = { /* 16 bytes loaded at offset 16-n select the n first bytes of a block */
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+};
+#endif
+
+const uint8_t* TIC::DatasetPrescan::accountBytesUpTo(const uint8_t* bytes, unsigned int count, unsigned int firstPos, uint8_t endMarker1, uint8_t endMarker2) {
+    unsigned int pos = 0;
+#ifdef __TIC_DATASET_VIEW_SSE2__
+    /* Search end markers 16 bytes per iteration, and account the bytes before the first end marker from the same load (sum and delimiter bitmasks, without a branch per byte) */
+    const __m128i m1 = _mm_set1_epi8(static_cast<char>(endMarker1));
+    const __m128i m2 = _mm_set1_epi8(static_cast<char>(endMarker2));
+    const __m128i ht = _mm_set1_epi8(static_cast<char>(TIC::DatasetView::_HT));
+    const __m128i sp = _mm_set1_epi8(static_cast<char>(TIC::DatasetView::_SP));
+    const __m128i zero = _mm_setzero_si128();
+    uint32_t sum = 0;
+    const uint8_t* endMarker = nullptr;
+    for (; count - pos >= 16; pos += 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes + pos));
+        uint32_t markerMask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(chunk, m1), _mm_cmpeq_epi8(chunk, m2))));
+        uint32_t leadingMask = 0xffff;
+        if (markerMask != 0) { /* Only account the bytes before the end marker */
+            unsigned int leadingBytes = static_cast<unsigned int>(__builtin_ctz(markerMask));
+            leadingMask = (1U << leadingBytes) - 1;
+            chunk = _mm_and_si128(chunk, _mm_loadu_si128(reinterpret_cast<const __m128i*>(leadingBytesMasks + 16 - leadingBytes)));
+            endMarker = bytes + pos + leadingBytes;
+        }
+        __m128i sums = _mm_sad_epu8(chunk, zero);
+        sum += static_cast<uint32_t>(_mm_cvtsi128_si32(sums)) + static_cast<uint32_t>(_mm_cvtsi128_si32(_mm_srli_si128(sums, 8)));
+        recordDelimiterPositions(this->htPos, static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, ht))) & leadingMask, firstPos + pos);
+        recordDelimiterPositions(this->spPos, static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, sp))) & leadingMask, firstPos + pos);
+        if (endMarker) {
+            this->byteSum += static_cast<uint8_t>(sum);
+            return endMarker;
+        }
+    }
+    /* The last bytes cannot be loaded as a 16-byte block without reading past the buffer, build the same bitmasks bytewise */
+    uint32_t htMask = 0;
+    uint32_t spMask = 0;
+    unsigned int offset = 0;
+    for (; pos + offset < count; offset++) {
+        uint8_t byte = bytes[pos + offset];
+        if (byte == endMarker1 || byte == endMarker2) {
+            endMarker = bytes + pos + offset;
+            break;
+        }
+        sum += byte;
+        htMask |= static_cast<uint32_t>(byte == TIC::DatasetView::_HT) << offset;
+        spMask |= static_cast<uint32_t>(byte == TIC::DatasetView::_SP) << offset;
+    }
+    recordDelimiterPositions(this->htPos, htMask, firstPos + pos);
+    recordDelimiterPositions(this->spPos, spMask, firstPos + pos);
+    this->byteSum += static_cast<uint8_t>(sum);
+    return endMarker;
+#else
+    for (; pos < count; pos++) {
+        uint8_t byte = bytes[pos];
+        if (byte == endMarker1 || byte == endMarker2)
+            return bytes + pos;
+        this->accountByte(byte, firstPos + pos);
+    }
+    return nullptr;
+#endif
+}
+
 TIC::Horodate TIC::Horodate::fromLabelBytes(const uint8_t* bytes, unsigned int count) {
     TIC::Horodate result;
     if (count != TIC::Horodate::HORODATE_SIZE) {
@@ -194,31 +284,10 @@ std::string TIC::Horodate::toString() const {
 }
 #endif // __TIC_LIB_USE_STD_STRING__
 
-TIC::DatasetView::DatasetView(const uint8_t* datasetBuf, unsigned int datasetBufSz) :
-decodedType(TIC::DatasetView::DatasetType::Malformed),
-labelBuffer(datasetBuf),
-labelSz(datasetBufSz),
-dataBuffer(datasetBuf),
-dataSz(datasetBufSz),
-horodate() {
-    /* In a TIC frame, TIC labels follow the format:
-    [LF]<label>[Sp]123456789012[Sp][CSUM][CR]
-    Where LF is the ASCII character 0x0a (line-feed)
-    <label> is the TIC label (between 1 and 8 ascii characters)
-    Where [Sp] is a delimiter that can be 0x20 (space) or 0x09 (horizontal tab)
-    <value> is the value associated wit the label (between 1 and 12 characters)
-    <CSUM> is a one character checksum
-    Where [CR] is the ASCII character 0x0d (carriage return)
-
-    The max storage size for one dataset string (label+'\0'+value+'\'0') is thus ?
-
-    See https://lucidar.me/fr/home-automation/linky-customer-tele-information/
-    */
-    
-    bool isTicStandard = false;
-
+template<typename TicFormat>
+bool TIC::DatasetView::decodeAs(const uint8_t* datasetBuf, unsigned int datasetBufSz) {
     if (datasetBufSz < 5) { /* The minimum size for a valid dataset is 5 bytes (1 byte label + 1 delimiter + 1 byte value + 1 delimiter + 1 byte CRC) */
-        return; /* isValid is false, invalid dataset */
+        return true; /* isValid is false, invalid dataset */
     }
 
     if (*datasetBuf == 0x0A) { /* If we get a LF as first byte, assume this is the dataset start marker, and skip it*/
@@ -234,25 +303,17 @@ horodate() {
     }
 
     /* Once checksum byte has been removed, we have a delimiter just at the end */
-    uint8_t delimiter = *(datasetBuf + datasetBufSz - 1);
-    if (delimiter == TIC::DatasetView::_HT) {
-        /* Getting a HT here means this is a standard TIC dataset */
-        isTicStandard = true;
-    }
-    else if (delimiter == TIC::DatasetView::_SP) {
-        isTicStandard = false;
-    }
-    else {
-        return; /* isValid is false, invalid dataset */
+    if (*(datasetBuf + datasetBufSz - 1) != TicFormat::DELIMITER) {
+        return false; /* Not a dataset in this TIC format */
     }
 
-    if (!isTicStandard) { /* In historical TIC, the delimiter just before CRC byte is not included */
+    if (!TicFormat::IS_STANDARD) { /* In historical TIC, the delimiter just before CRC byte is not included */
         datasetBufSz--; /* Reduce the dataset buffer to exclude the last delimiter */
     }
     /* In [datasetBuf;datasetBuf+datasetBufSz[, we now have the byte sequence on which CRC applies */
     uint8_t computedCrc = this->computeCRC(datasetBuf, datasetBufSz);
 
-    if (isTicStandard) { /* In standard TIC, the delimiter just before CRC byte has been included in the CRC computation above, now remove it */
+    if (TicFormat::IS_STANDARD) { /* In standard TIC, the delimiter just before CRC byte has been included in the CRC computation above, now remove it */
         datasetBufSz--; /* Reduce the dataset buffer to exclude the last delimiter */
     }
 
@@ -266,17 +327,17 @@ horodate() {
         this->decodedType = TIC::DatasetView::DatasetType::WrongCRC;
         this->labelSz = 0;
         this->dataSz = 0;
-        return; 
+        return true;
     }
 
     /* Now, in the frame, we have a label+delim+optional(horodate+delim)+data*/
-    uint8_t* datasetDelimFound = (uint8_t*)(memchr(datasetBuf, delimiter, datasetBufSz));
+    uint8_t* datasetDelimFound = (uint8_t*)(memchr(datasetBuf, TicFormat::DELIMITER, datasetBufSz));
 
     if (datasetDelimFound == nullptr) { /* We expect at least one delimiter */
         this->decodedType = TIC::DatasetView::DatasetType::Malformed;
         this->labelSz = 0;
         this->dataSz = 0;
-        return; /* Invalid dataset */
+        return true; /* Invalid dataset */
     }
 
     {
@@ -289,7 +350,7 @@ horodate() {
             this->decodedType = TIC::DatasetView::DatasetType::Malformed;
             this->labelSz = 0;
             this->dataSz = 0;
-            return; /* Invalid dataset */
+            return true; /* Invalid dataset */
         }
 
         datasetBufSz -= trailingBytes - datasetBuf; /* Adjust the dataset buffer to skip the leading found label + delim */
@@ -297,7 +358,7 @@ horodate() {
     } // trailingBytes goes out of scope here...
 
     /* Now, in the frame, we have either a horodate+delim+data or just data */
-    datasetDelimFound = (uint8_t*)(memchr(datasetBuf, delimiter, datasetBufSz));
+    datasetDelimFound = (uint8_t*)(memchr(datasetBuf, TicFormat::DELIMITER, datasetBufSz));
 
     if (datasetDelimFound != nullptr) { /* There is another delimiter further away, so horodate is included */
         unsigned int horodateSz = datasetDelimFound - datasetBuf;
@@ -320,7 +381,270 @@ horodate() {
     this->dataSz = datasetBufSz; /* Skip the horodate found + delim */
     this->dataBuffer = datasetBuf;
 
-    this->decodedType = isTicStandard ? TIC::DatasetView::DatasetType::ValidStandard : TIC::DatasetView::DatasetType::ValidHistorical;
+    this->labelKey = TIC::labelKeyFromBuffer(this->labelBuffer, this->labelSz); /* Computed once, so that consumers can match labels with integer comparisons or a switch */
+    this->labelId = TIC::labelIdFromKey(this->labelKey);
+    this->decodedType = TicFormat::IS_STANDARD ? TIC::DatasetView::DatasetType::ValidStandard : TIC::DatasetView::DatasetType::ValidHistorical;
+    return true;
+}
+
+template<typename TicFormat>
+bool TIC::DatasetView::decodeAs(const uint8_t* datasetBuf, unsigned int datasetBufSz, const TIC::DatasetPrescan& prescan) {
+    if (datasetBufSz < 5) { /* See the minimum size in decodeAs() above */
+        return true; /* isValid is false, invalid dataset */
+    }
+
+    if (*datasetBuf == 0x0A || *(datasetBuf + datasetBufSz - 1) == 0x0D) {
+        /* Start or end markers are included in the buffer, prescan positions do not directly apply, use the scanning path */
+        return this->decodeAs<TicFormat>(datasetBuf, datasetBufSz);
+    }
+
+    uint8_t crcByte = *(datasetBuf + datasetBufSz - 1);  /* Last character of the dataset is the CRC */
+    uint8_t delimiter = *(datasetBuf + datasetBufSz - 2);
+    if (delimiter != TicFormat::DELIMITER) {
+        return false; /* Not a dataset in this TIC format */
+    }
+    uint8_t crcSum = prescan.byteSum - crcByte;
+    if (!TicFormat::IS_STANDARD) {
+        crcSum -= delimiter;    /* In historical TIC, the delimiter just before CRC byte is not included in the CRC */
+    }
+    const unsigned int* delimPos = TicFormat::IS_STANDARD ? prescan.htPos : prescan.spPos;
+    unsigned int payloadSz = datasetBufSz - 2; /* Label+delim+optional(horodate+delim)+data, without the last delimiter and CRC */
+
+    this->labelBuffer = datasetBuf;
+    this->labelSz = payloadSz;
+    this->dataBuffer = datasetBuf;
+    this->dataSz = 0;
+
+    if ((crcSum & 0x3f) + 0x20 != crcByte) {
+        this->decodedType = TIC::DatasetView::DatasetType::WrongCRC;
+        this->labelSz = 0;
+        this->dataSz = 0;
+        return true;
+    }
+
+    if (delimPos[0] >= payloadSz || delimPos[0] + 1 >= payloadSz) { /* We expect at least one delimiter, followed by at least one byte */
+        this->decodedType = TIC::DatasetView::DatasetType::Malformed;
+        this->labelSz = 0;
+        this->dataSz = 0;
+        return true; /* Invalid dataset */
+    }
+    this->labelSz = delimPos[0];
+
+    unsigned int dataStart = delimPos[0] + 1;
+    if (delimPos[1] < payloadSz) { /* There is another delimiter further away, so horodate is included */
+        this->horodate = Horodate::fromLabelBytes(datasetBuf + dataStart, delimPos[1] - dataStart);
+        dataStart = delimPos[1] + 1;
+    }
+    this->dataBuffer = datasetBuf + dataStart;
+    this->dataSz = payloadSz - dataStart;
+
+    this->labelKey = TIC::labelKeyFromBuffer(this->labelBuffer, this->labelSz); /* Computed once, so that consumers can match labels with integer comparisons or a switch */
+    this->labelId = TIC::labelIdFromKey(this->labelKey);
+    this->decodedType = TicFormat::IS_STANDARD ? TIC::DatasetView::DatasetType::ValidStandard : TIC::DatasetView::DatasetType::ValidHistorical;
+    return true;
+}
+
+TIC::DatasetView::DatasetView(const uint8_t* datasetBuf, unsigned int datasetBufSz) :
+decodedType(TIC::DatasetView::DatasetType::Malformed),
+labelBuffer(datasetBuf),
+labelSz(datasetBufSz),
+labelKey(TIC::NO_LABEL_KEY),
+labelId(TIC::LabelId::Unknown),
+dataBuffer(datasetBuf),
+dataSz(datasetBufSz),
+horodate() {
+    /* In a TIC frame, TIC labels follow the format:
+    [LF]<label>[Sp]123456789012[Sp][CSUM][CR]
+    Where LF is the ASCII character 0x0a (line-feed)
+    <label> is the TIC label (between 1 and 8 ascii characters)
+    Where [Sp] is a delimiter that can be 0x20 (space) or 0x09 (horizontal tab)
+    <value> is the value associated wit the label (between 1 and 12 characters)
+    <CSUM> is a one character checksum
+    Where [CR] is the ASCII character 0x0d (carriage return)
+
+    The max storage size for one dataset string (label+'\0'+value+'\'0') is thus ?
+
+    See https://lucidar.me/fr/home-automation/linky-customer-tele-information/
+    */
+
+    this->decode(datasetBuf, datasetBufSz);
+}
+
+void TIC::DatasetView::decode(const uint8_t* datasetBuf, unsigned int datasetBufSz) {
+    if (datasetBufSz < 5) { /* See the minimum size in decodeAs() */
+        return; /* isValid is false, invalid dataset */
+    }
+
+    /* The delimiter just before the CRC byte (and the optional CR end marker) tells the TIC format */
+    unsigned int delimiterPos = datasetBufSz - 2;
+    if (*(datasetBuf + datasetBufSz - 1) == 0x0D) {
+        delimiterPos--;
+    }
+    uint8_t delimiter = *(datasetBuf + delimiterPos);
+    if (delimiter == TIC::DatasetView::_HT) {
+        /* Getting a HT here means this is a standard TIC dataset */
+        this->decodeAs<TIC::StandardTicFormat>(datasetBuf, datasetBufSz);
+    }
+    else if (delimiter == TIC::DatasetView::_SP) {
+        this->decodeAs<TIC::HistoricalTicFormat>(datasetBuf, datasetBufSz);
+    }
+    /* Otherwise, isValid is false, invalid dataset */
+}
+
+TIC::DatasetView::DatasetView(const uint8_t* datasetBuf, unsigned int datasetBufSz, const TIC::DatasetPrescan& prescan) :
+decodedType(TIC::DatasetView::DatasetType::Malformed),
+labelBuffer(datasetBuf),
+labelSz(datasetBufSz),
+labelKey(TIC::NO_LABEL_KEY),
+labelId(TIC::LabelId::Unknown),
+dataBuffer(datasetBuf),
+dataSz(datasetBufSz),
+horodate() {
+    if (datasetBufSz < 5) { /* See the minimum size in decodeAs() */
+        return; /* isValid is false, invalid dataset */
+    }
+
+    if (*datasetBuf == 0x0A || *(datasetBuf + datasetBufSz - 1) == 0x0D) {
+        /* Start or end markers are included in the buffer, prescan positions do not directly apply, use the generic (scanning) path */
+        this->decode(datasetBuf, datasetBufSz);
+        return;
+    }
+
+    uint8_t delimiter = *(datasetBuf + datasetBufSz - 2);
+    if (delimiter == TIC::DatasetView::_HT) {
+        this->decodeAs<TIC::StandardTicFormat>(datasetBuf, datasetBufSz, prescan);
+    }
+    else if (delimiter == TIC::DatasetView::_SP) {
+        this->decodeAs<TIC::HistoricalTicFormat>(datasetBuf, datasetBufSz, prescan);
+    }
+    /* Otherwise, isValid is false, invalid dataset */
+}
+
+TIC::DatasetView::DatasetView(const uint8_t* datasetBuf, unsigned int datasetBufSz, TIC::HistoricalTicFormat) :
+decodedType(TIC::DatasetView::DatasetType::Malformed),
+labelBuffer(datasetBuf),
+labelSz(datasetBufSz),
+labelKey(TIC::NO_LABEL_KEY),
+labelId(TIC::LabelId::Unknown),
+dataBuffer(datasetBuf),
+dataSz(datasetBufSz),
+horodate() {
+    if (!this->decodeAs<TIC::HistoricalTicFormat>(datasetBuf, datasetBufSz)) {
+        this->decode(datasetBuf, datasetBufSz); /* Not a historical dataset, use the generic path */
+    }
+}
+
+TIC::DatasetView::DatasetView(const uint8_t* datasetBuf, unsigned int datasetBufSz, TIC::StandardTicFormat) :
+decodedType(TIC::DatasetView::DatasetType::Malformed),
+labelBuffer(datasetBuf),
+labelSz(datasetBufSz),
+labelKey(TIC::NO_LABEL_KEY),
+labelId(TIC::LabelId::Unknown),
+dataBuffer(datasetBuf),
+dataSz(datasetBufSz),
+horodate() {
+    if (!this->decodeAs<TIC::StandardTicFormat>(datasetBuf, datasetBufSz)) {
+        this->decode(datasetBuf, datasetBufSz); /* Not a standard dataset, use the generic path */
+    }
+}
+
+TIC::DatasetView::DatasetView(const uint8_t* datasetBuf, unsigned int datasetBufSz, const TIC::DatasetPrescan& prescan, TIC::HistoricalTicFormat) :
+decodedType(TIC::DatasetView::DatasetType::Malformed),
+labelBuffer(datasetBuf),
+labelSz(datasetBufSz),
+labelKey(TIC::NO_LABEL_KEY),
+labelId(TIC::LabelId::Unknown),
+dataBuffer(datasetBuf),
+dataSz(datasetBufSz),
+horodate() {
+    if (!this->decodeAs<TIC::HistoricalTicFormat>(datasetBuf, datasetBufSz, prescan)) {
+        this->decode(datasetBuf, datasetBufSz); /* Not a historical dataset, use the generic path (it does not need tab positions in the prescan) */
+    }
+}
+
+TIC::DatasetView::DatasetView(const uint8_t* datasetBuf, unsigned int datasetBufSz, const TIC::DatasetPrescan& prescan, TIC::StandardTicFormat) :
+decodedType(TIC::DatasetView::DatasetType::Malformed),
+labelBuffer(datasetBuf),
+labelSz(datasetBufSz),
+labelKey(TIC::NO_LABEL_KEY),
+labelId(TIC::LabelId::Unknown),
+dataBuffer(datasetBuf),
+dataSz(datasetBufSz),
+horodate() {
+    if (!this->decodeAs<TIC::StandardTicFormat>(datasetBuf, datasetBufSz, prescan)) {
+        this->decode(datasetBuf, datasetBufSz); /* Not a standard dataset, use the generic path (it does not need space positions in the prescan) */
+    }
+}
+
+TIC::DatasetView::DatasetType TIC::DatasetView::typeFromPrescan(const uint8_t* datasetBuf, unsigned int datasetBufSz, const TIC::DatasetPrescan& prescan) {
+    if (datasetBufSz < 5) { /* See the minimum size in decodeAs() */
+        return TIC::DatasetView::DatasetType::Malformed;
+    }
+    if (*datasetBuf == 0x0A || *(datasetBuf + datasetBufSz - 1) == 0x0D) {
+        /* Start or end markers are included in the buffer, prescan positions do not directly apply, use the generic (scanning) path */
+        return TIC::DatasetView(datasetBuf, datasetBufSz).decodedType;
+    }
+
+    /* Same checks as decodeAs() with a prescan, in the TIC format given by the delimiter just before the CRC byte */
+    uint8_t crcByte = *(datasetBuf + datasetBufSz - 1);
+    uint8_t delimiter = *(datasetBuf + datasetBufSz - 2);
+    const unsigned int* delimPos;
+    uint8_t crcSum = prescan.byteSum - crcByte;
+    if (delimiter == TIC::DatasetView::_HT) {
+        delimPos = prescan.htPos;
+    }
+    else if (delimiter == TIC::DatasetView::_SP) {
+        delimPos = prescan.spPos;
+        crcSum -= delimiter; /* In historical TIC, the delimiter just before CRC byte is not included in the CRC */
+    }
+    else {
+        return TIC::DatasetView::DatasetType::Malformed;
+    }
+    if ((crcSum & 0x3f) + 0x20 != crcByte) {
+        return TIC::DatasetView::DatasetType::WrongCRC;
+    }
+    unsigned int payloadSz = datasetBufSz - 2;
+    if (delimPos[0] >= payloadSz || delimPos[0] + 1 >= payloadSz) { /* We expect at least one delimiter, followed by at least one byte */
+        return TIC::DatasetView::DatasetType::Malformed;
+    }
+    return (delimiter == TIC::DatasetView::_HT) ? TIC::DatasetView::DatasetType::ValidStandard : TIC::DatasetView::DatasetType::ValidHistorical;
+}
+
+TIC::DatasetView::DatasetType TIC::DatasetView::typeOf(const uint8_t* datasetBuf, unsigned int datasetBufSz) {
+    if (datasetBufSz < 5) { /* See the minimum size in decodeAs() */
+        return TIC::DatasetView::DatasetType::Malformed;
+    }
+    if (*datasetBuf == 0x0A || *(datasetBuf + datasetBufSz - 1) == 0x0D) {
+        /* Start or end markers are included in the buffer, use the generic path that skips them */
+        return TIC::DatasetView(datasetBuf, datasetBufSz).decodedType;
+    }
+
+    /* Same checks as decodeAs(), in the TIC format given by the delimiter just before the CRC byte */
+    uint8_t crcByte = *(datasetBuf + datasetBufSz - 1);
+    uint8_t delimiter = *(datasetBuf + datasetBufSz - 2);
+    if (delimiter != TIC::DatasetView::_HT && delimiter != TIC::DatasetView::_SP) {
+        return TIC::DatasetView::DatasetType::Malformed;
+    }
+    unsigned int payloadSz = datasetBufSz - 2;
+    uint32_t sum = (delimiter == TIC::DatasetView::_HT) ? delimiter : 0; /* In standard TIC, the delimiter just before CRC byte is included in the CRC */
+    unsigned int pos = 0;
+#ifdef __TIC_DATASET_VIEW_SSE2__
+    const __m128i zero = _mm_setzero_si128();
+    for (; payloadSz - pos >= 16; pos += 16) {
+        __m128i sums = _mm_sad_epu8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(datasetBuf + pos)), zero);
+        sum += static_cast<uint32_t>(_mm_cvtsi128_si32(sums)) + static_cast<uint32_t>(_mm_cvtsi128_si32(_mm_srli_si128(sums, 8)));
+    }
+#endif
+    for (; pos < payloadSz; pos++)
+        sum += datasetBuf[pos];
+    if ((sum & 0x3f) + 0x20 != crcByte) {
+        return TIC::DatasetView::DatasetType::WrongCRC;
+    }
+    const uint8_t* labelDelimiter = static_cast<const uint8_t*>(memchr(datasetBuf, delimiter, payloadSz));
+    if (labelDelimiter == nullptr || labelDelimiter + 1 >= datasetBuf + payloadSz) { /* We expect at least one delimiter, followed by at least one byte */
+        return TIC::DatasetView::DatasetType::Malformed;
+    }
+    return (delimiter == TIC::DatasetView::_HT) ? TIC::DatasetView::DatasetType::ValidStandard : TIC::DatasetView::DatasetType::ValidHistorical;
 }
 
 bool TIC::DatasetView::isValid() const {
@@ -336,28 +660,96 @@ uint8_t TIC::DatasetView::computeCRC(const uint8_t* bytes, unsigned int count) {
     return (S1 & 0x3f) + 0x20;
 }
 
-uint32_t TIC::DatasetView::uint32FromValueBuffer(const uint8_t* buf, unsigned int cnt) {
-    uint32_t result = 0;
-    if (cnt == 0)
-        return -1;  /* No digit at all */
+/**
+ * @brief Pack 8 ASCII characters into a 64-bit word, the first character in the least significant byte (whatever the target's endianness)
+ */
+static inline uint64_t loadDigitWord(const uint8_t* buf) {
+    uint64_t word;
+    memcpy(&word, buf, sizeof(word)); /* Unaligned-safe load */
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    word = __builtin_bswap64(word);
+#endif
+    return word;
+}
 
-    for (unsigned int idx = 0; idx < cnt; idx++) {
-        uint8_t digit = buf[idx];
-        if (digit < '0' || digit > '9') {   /* Invalid decimal value */
-            return -1;
-        }
-        if (result > ((uint32_t)-1 / 10)) { /* Failsafe: multiplication by 10 would overflow uint32_t */
-            return -1;
+/**
+ * @brief Check that the 8 bytes of a word are all ASCII decimal digits
+ */
+static inline bool isEightDigitWord(uint64_t word) {
+    /* The high nibble of each byte must be 3, and adding 6 to each byte must not carry into the high nibble (so the low nibble is at most 9) */
+    return (((word & 0xF0F0F0F0F0F0F0F0ULL) | (((word + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4)) == 0x3333333333333333ULL);
+}
+
+/**
+ * @brief Convert a word made of 8 ASCII decimal digits (the most significant digit in the least significant byte) to its value
+ */
+static inline uint32_t eightDigitWordValue(uint64_t word) {
+    word -= 0x3030303030303030ULL; /* Now 8 digit values (0 to 9) */
+    word = (word * 10) + (word >> 8); /* Even bytes now hold 2-digit values (0 to 99) */
+    /* Combine the four 2-digit values, multiplying them by their weights (10^6, 10^4, 10^2, 1) into the upper 32 bits */
+    word = (((word & 0x000000FF000000FFULL) * (100 + (1000000ULL << 32))) + (((word >> 16) & 0x000000FF000000FFULL) * (1 + (10000ULL << 32)))) >> 32;
+    return static_cast<uint32_t>(word);
+}
+
+/**
+ * @brief Convert a decimal value buffer (see TIC::DatasetView::uint64FromValueBuffer()), inlined in all public conversion functions
+ */
+static inline uint64_t decimalValueFromBuffer(const uint8_t* buf, unsigned int cnt, bool& ok) {
+    ok = false;
+    if (cnt == 0)
+        return 0;  /* No digit at all */
+
+    uint64_t result = 0;
+    if (cnt < 8) { /* Short values (the most usual ones) cannot fill a word, but cannot overflow either: convert them digit by digit */
+        for (unsigned int idx = 0; idx < cnt; idx++) {
+            unsigned int digit = static_cast<unsigned int>(buf[idx]) - '0';
+            if (digit > 9)
+                return 0;   /* Invalid decimal value */
+            result = result * 10 + digit;
         }
-        result *= 10;
-        if (result > (uint32_t)-1 - (digit - '0')) {    /* Failsafe: addition of unit would overflow uint32_t */
-            return -1;
+        ok = true;
+        return result;
+    }
+
+    /* Start with the leading (cnt%8) digits, left-padded with '0' digits to make a full word, so that all following words are complete */
+    unsigned int headSz = cnt % 8;
+    if (headSz != 0) {
+        uint64_t word = 0x3030303030303030ULL >> (8 * headSz); /* '0' padding in the first (8-headSz) digits */
+        word |= loadDigitWord(buf) << (8 * (8 - headSz)); /* Only keep the first headSz bytes of the first 8 bytes */
+        if (!isEightDigitWord(word))
+            return 0;   /* Invalid decimal value */
+        result = eightDigitWordValue(word);
+        buf += headSz;
+        cnt -= headSz;
+    }
+    for (; cnt > 0; buf += 8, cnt -= 8) {
+        uint64_t word = loadDigitWord(buf);
+        if (!isEightDigitWord(word))
+            return 0;   /* Invalid decimal value */
+        uint32_t wordValue = eightDigitWordValue(word);
+        if (result >= 100000000000ULL) { /* Below 10^11, result*10^8+wordValue is always below 2^64, there is no need for the exact (slower) overflow check */
+            if (result > ((uint64_t)-1 - wordValue) / 100000000ULL)
+                return 0;   /* Would overflow uint64_t */
         }
-        result += (digit - '0');    /* Take this digit into account */
+        result = result * 100000000ULL + wordValue;
     }
+    ok = true;
     return result;
 }
 
+uint64_t TIC::DatasetView::uint64FromValueBuffer(const uint8_t* buf, unsigned int cnt, bool& ok) {
+    return decimalValueFromBuffer(buf, cnt, ok);
+}
+
+uint32_t TIC::DatasetView::uint32FromValueBuffer(const uint8_t* buf, unsigned int cnt) {
+    bool ok;
+    uint64_t result = decimalValueFromBuffer(buf, cnt, ok);
+    if (!ok || result > (uint32_t)-1)
+        return -1;
+    return static_cast<uint32_t>(result);
+}
+
+
 bool TIC::DatasetView::labelEquals(const char* cString) const {
     if (cString == nullptr)
         return false;
@@ -371,4 +763,21 @@ uint32_t TIC::DatasetView::dataToUint32() const {
     if (!this->isValid() || this->dataBuffer == nullptr)
         return -1;
     return TIC::DatasetView::uint32FromValueBuffer(this->dataBuffer, this->dataSz);
+}
+
+uint32_t TIC::DatasetView::dataToUint32(bool& ok) const {
+    uint64_t result = this->dataToUint64(ok);
+    if (!ok || result > (uint32_t)-1) {
+        ok = false;
+        return 0;
+    }
+    return static_cast<uint32_t>(result);
+}
+
+uint64_t TIC::DatasetView::dataToUint64(bool& ok) const {
+    if (!this->isValid() || this->dataBuffer == nullptr) {
+        ok = false;
+        return 0;
+    }
+    return decimalValueFromBuffer(this->dataBuffer, this->dataSz, ok);
 }
\ No newline at end of file
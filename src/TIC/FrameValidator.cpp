@@ -0,0 +1,116 @@
+#include "TIC/FrameValidator.h"
+#include "TIC/MarkerScanner.h"
+
+#if !defined(__TIC_MARKER_SCANNER_NO_SIMD__) && defined(__SSE2__)
+#include <emmintrin.h>
+#define __TIC_FRAME_VALIDATOR_SSE2__
+#endif
+
+namespace {
+constexpr uint8_t LF = 0x0a; /*!< Dataset start marker (line feed) */
+constexpr uint8_t CR = 0x0d; /*!< Dataset end marker (carriage return) */
+constexpr uint8_t HT = 0x09; /*!< Horizontal tab, the delimiter inside standard TIC datasets */
+constexpr uint8_t SP = 0x20; /*!< Space, the delimiter inside historical TIC datasets */
+
+/**
+ * @brief Sum the bytes of a dataset up to (but excluding) the first CR or LF
+ *
+ * @param bytes The first byte of the dataset
+ * @param end The end of the frame (bytes are never read at or beyond this pointer)
+ * @param[out] sum The sum (modulo 256) of the bytes before the marker found
+ * @return A pointer to the first CR or LF, or nullptr if there is none before @p end (@p sum is then undefined)
+ */
+inline const uint8_t* sumBytesUpToMarker(const uint8_t* bytes, const uint8_t* end, uint8_t& sum) {
+    uint32_t total = 0;
+#ifdef __TIC_FRAME_VALIDATOR_SSE2__
+    /* Search the markers 16 bytes per iteration, and sum the same load with psadbw (bytes after the marker are masked out before summing) */
+    const __m128i cr = _mm_set1_epi8(static_cast<char>(CR));
+    const __m128i lf = _mm_set1_epi8(static_cast<char>(LF));
+    const __m128i byteIndexes = _mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    const __m128i zero = _mm_setzero_si128();
+    __m128i sums = zero;
+    for (; end - bytes >= 16; bytes += 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes));
+        uint32_t markerMask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(chunk, cr), _mm_cmpeq_epi8(chunk, lf))));
+        if (markerMask != 0) {
+            int leadingBytes = __builtin_ctz(markerMask);
+            chunk = _mm_and_si128(chunk, _mm_cmplt_epi8(byteIndexes, _mm_set1_epi8(static_cast<char>(leadingBytes))));
+            sums = _mm_add_epi64(sums, _mm_sad_epu8(chunk, zero));
+            total = static_cast<uint32_t>(_mm_cvtsi128_si32(sums)) + static_cast<uint32_t>(_mm_cvtsi128_si32(_mm_srli_si128(sums, 8)));
+            sum = static_cast<uint8_t>(total);
+            return bytes + leadingBytes;
+        }
+        sums = _mm_add_epi64(sums, _mm_sad_epu8(chunk, zero));
+    }
+    /* The last bytes of the frame cannot be loaded as a 16-byte block without reading past the frame */
+    total = static_cast<uint32_t>(_mm_cvtsi128_si32(sums)) + static_cast<uint32_t>(_mm_cvtsi128_si32(_mm_srli_si128(sums, 8)));
+#endif
+    for (; bytes < end; bytes++) {
+        uint8_t byte = *bytes;
+        if (byte == CR || byte == LF) {
+            sum = static_cast<uint8_t>(total);
+            return bytes;
+        }
+        total += byte;
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Check the checksum of a dataset, given the sum of all its bytes
+ *
+ * @param dataset The dataset bytes (excluding start and end markers)
+ * @param length The number of bytes in @p dataset
+ * @param byteSum The sum (modulo 256) of all @p length bytes of @p dataset
+ * @return true if the checksum byte is correct
+ */
+inline bool hasValidChecksum(const uint8_t* dataset, unsigned int length, uint8_t byteSum) {
+    if (length < 5) /* The minimum size for a valid dataset, see TIC::DatasetView */
+        return false;
+    uint8_t crcByte = dataset[length - 1];
+    uint8_t delimiter = dataset[length - 2];
+    uint8_t checkedSum = static_cast<uint8_t>(byteSum - crcByte);
+    if (delimiter == SP) /* In historical TIC, the delimiter just before the CRC byte is not included */
+        checkedSum = static_cast<uint8_t>(checkedSum - SP);
+    else if (delimiter != HT) /* Neither a standard nor a historical dataset */
+        return false;
+    return crcByte == (checkedSum & 0x3f) + 0x20;
+}
+} // namespace
+
+unsigned int TIC::validateFrame(const uint8_t* frame, unsigned int frameSize, TIC::DatasetSpan* spans, uint32_t* validBitmap, unsigned int maxDatasets) {
+    if (frameSize > TIC::FRAME_VALIDATOR_MAX_FRAME_SIZE)
+        frameSize = TIC::FRAME_VALIDATOR_MAX_FRAME_SIZE; /* Offsets beyond would not fit in a DatasetSpan */
+    for (unsigned int word = 0; word < (maxDatasets + 31) / 32; word++)
+        validBitmap[word] = 0;
+
+    const uint8_t* frameEnd = frame + frameSize;
+    const uint8_t* pos = frame;
+    unsigned int spanCount = 0;
+    while (spanCount < maxDatasets && pos < frameEnd) {
+        const uint8_t* startMarker = pos;
+        if (*pos != LF) { /* Usual case: the start marker immediately follows the end marker of the previous dataset */
+            startMarker = TIC::MarkerScanner::find(pos, static_cast<unsigned int>(frameEnd - pos), LF);
+            if (startMarker == nullptr)
+                break;
+        }
+        const uint8_t* dataset = startMarker + 1;
+        uint8_t byteSum = 0;
+        const uint8_t* endMarker = sumBytesUpToMarker(dataset, frameEnd, byteSum);
+        if (endMarker == nullptr) /* Unterminated dataset at the end of the frame */
+            break;
+        /* A LF end marker may also be the start marker of the next dataset, unless it is directly followed by another LF (datasets terminated by LF instead of CR) */
+        pos = endMarker + 1;
+        if (*endMarker == LF && (pos == frameEnd || *pos != LF))
+            pos = endMarker;
+        unsigned int length = static_cast<unsigned int>(endMarker - dataset);
+        if (length == 0) /* Duplicated start marker */
+            continue;
+        spans[spanCount].offset = static_cast<uint16_t>(dataset - frame);
+        spans[spanCount].length = static_cast<uint16_t>(length);
+        if (hasValidChecksum(dataset, length, byteSum))
+            validBitmap[spanCount / 32] |= 1U << (spanCount % 32);
+        spanCount++;
+    }
+    return spanCount;
+}
@@ -0,0 +1,89 @@
+#include "TIC/LabelId.h"
+
+namespace {
+/**
+ * @brief The known labels, indexed by their TIC::LabelId (index 0 is TIC::LabelId::Unknown)
+ */
+constexpr const char* KNOWN_LABEL_NAMES[] = {
+    "",
+#define TIC_LABEL_NAME(id, label) label,
+    TIC_KNOWN_LABELS(TIC_LABEL_NAME)
+#undef TIC_LABEL_NAME
+};
+constexpr unsigned int KNOWN_LABEL_COUNT = sizeof(KNOWN_LABEL_NAMES) / sizeof(KNOWN_LABEL_NAMES[0]); /* Including TIC::LabelId::Unknown */
+
+/* Perfect hash: the key of a label is multiplied by LABEL_SLOT_MULTIPLIER, and the top LABEL_SLOT_BITS bits select a slot.
+   The multiplier has been searched so that no two known labels share a slot (this is checked below at compile time) */
+constexpr unsigned int LABEL_SLOT_BITS = 9;
+constexpr unsigned int LABEL_SLOT_COUNT = 1U << LABEL_SLOT_BITS;
+constexpr uint64_t LABEL_SLOT_MULTIPLIER = 0xed7124bb7312ace9ULL;
+
+constexpr unsigned int slotOfKey(uint64_t key) {
+    return static_cast<unsigned int>((key * LABEL_SLOT_MULTIPLIER) >> (64 - LABEL_SLOT_BITS));
+}
+
+/**
+ * @brief Get the index of the known label that hashes to @p slot (0 if none), at compile time
+ */
+constexpr uint8_t labelIndexAtSlot(unsigned int slot, unsigned int index = KNOWN_LABEL_COUNT - 1) {
+    return (index == 0) ? 0 : ((slotOfKey(TIC::labelKey(KNOWN_LABEL_NAMES[index])) == slot) ? static_cast<uint8_t>(index) : labelIndexAtSlot(slot, index - 1));
+}
+
+constexpr bool isPerfectHash(unsigned int index = KNOWN_LABEL_COUNT - 1) {
+    return (index == 0) || (labelIndexAtSlot(slotOfKey(TIC::labelKey(KNOWN_LABEL_NAMES[index]))) == index && isPerfectHash(index - 1));
+}
+
+constexpr bool allLabelsHaveKeys(unsigned int index = KNOWN_LABEL_COUNT - 1) {
+    return (index == 0) || (TIC::labelKey(KNOWN_LABEL_NAMES[index]) != TIC::NO_LABEL_KEY && allLabelsHaveKeys(index - 1));
+}
+
+static_assert(KNOWN_LABEL_COUNT <= 256, "Label identifiers must fit in a uint8_t");
+static_assert(allLabelsHaveKeys(), "All known labels must fit in a label key");
+static_assert(isPerfectHash(), "Two known labels share a slot, LABEL_SLOT_MULTIPLIER must be searched again");
+
+template<unsigned int... Slots>
+struct SlotSequence { };
+
+template<unsigned int N, unsigned int... Slots>
+struct MakeSlotSequence : MakeSlotSequence<N - 1, N - 1, Slots...> { };
+
+template<unsigned int... Slots>
+struct MakeSlotSequence<0, Slots...> {
+    typedef SlotSequence<Slots...> type;
+};
+
+/**
+ * @brief The lookup tables of known labels, built at compile time
+ */
+struct KnownLabelTables {
+    uint8_t slotIndexes[LABEL_SLOT_COUNT]; /*!< The index of the known label hashing to each slot (0 if none) */
+    uint64_t keys[KNOWN_LABEL_COUNT]; /*!< The key of each known label (NO_LABEL_KEY for index 0) */
+};
+
+template<unsigned int... Slots, unsigned int... Indexes>
+constexpr KnownLabelTables buildKnownLabelTables(SlotSequence<Slots...>, SlotSequence<Indexes...>) {
+    return KnownLabelTables{
+        { labelIndexAtSlot(Slots)... },
+        { TIC::labelKey(KNOWN_LABEL_NAMES[Indexes])... },
+    };
+}
+
+constexpr KnownLabelTables KNOWN_LABEL_TABLES = buildKnownLabelTables(MakeSlotSequence<LABEL_SLOT_COUNT>::type(), MakeSlotSequence<KNOWN_LABEL_COUNT>::type());
+} // namespace
+
+TIC::LabelId TIC::labelIdFromBuffer(const uint8_t* label, unsigned int labelSz) {
+    return TIC::labelIdFromKey(TIC::labelKeyFromBuffer(label, labelSz));
+}
+
+TIC::LabelId TIC::labelIdFromKey(uint64_t key) {
+    /* Only one known label can hash to this slot, check that it is really this one (NO_LABEL_KEY never matches a known label) */
+    uint8_t index = KNOWN_LABEL_TABLES.slotIndexes[slotOfKey(key)];
+    if (KNOWN_LABEL_TABLES.keys[index] != key)
+        return TIC::LabelId::Unknown;
+    return static_cast<TIC::LabelId>(index);
+}
+
+const char* TIC::labelName(TIC::LabelId id) {
+    unsigned int index = static_cast<unsigned int>(id);
+    return (index < KNOWN_LABEL_COUNT) ? KNOWN_LABEL_NAMES[index] : "";
+}
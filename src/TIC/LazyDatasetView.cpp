@@ -0,0 +1,135 @@
+#include <string.h> // For memchr() and memcmp()
+#include "TIC/LazyDatasetView.h"
+
+TIC::LazyDatasetView::LazyDatasetView(const uint8_t* datasetBuf, unsigned int datasetBufSz) :
+decodedType(TIC::DatasetView::DatasetType::Malformed),
+labelBuffer(datasetBuf),
+labelSz(0),
+labelKey(TIC::NO_LABEL_KEY),
+labelId(TIC::LabelId::Unknown),
+valueFieldsBuffer(datasetBuf),
+valueFieldsSz(0),
+delimiter(0),
+valueFieldsSplit(false),
+horodateParsed(false),
+horodateBuffer(datasetBuf),
+horodateSz(0),
+dataBuffer(datasetBuf),
+dataSz(0),
+horodate() {
+    if (datasetBufSz < 5) { /* See the minimum size in DatasetView::decodeAs() */
+        return; /* isValid is false, invalid dataset */
+    }
+
+    if (*datasetBuf == 0x0A) { /* Skip the dataset start marker, if any */
+        datasetBuf++;
+        datasetBufSz--;
+    }
+    uint8_t crcByte = datasetBuf[--datasetBufSz]; /* Last character of the dataset is the CRC */
+    if (crcByte == 0x0D) { /* Skip the dataset end marker, if any, and use the previous byte instead as CRC */
+        crcByte = datasetBuf[--datasetBufSz];
+    }
+    uint8_t lastDelimiter = datasetBuf[--datasetBufSz];
+    if (lastDelimiter != TIC::DatasetView::_HT && lastDelimiter != TIC::DatasetView::_SP) {
+        return; /* Neither a standard nor a historical dataset */
+    }
+    /* In [datasetBuf;datasetBuf+datasetBufSz[, we now have the label+delim+optional(horodate+delim)+data, without the last delimiter */
+
+    uint8_t crcSum = (lastDelimiter == TIC::DatasetView::_HT) ? lastDelimiter : 0; /* In standard TIC, the delimiter just before CRC byte is included in the CRC */
+    for (unsigned int pos = 0; pos < datasetBufSz; pos++)
+        crcSum += datasetBuf[pos];
+    if ((crcSum & 0x3f) + 0x20 != crcByte) {
+        this->decodedType = TIC::DatasetView::DatasetType::WrongCRC;
+        return;
+    }
+
+    const uint8_t* labelDelimiter = static_cast<const uint8_t*>(memchr(datasetBuf, lastDelimiter, datasetBufSz));
+    if (labelDelimiter == nullptr || labelDelimiter + 1 >= datasetBuf + datasetBufSz) { /* We expect at least one delimiter, followed by at least one byte */
+        return; /* Invalid dataset */
+    }
+    this->labelBuffer = datasetBuf;
+    this->labelSz = labelDelimiter - datasetBuf;
+    this->valueFieldsBuffer = labelDelimiter + 1;
+    this->valueFieldsSz = datasetBufSz - this->labelSz - 1;
+    this->delimiter = lastDelimiter;
+
+    this->labelKey = TIC::labelKeyFromBuffer(this->labelBuffer, this->labelSz);
+    this->labelId = TIC::labelIdFromKey(this->labelKey);
+    this->decodedType = (lastDelimiter == TIC::DatasetView::_HT) ? TIC::DatasetView::DatasetType::ValidStandard : TIC::DatasetView::DatasetType::ValidHistorical;
+}
+
+void TIC::LazyDatasetView::splitValueFields() const {
+    if (this->valueFieldsSplit)
+        return;
+    this->valueFieldsSplit = true;
+    this->dataBuffer = this->valueFieldsBuffer;
+    this->dataSz = this->valueFieldsSz;
+    if (!this->isValid())
+        return; /* No value fields */
+
+    const uint8_t* horodateDelimiter = static_cast<const uint8_t*>(memchr(this->valueFieldsBuffer, this->delimiter, this->valueFieldsSz));
+    if (horodateDelimiter != nullptr) { /* There is another delimiter further away, so horodate is included */
+        this->horodateBuffer = this->valueFieldsBuffer;
+        this->horodateSz = horodateDelimiter - this->valueFieldsBuffer;
+        this->dataBuffer = horodateDelimiter + 1;
+        this->dataSz = this->valueFieldsSz - this->horodateSz - 1;
+    }
+}
+
+bool TIC::LazyDatasetView::isValid() const {
+    return (this->decodedType == TIC::DatasetView::DatasetType::ValidHistorical || this->decodedType == TIC::DatasetView::DatasetType::ValidStandard);
+}
+
+bool TIC::LazyDatasetView::labelEquals(const char* cString) const {
+    if (cString == nullptr)
+        return false;
+    if (!this->isValid())
+        return false;
+    size_t cStringLen = strlen(cString);
+    return (this->labelSz == cStringLen && memcmp(this->labelBuffer, cString, cStringLen) == 0);
+}
+
+const uint8_t* TIC::LazyDatasetView::getDataBuffer() const {
+    this->splitValueFields();
+    return this->dataBuffer;
+}
+
+unsigned int TIC::LazyDatasetView::getDataSz() const {
+    this->splitValueFields();
+    return this->dataSz;
+}
+
+const TIC::Horodate& TIC::LazyDatasetView::getHorodate() const {
+    if (!this->horodateParsed) {
+        this->splitValueFields();
+        this->horodateParsed = true;
+        if (this->horodateSz != 0) /* Otherwise, this->horodate has been constructed by default, and is thus invalid (there is no horodate) */
+            this->horodate = TIC::Horodate::fromLabelBytes(this->horodateBuffer, this->horodateSz);
+    }
+    return this->horodate;
+}
+
+uint32_t TIC::LazyDatasetView::dataToUint32() const {
+    if (!this->isValid())
+        return -1;
+    this->splitValueFields();
+    return TIC::DatasetView::uint32FromValueBuffer(this->dataBuffer, this->dataSz);
+}
+
+uint32_t TIC::LazyDatasetView::dataToUint32(bool& ok) const {
+    uint64_t result = this->dataToUint64(ok);
+    if (!ok || result > (uint32_t)-1) {
+        ok = false;
+        return 0;
+    }
+    return static_cast<uint32_t>(result);
+}
+
+uint64_t TIC::LazyDatasetView::dataToUint64(bool& ok) const {
+    if (!this->isValid()) {
+        ok = false;
+        return 0;
+    }
+    this->splitValueFields();
+    return TIC::DatasetView::uint64FromValueBuffer(this->dataBuffer, this->dataSz, ok);
+}
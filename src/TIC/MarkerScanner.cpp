@@ -0,0 +1,85 @@
+#include <string.h> // For memcpy()
+#include "TIC/MarkerScanner.h"
+
+#ifndef __TIC_MARKER_SCANNER_NO_SIMD__
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define __TIC_MARKER_SCANNER_AVX2__
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define __TIC_MARKER_SCANNER_SSE2__
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define __TIC_MARKER_SCANNER_NEON__
+#endif
+#endif
+
+/**
+ * @brief Bytewise search of the first of two markers, used on buffer tails that are too short for a wide compare
+ */
+static inline const uint8_t* findFirstOfBytewise(const uint8_t* buffer, const uint8_t* end, uint8_t marker1, uint8_t marker2) {
+    for (; buffer < end; buffer++) {
+        if (*buffer == marker1 || *buffer == marker2)
+            return buffer;
+    }
+    return nullptr;
+}
+
+#if !defined(__TIC_MARKER_SCANNER_AVX2__) && !defined(__TIC_MARKER_SCANNER_SSE2__) && !defined(__TIC_MARKER_SCANNER_NEON__)
+/**
+ * @brief Compute a mask with bit 7 of each byte set if the corresponding byte in @p word is equal to 0
+ *
+ * @note Bytes located above (in memory order on little-endian targets) a real zero byte can produce false positives, so the mask can only be trusted to be non-zero when at least one byte is zero
+ */
+static inline uint64_t swarZeroByteMask(uint64_t word) {
+    return (word - 0x0101010101010101ULL) & ~word & 0x8080808080808080ULL;
+}
+#endif
+
+const uint8_t* TIC::MarkerScanner::findFirstOf(const uint8_t* buffer, unsigned int len, uint8_t marker1, uint8_t marker2) {
+    const uint8_t* end = buffer + len;
+#if defined(__TIC_MARKER_SCANNER_AVX2__)
+    const __m256i m1 = _mm256_set1_epi8(static_cast<char>(marker1));
+    const __m256i m2 = _mm256_set1_epi8(static_cast<char>(marker2));
+    for (; end - buffer >= 32; buffer += 32) {
+        __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(buffer));
+        __m256i hits = _mm256_or_si256(_mm256_cmpeq_epi8(chunk, m1), _mm256_cmpeq_epi8(chunk, m2));
+        unsigned int mask = static_cast<unsigned int>(_mm256_movemask_epi8(hits));
+        if (mask != 0)
+            return buffer + __builtin_ctz(mask);
+    }
+#elif defined(__TIC_MARKER_SCANNER_SSE2__)
+    const __m128i m1 = _mm_set1_epi8(static_cast<char>(marker1));
+    const __m128i m2 = _mm_set1_epi8(static_cast<char>(marker2));
+    for (; end - buffer >= 16; buffer += 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(buffer));
+        __m128i hits = _mm_or_si128(_mm_cmpeq_epi8(chunk, m1), _mm_cmpeq_epi8(chunk, m2));
+        unsigned int mask = static_cast<unsigned int>(_mm_movemask_epi8(hits));
+        if (mask != 0)
+            return buffer + __builtin_ctz(mask);
+    }
+#elif defined(__TIC_MARKER_SCANNER_NEON__)
+    const uint8x16_t m1 = vdupq_n_u8(marker1);
+    const uint8x16_t m2 = vdupq_n_u8(marker2);
+    for (; end - buffer >= 16; buffer += 16) {
+        uint8x16_t chunk = vld1q_u8(buffer);
+        uint8x16_t hits = vorrq_u8(vceqq_u8(chunk, m1), vceqq_u8(chunk, m2));
+        /* Narrow each 16-bit lane by 4 bits, this gives a 64-bit mask containing one nibble per input byte */
+        uint64_t mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(hits), 4)), 0);
+        if (mask != 0)
+            return buffer + (__builtin_ctzll(mask) >> 2);
+    }
+#else
+    const uint64_t m1 = 0x0101010101010101ULL * marker1;
+    const uint64_t m2 = 0x0101010101010101ULL * marker2;
+    for (; end - buffer >= 8; buffer += 8) {
+        uint64_t word;
+        memcpy(&word, buffer, sizeof(word)); /* Unaligned-safe load */
+        if ((swarZeroByteMask(word ^ m1) | swarZeroByteMask(word ^ m2)) != 0) {
+            /* At least one marker is within these 8 bytes, locate it exactly (independently of the target's endianness) */
+            return findFirstOfBytewise(buffer, buffer + 8, marker1, marker2);
+        }
+    }
+#endif
+    return findFirstOfBytewise(buffer, end, marker1, marker2);
+}
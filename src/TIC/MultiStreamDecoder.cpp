@@ -0,0 +1,210 @@
+#ifndef ARDUINO /* Threads are only available on hosted platforms */
+#include <deque>
+#include "TIC/MultiStreamDecoder.h"
+#include "TIC/StreamDecoder.h"
+
+/**
+ * @brief Sink forwarding datasets decoded on one stream to the TIC::MultiStreamDecoder callback, along with the stream identifier
+ */
+struct MultiStreamDatasetSink {
+    TIC::MultiStreamDecoder::FOnStreamDatasetFunc onDatasetDecoded;
+    void* onDatasetDecodedContext;
+    unsigned int streamId;
+
+    void operator()(const TIC::DatasetView& dataset) {
+        if (this->onDatasetDecoded)
+            this->onDatasetDecoded(this->streamId, dataset, this->onDatasetDecodedContext);
+    }
+};
+
+struct TIC::MultiStreamDecoder::StreamState {
+    StreamState(const MultiStreamDatasetSink& sink) :
+    lock(),
+    pending(),
+    processing(),
+    scheduled(false),
+    decoder(sink) { }
+
+    std::mutex lock; /*!< Protects pending and scheduled */
+    std::vector<uint8_t> pending; /*!< Bytes submitted and not yet decoded, in submission order */
+    std::vector<uint8_t> processing; /*!< Bytes being decoded (only accessed by the worker running this stream's task) */
+    bool scheduled; /*!< Is this stream queued or being decoded? */
+    TIC::BasicStreamDecoder<MultiStreamDatasetSink> decoder; /*!< The decoder state for this stream */
+};
+
+struct TIC::MultiStreamDecoder::Worker {
+    Worker() :
+    lock(),
+    tasks(),
+    thread() { }
+
+    std::mutex lock; /*!< Protects tasks */
+    std::deque<unsigned int> tasks; /*!< Streams to decode. New submissions are pushed at the back, re-queued streams at the front. The owner pops at the back, thieves steal at the front */
+    std::thread thread; /*!< The worker thread */
+};
+
+TIC::MultiStreamDecoder::MultiStreamDecoder(unsigned int streamCount, unsigned int workerCount, FOnStreamDatasetFunc onDatasetDecoded, void* onDatasetDecodedContext) :
+onDatasetDecoded(onDatasetDecoded),
+onDatasetDecodedContext(onDatasetDecodedContext),
+streams(),
+workers(),
+nextSubmitWorker(0),
+queuedTasks(0),
+sleepingWorkers(0),
+busyStreams(0),
+stolenTasks(0),
+stopping(false),
+sleepLock(),
+wakeWorkers(),
+flushed() {
+    if (workerCount == 0) {
+        workerCount = std::thread::hardware_concurrency();
+        if (workerCount == 0)
+            workerCount = 1;
+    }
+    this->streams.reserve(streamCount);
+    for (unsigned int streamId = 0; streamId < streamCount; streamId++) {
+        this->streams.emplace_back(new StreamState(MultiStreamDatasetSink{onDatasetDecoded, onDatasetDecodedContext, streamId}));
+    }
+    this->workers.reserve(workerCount);
+    for (unsigned int workerIndex = 0; workerIndex < workerCount; workerIndex++) {
+        this->workers.emplace_back(new Worker());
+    }
+    /* Start threads only once all queues exist, as workers may look at each other's queue */
+    for (unsigned int workerIndex = 0; workerIndex < workerCount; workerIndex++) {
+        this->workers[workerIndex]->thread = std::thread(&TIC::MultiStreamDecoder::workerLoop, this, workerIndex);
+    }
+}
+
+TIC::MultiStreamDecoder::~MultiStreamDecoder() {
+    this->flush();
+    {
+        std::lock_guard<std::mutex> guard(this->sleepLock);
+        this->stopping = true;
+    }
+    this->wakeWorkers.notify_all();
+    for (auto& worker : this->workers) {
+        worker->thread.join();
+    }
+}
+
+bool TIC::MultiStreamDecoder::pushBytes(unsigned int streamId, const uint8_t* buffer, unsigned int len) {
+    if (streamId >= this->streams.size())
+        return false;
+    StreamState& stream = *(this->streams[streamId]);
+    bool needsScheduling;
+    {
+        std::lock_guard<std::mutex> guard(stream.lock);
+        stream.pending.insert(stream.pending.end(), buffer, buffer + len);
+        needsScheduling = !stream.scheduled; /* If the stream is already queued or being decoded, the running task will pick these bytes */
+        stream.scheduled = true;
+    }
+    if (needsScheduling) {
+        this->busyStreams++;
+        this->schedule(streamId, this->nextSubmitWorker++ % this->workers.size(), false);
+    }
+    return true;
+}
+
+void TIC::MultiStreamDecoder::schedule(unsigned int streamId, unsigned int workerIndex, bool requeue) {
+    Worker& worker = *(this->workers[workerIndex]);
+    /* Count the task before it becomes visible in the queue, so that a worker taking it never decrements queuedTasks below zero (a worker seeing the count before the task will just retry) */
+    this->queuedTasks++;
+    {
+        std::lock_guard<std::mutex> guard(worker.lock);
+        if (requeue)
+            worker.tasks.push_front(streamId); /* Behind all tasks already queued for the owner, and first to be stolen */
+        else
+            worker.tasks.push_back(streamId);
+    }
+    /* Only take sleepLock when a worker is actually sleeping.
+       Workers increment sleepingWorkers before checking queuedTasks, and we incremented queuedTasks before reading sleepingWorkers (both sequentially consistent), so either the worker sees our task, or we see the worker and notify it under sleepLock, which it holds until it waits */
+    if (this->sleepingWorkers > 0) {
+        std::lock_guard<std::mutex> sleepGuard(this->sleepLock);
+        this->wakeWorkers.notify_one();
+    }
+}
+
+bool TIC::MultiStreamDecoder::takeTask(unsigned int workerIndex, unsigned int& streamId) {
+    { /* Own queue first, most recent submission first (its stream state is the most likely to still be in cache), re-queued streams are at the other end */
+        Worker& worker = *(this->workers[workerIndex]);
+        std::lock_guard<std::mutex> guard(worker.lock);
+        if (!worker.tasks.empty()) {
+            streamId = worker.tasks.back();
+            worker.tasks.pop_back();
+            this->queuedTasks--;
+            return true;
+        }
+    }
+    /* Then steal the oldest task from another worker, starting with our neighbour to spread thieves over victims */
+    for (unsigned int offset = 1; offset < this->workers.size(); offset++) {
+        Worker& victim = *(this->workers[(workerIndex + offset) % this->workers.size()]);
+        std::lock_guard<std::mutex> guard(victim.lock);
+        if (!victim.tasks.empty()) {
+            streamId = victim.tasks.front();
+            victim.tasks.pop_front();
+            this->queuedTasks--;
+            this->stolenTasks++;
+            return true;
+        }
+    }
+    return false;
+}
+
+void TIC::MultiStreamDecoder::runTask(unsigned int workerIndex, unsigned int streamId) {
+    StreamState& stream = *(this->streams[streamId]);
+    {
+        std::lock_guard<std::mutex> guard(stream.lock);
+        stream.processing.swap(stream.pending); /* Keep the capacity of both buffers, to avoid reallocations on the next batches */
+    }
+    stream.decoder.pushBytes(stream.processing.data(), static_cast<unsigned int>(stream.processing.size()));
+    stream.processing.clear();
+
+    bool moreBytes;
+    {
+        std::lock_guard<std::mutex> guard(stream.lock);
+        moreBytes = !stream.pending.empty();
+        stream.scheduled = moreBytes;
+    }
+    if (moreBytes) {
+        this->schedule(streamId, workerIndex, true); /* Bytes arrived while decoding, queue the stream again, behind the other queued streams so that they are not starved */
+    }
+    else if (--this->busyStreams == 0) {
+        std::lock_guard<std::mutex> guard(this->sleepLock);
+        this->flushed.notify_all();
+    }
+}
+
+void TIC::MultiStreamDecoder::workerLoop(unsigned int workerIndex) {
+    while (true) {
+        unsigned int streamId;
+        if (this->takeTask(workerIndex, streamId)) {
+            this->runTask(workerIndex, streamId);
+            continue;
+        }
+        std::unique_lock<std::mutex> guard(this->sleepLock);
+        this->sleepingWorkers++; /* Before checking queuedTasks, see schedule() */
+        this->wakeWorkers.wait(guard, [this]() { return this->queuedTasks > 0 || this->stopping; });
+        this->sleepingWorkers--;
+        if (this->stopping && this->queuedTasks == 0)
+            return;
+    }
+}
+
+void TIC::MultiStreamDecoder::flush() {
+    std::unique_lock<std::mutex> guard(this->sleepLock);
+    this->flushed.wait(guard, [this]() { return this->busyStreams == 0; });
+}
+
+unsigned int TIC::MultiStreamDecoder::getStreamCount() const {
+    return static_cast<unsigned int>(this->streams.size());
+}
+
+unsigned int TIC::MultiStreamDecoder::getWorkerCount() const {
+    return static_cast<unsigned int>(this->workers.size());
+}
+
+uint64_t TIC::MultiStreamDecoder::getStolenTaskCount() const {
+    return this->stolenTasks;
+}
+#endif // ARDUINO
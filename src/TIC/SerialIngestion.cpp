@@ -0,0 +1,153 @@
+#ifdef __linux__ /* epoll is Linux-specific */
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h> // For memset()
+#include <sys/epoll.h>
+#include <termios.h>
+#include <unistd.h>
+#include "TIC/SerialIngestion.h"
+
+TIC::SerialIngestion::SerialIngestion(unsigned int readBufferSize) :
+epollFd(epoll_create1(EPOLL_CLOEXEC)),
+readBuffer(readBufferSize > 0 ? readBufferSize : 1),
+sources(),
+openSources(0),
+epollWaitCount(0),
+readCount(0) {
+}
+
+TIC::SerialIngestion::~SerialIngestion() {
+    if (this->epollFd >= 0)
+        close(this->epollFd);
+}
+
+bool TIC::SerialIngestion::isValid() const {
+    return this->epollFd >= 0;
+}
+
+int TIC::SerialIngestion::openSerial(const char* path, Mode mode) {
+    int fd = open(path, O_RDONLY | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
+    if (fd < 0)
+        return -1;
+    if (!TIC::SerialIngestion::configureSerial(fd, mode)) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+bool TIC::SerialIngestion::configureSerial(int fd, Mode mode) {
+    struct termios tio;
+    if (tcgetattr(fd, &tio) != 0)
+        return false;
+    cfmakeraw(&tio); /* No echo, no line editing, and especially no CR/LF translation, as CR and LF are TIC dataset markers */
+    tio.c_cflag &= ~(CSIZE | CSTOPB | PARODD | CRTSCTS);
+    tio.c_cflag |= CS7 | PARENB | CREAD | CLOCAL; /* 7 data bits, even parity, 1 stop bit, no modem control */
+    tio.c_iflag &= ~(IXON | IXOFF | IXANY);
+    tio.c_cc[VMIN] = 0; /* Reads are non-blocking anyway, epoll tells us when bytes are available */
+    tio.c_cc[VTIME] = 0;
+    speed_t speed = (mode == Mode::Standard) ? B9600 : B1200;
+    if (cfsetispeed(&tio, speed) != 0 || cfsetospeed(&tio, speed) != 0)
+        return false;
+    return tcsetattr(fd, TCSANOW, &tio) == 0;
+}
+
+int TIC::SerialIngestion::addFd(int fd, FOnNewBytesFunc onNewBytes, void* onNewBytesContext) {
+    if (this->epollFd < 0 || fd < 0)
+        return -1;
+    int flags = fcntl(fd, F_GETFL);
+    if (flags < 0 || fcntl(fd, F_SETFL, flags | O_NONBLOCK) != 0)
+        return -1;
+
+    unsigned int index = static_cast<unsigned int>(this->sources.size());
+    struct epoll_event event;
+    memset(&event, 0, sizeof(event));
+    event.events = EPOLLIN; /* Level-triggered: a short read means we have drained the descriptor, without an extra read() returning EAGAIN */
+    event.data.u32 = index;
+    if (epoll_ctl(this->epollFd, EPOLL_CTL_ADD, fd, &event) != 0)
+        return -1;
+
+    Source source;
+    memset(&source, 0, sizeof(source));
+    source.fd = fd;
+    source.onNewBytes = onNewBytes;
+    source.onNewBytesContext = onNewBytesContext;
+    this->sources.push_back(source);
+    this->openSources++;
+    return static_cast<int>(index);
+}
+
+unsigned int TIC::SerialIngestion::drain(Source& source) {
+    unsigned int forwarded = 0;
+    while (true) {
+        ssize_t result = read(source.fd, this->readBuffer.data(), this->readBuffer.size());
+        this->readCount++;
+        source.stats.readCalls++;
+        if (result > 0) {
+            unsigned int readSize = static_cast<unsigned int>(result);
+            source.stats.bytesRead += readSize;
+            if (readSize > source.stats.maxReadSize)
+                source.stats.maxReadSize = readSize;
+            unsigned int bucket = 31 - static_cast<unsigned int>(__builtin_clz(readSize)); /* floor(log2(readSize)) */
+            if (bucket >= READ_SIZE_BUCKETS)
+                bucket = READ_SIZE_BUCKETS - 1;
+            source.stats.readSizeHistogram[bucket]++;
+            if (source.onNewBytes)
+                source.onNewBytes(this->readBuffer.data(), readSize, source.onNewBytesContext);
+            forwarded += readSize;
+            if (readSize < this->readBuffer.size())
+                break; /* Short read, nothing more is available for now */
+            continue; /* The buffer was filled, more bytes may be waiting */
+        }
+        if (result < 0 && errno == EINTR)
+            continue;
+        if (result < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            source.stats.emptyReads++;
+            break;
+        }
+        /* End of file, or read error (a pty returns EIO once its other side is closed) */
+        epoll_ctl(this->epollFd, EPOLL_CTL_DEL, source.fd, nullptr);
+        source.stats.closed = true;
+        this->openSources--;
+        break;
+    }
+    return forwarded;
+}
+
+int TIC::SerialIngestion::poll(int timeoutMs) {
+    if (this->epollFd < 0 || this->openSources == 0)
+        return -1;
+    struct epoll_event events[32];
+    int readyCount;
+    do {
+        readyCount = epoll_wait(this->epollFd, events, sizeof(events) / sizeof(events[0]), timeoutMs);
+        this->epollWaitCount++;
+    } while (readyCount < 0 && errno == EINTR);
+    if (readyCount < 0)
+        return -1;
+
+    unsigned int forwarded = 0;
+    for (int eventIndex = 0; eventIndex < readyCount; eventIndex++) {
+        Source& source = this->sources[events[eventIndex].data.u32];
+        if (!source.stats.closed)
+            forwarded += this->drain(source);
+    }
+    return static_cast<int>(forwarded);
+}
+
+unsigned int TIC::SerialIngestion::getFdCount() const {
+    return static_cast<unsigned int>(this->sources.size());
+}
+
+const TIC::SerialIngestion::FdStatistics& TIC::SerialIngestion::getStatistics(unsigned int index) const {
+    return this->sources[index].stats;
+}
+
+uint64_t TIC::SerialIngestion::getEpollWaitCount() const {
+    return this->epollWaitCount;
+}
+
+uint64_t TIC::SerialIngestion::getReadCount() const {
+    return this->readCount;
+}
+#endif // __linux__
@@ -0,0 +1,99 @@
+#include "TIC/StreamDecoder.h"
+
+#if !defined(__TIC_MARKER_SCANNER_NO_SIMD__) && defined(__SSE2__)
+#include <emmintrin.h>
+#define __TIC_STREAM_DECODER_SSE2__
+#endif
+
+/**
+ * @brief Is @p byte one of the markers that terminate the accumulation of dataset bytes (CR, LF, STX or ETX)
+ */
+static inline bool isDatasetTerminator(uint8_t byte) {
+    return (byte == TIC::StreamDecoderBase::CR || byte == TIC::StreamDecoderBase::LF || byte == TIC::StreamDecoderBase::STX || byte == TIC::StreamDecoderBase::ETX);
+}
+
+/**
+ * @brief Is @p byte a delimiter that should be located in the prescan, when the TIC mode @p Mode is locked
+ */
+template<TIC::StreamDecoderBase::TicMode Mode>
+static inline bool isModeDelimiter(uint8_t byte) {
+    if (Mode == TIC::StreamDecoderBase::TicMode::Historical)
+        return (byte == TIC::HistoricalTicFormat::DELIMITER);
+    if (Mode == TIC::StreamDecoderBase::TicMode::Standard)
+        return (byte == TIC::StandardTicFormat::DELIMITER);
+    return (byte == TIC::HistoricalTicFormat::DELIMITER || byte == TIC::StandardTicFormat::DELIMITER);
+}
+
+template<TIC::StreamDecoderBase::TicMode Mode>
+unsigned int TIC::StreamDecoderBase::accumulateDatasetBytes(const uint8_t* buffer, unsigned int len, uint8_t* dataset, unsigned int& datasetLen, TIC::DatasetPrescan& prescan) {
+    unsigned int pos = 0;
+    unsigned int nextWrite = datasetLen;
+#ifdef __TIC_STREAM_DECODER_SSE2__
+    /* Process 16 bytes per iteration: the block is stored, its bytes up to the first marker are summed, and the few delimiters it contains are located from a bitmask */
+    static const uint8_t prefixMasks[32] = { 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+                                             0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }; /* Loading 16 bytes at prefixMasks+16-k keeps only the first k bytes */
+    const __m128i cr = _mm_set1_epi8(static_cast<char>(CR));
+    const __m128i lf = _mm_set1_epi8(static_cast<char>(LF));
+    const __m128i stx = _mm_set1_epi8(static_cast<char>(STX));
+    const __m128i etx = _mm_set1_epi8(static_cast<char>(ETX));
+    const __m128i ht = _mm_set1_epi8(static_cast<char>(DatasetView::_HT));
+    const __m128i sp = _mm_set1_epi8(static_cast<char>(DatasetView::_SP));
+    const __m128i zero = _mm_setzero_si128();
+    uint32_t sum = 0;
+    while (len - pos >= 16 && nextWrite + 16 <= MAX_DATASET_SIZE) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(buffer + pos));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dataset + nextWrite), chunk); /* Bytes following a marker are not part of the dataset, they will be overwritten or ignored */
+        __m128i markers = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, cr), _mm_cmpeq_epi8(chunk, lf)),
+                                       _mm_or_si128(_mm_cmpeq_epi8(chunk, stx), _mm_cmpeq_epi8(chunk, etx)));
+        unsigned int markerMask = static_cast<unsigned int>(_mm_movemask_epi8(markers));
+        unsigned int datasetBytes = 16;
+        if (markerMask != 0) {
+            datasetBytes = static_cast<unsigned int>(__builtin_ctz(markerMask));
+            chunk = _mm_and_si128(chunk, _mm_loadu_si128(reinterpret_cast<const __m128i*>(prefixMasks + 16 - datasetBytes)));
+        }
+        __m128i sums = _mm_sad_epu8(chunk, zero);
+        sum += static_cast<uint32_t>(_mm_cvtsi128_si32(sums)) + static_cast<uint32_t>(_mm_cvtsi128_si32(_mm_srli_si128(sums, 8)));
+        /* Bytes masked out above are zeroed, so they cannot be mistaken for delimiters */
+        __m128i delimiters;
+        if (Mode == TicMode::Historical)
+            delimiters = _mm_cmpeq_epi8(chunk, sp);
+        else if (Mode == TicMode::Standard)
+            delimiters = _mm_cmpeq_epi8(chunk, ht);
+        else
+            delimiters = _mm_or_si128(_mm_cmpeq_epi8(chunk, ht), _mm_cmpeq_epi8(chunk, sp));
+        unsigned int delimiterMask = static_cast<unsigned int>(_mm_movemask_epi8(delimiters));
+        while (delimiterMask != 0) {
+            unsigned int offset = static_cast<unsigned int>(__builtin_ctz(delimiterMask));
+            prescan.accountDelimiter(buffer[pos + offset], nextWrite + offset);
+            delimiterMask &= delimiterMask - 1;
+        }
+        pos += datasetBytes;
+        nextWrite += datasetBytes;
+        if (markerMask != 0)
+            break;
+    }
+    prescan.byteSum += static_cast<uint8_t>(sum);
+#endif
+    /* Bytewise processing (tail of the buffer, end of the storage, or no SIMD) */
+    for (; pos < len; pos++) {
+        uint8_t byte = buffer[pos];
+        if (byte <= DatasetView::_SP && isDatasetTerminator(byte))
+            break;
+        if (nextWrite < MAX_DATASET_SIZE) { /* Bytes beyond MAX_DATASET_SIZE are dropped */
+            dataset[nextWrite] = byte;
+            prescan.byteSum += byte;
+            if (isModeDelimiter<Mode>(byte))
+                prescan.accountDelimiter(byte, nextWrite);
+            nextWrite++;
+        }
+    }
+    datasetLen = nextWrite;
+    return pos;
+}
+
+/* Only the code paths for these TIC modes exist */
+template unsigned int TIC::StreamDecoderBase::accumulateDatasetBytes<TIC::StreamDecoderBase::TicMode::Unknown>(const uint8_t* buffer, unsigned int len, uint8_t* dataset, unsigned int& datasetLen, TIC::DatasetPrescan& prescan);
+template unsigned int TIC::StreamDecoderBase::accumulateDatasetBytes<TIC::StreamDecoderBase::TicMode::Historical>(const uint8_t* buffer, unsigned int len, uint8_t* dataset, unsigned int& datasetLen, TIC::DatasetPrescan& prescan);
+template unsigned int TIC::StreamDecoderBase::accumulateDatasetBytes<TIC::StreamDecoderBase::TicMode::Standard>(const uint8_t* buffer, unsigned int len, uint8_t* dataset, unsigned int& datasetLen, TIC::DatasetPrescan& prescan);
+
+template class TIC::BasicStreamDecoder<TIC::StreamDecoderCallbackSink>;
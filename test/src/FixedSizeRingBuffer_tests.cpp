@@ -0,0 +1,57 @@
+#include "TestHarness.h"
+#include <stdint.h>
+
+#include "TIC/FixedSizeRingBuffer.h"
+
+TEST_GROUP(FixedSizeRingBuffer_tests) {
+};
+
+TEST(FixedSizeRingBuffer_tests, FixedSizeRingBuffer_empty) {
+	TIC::FixedSizeRingBuffer<unsigned int, 4> rb;
+	if (rb.getCount() != 0 || rb.isFull()) {
+		FAILF("Unexpected non-empty ring buffer (count=%u)", rb.getCount());
+	}
+}
+
+TEST(FixedSizeRingBuffer_tests, FixedSizeRingBuffer_partial_fill) {
+	TIC::FixedSizeRingBuffer<unsigned int, 4> rb;
+	rb.push(10);
+	rb.push(11);
+	if (rb.getCount() != 2 || rb.isFull()) {
+		FAILF("Unexpected count %u", rb.getCount());
+	}
+	if (rb.at(0) != 10 || rb.at(1) != 11 || rb.oldest() != 10 || rb.newest() != 11) {
+		FAILF("Unexpected content: %u %u", rb.at(0), rb.at(1));
+	}
+}
+
+TEST(FixedSizeRingBuffer_tests, FixedSizeRingBuffer_wraparound) {
+	TIC::FixedSizeRingBuffer<unsigned int, 4> rb;
+	for (unsigned int value = 0; value < 11; value++) {
+		rb.push(value);
+	}
+	if (rb.getCount() != 4 || !rb.isFull()) {
+		FAILF("Unexpected count %u", rb.getCount());
+	}
+	for (unsigned int idx = 0; idx < 4; idx++) {
+		if (rb.at(idx) != 7 + idx) {
+			FAILF("Unexpected value %u at index %u", rb.at(idx), idx);
+		}
+	}
+	rb.clear();
+	if (rb.getCount() != 0) {
+		FAILF("Unexpected count %u after clear()", rb.getCount());
+	}
+	rb.push(42);
+	if (rb.oldest() != 42 || rb.newest() != 42) {
+		FAILF("Unexpected content after clear()");
+	}
+}
+
+#ifndef USE_CPPUTEST
+void runFixedSizeRingBufferAllUnitTests() {
+	FixedSizeRingBuffer_empty();
+	FixedSizeRingBuffer_partial_fill();
+	FixedSizeRingBuffer_wraparound();
+}
+#endif	// USE_CPPUTEST
@@ -0,0 +1,136 @@
+#include "TestHarness.h"
+#include <vector>
+#include <stdint.h>
+#include <string>
+
+#include "Tools.h"
+#include "TIC/DatasetBatchExtractor.h"
+#include "TIC/DatasetExtractor.h"
+#include "TIC/Unframer.h"
+
+TEST_GROUP(TicDatasetBatchExtractor_tests) {
+};
+
+/**
+ * @brief Datasets received per frame, and whether all spans were located inside their frame buffer
+ */
+struct FrameDatasetsRecorder {
+	FrameDatasetsRecorder() : datasets(), frameCount(0), spansInsideFrame(true) { }
+
+	std::vector<std::vector<uint8_t> > datasets;
+	unsigned int frameCount;
+	bool spansInsideFrame;
+};
+
+static void recordFrameDatasets(const uint8_t* frame, unsigned int frameSize, const TIC::DatasetSpan* spans, unsigned int spanCount, void* context) {
+	FrameDatasetsRecorder* recorder = static_cast<FrameDatasetsRecorder*>(context);
+	recorder->frameCount++;
+	for (unsigned int idx = 0; idx < spanCount; idx++) {
+		if (spans[idx].offset + spans[idx].length > frameSize) {
+			recorder->spansInsideFrame = false;
+			continue;
+		}
+		recorder->datasets.push_back(std::vector<uint8_t>(frame + spans[idx].offset, frame + spans[idx].offset + spans[idx].length));
+	}
+}
+
+static void appendDataset(const uint8_t* buf, unsigned int cnt, void* context) {
+	static_cast<std::vector<std::vector<uint8_t> >*>(context)->push_back(std::vector<uint8_t>(buf, buf + cnt));
+}
+
+static void datasetExtractorPushBytes(const uint8_t* buf, unsigned int cnt, void* context) {
+	static_cast<TIC::DatasetExtractor*>(context)->pushBytes(buf, cnt);
+}
+
+static void datasetExtractorReset(void* context) {
+	static_cast<TIC::DatasetExtractor*>(context)->reset();
+}
+
+TEST(TicDatasetBatchExtractor_tests, Samples_same_datasets_as_DatasetExtractor) {
+	const char* samples[] = {
+		"./samples/continuous_linky_1P_standard_TIC_sample.bin",
+		"./samples/continuous_linky_3P_historical_TIC_sample.bin",
+		"./samples/continuous_linky_3P_historical_TIC_with_rx_errors.bin",
+		"./samples/linky_1P_midnight.bin",
+	};
+	typedef TIC::UnframerDatasetBatchSink<TIC::DatasetBatchExtractor> BatchFrameSink;
+	for (const char* sample : samples) {
+		std::vector<uint8_t> ticData = readVectorFromDisk(sample);
+
+		std::vector<std::vector<uint8_t> > expectedDatasets;
+		TIC::DatasetExtractor de(appendDataset, &expectedDatasets);
+		TIC::BasicUnframer<TIC::UnframerBufferWholeFrame, TIC::UNFRAMER_DEFAULT_MAX_FRAME_SIZE> tu(datasetExtractorPushBytes, datasetExtractorReset, &de);
+		tu.pushBytes(&(ticData[0]), ticData.size());
+		unsigned int expectedFrameCount = tu.getFramesSeen();
+
+		for (unsigned int chunkSize : { 1u, 64u, static_cast<unsigned int>(ticData.size()) }) {
+			FrameDatasetsRecorder recorder;
+			TIC::DatasetBatchExtractor batchExtractor(recordFrameDatasets, &recorder);
+			TIC::BasicUnframer<TIC::UnframerBufferWholeFrame, TIC::UNFRAMER_DEFAULT_MAX_FRAME_SIZE, BatchFrameSink> batchUnframer{BatchFrameSink(batchExtractor)};
+			for (unsigned int pos = 0; pos < ticData.size(); pos += chunkSize) {
+				unsigned int len = ticData.size() - pos;
+				if (len > chunkSize)
+					len = chunkSize;
+				batchUnframer.pushBytes(&(ticData[pos]), len);
+			}
+			if (!recorder.spansInsideFrame) {
+				FAILF("%s, %u-byte chunks: spans outside of their frame buffer", sample, chunkSize);
+			}
+			if (recorder.frameCount != expectedFrameCount) {
+				FAILF("%s, %u-byte chunks: %u frames delivered, expected %u", sample, chunkSize, recorder.frameCount, expectedFrameCount);
+			}
+			if (expectedDatasets.empty() || recorder.datasets != expectedDatasets) {
+				FAILF("%s, %u-byte chunks: got %zu datasets, expected %zu", sample, chunkSize, recorder.datasets.size(), expectedDatasets.size());
+			}
+			if (batchExtractor.getDroppedDatasets() != 0) {
+				FAILF("%s, %u-byte chunks: %u datasets dropped", sample, chunkSize, batchExtractor.getDroppedDatasets());
+			}
+		}
+	}
+}
+
+TEST(TicDatasetBatchExtractor_tests, Too_many_datasets_in_frame) {
+	const uint8_t LF = TIC::DatasetExtractor::START_MARKER;
+	const uint8_t CR = TIC::DatasetExtractor::END_MARKER_TIC_1;
+	uint8_t frame[] = { LF, 'a', CR, LF, 'b', 'c', CR, LF, 'd', CR, LF, 'e' };
+	FrameDatasetsRecorder recorder;
+	TIC::BasicDatasetBatchExtractor<2> batchExtractor(recordFrameDatasets, &recorder);
+	if (batchExtractor.pushFrame(frame, sizeof(frame)) != 2) {
+		FAILF("Expected only 2 datasets listed");
+	}
+	if (recorder.frameCount != 1 || recorder.datasets != std::vector<std::vector<uint8_t> >({ {'a'}, {'b', 'c'} })) {
+		FAILF("Wrong datasets delivered: %zu", recorder.datasets.size());
+	}
+	if (batchExtractor.getDroppedDatasets() != 1) { /* 'd' is dropped, 'e' is unterminated */
+		FAILF("Wrong dropped datasets: %u", batchExtractor.getDroppedDatasets());
+	}
+	uint8_t emptyFrame[] = { 'x' };
+	if (batchExtractor.pushFrame(emptyFrame, sizeof(emptyFrame)) != 0 || recorder.frameCount != 2) {
+		FAILF("A frame without any dataset should still be delivered, with no span");
+	}
+}
+
+TEST(TicDatasetBatchExtractor_tests, Compile_time_batch_sink) {
+	const uint8_t LF = TIC::DatasetExtractor::START_MARKER;
+	const uint8_t CR = TIC::DatasetExtractor::END_MARKER_TIC_1;
+	uint8_t frame[] = { LF, 'a', 'b', CR, LF, 'c', CR };
+	unsigned int totalLength = 0;
+	auto onFrameDatasets = [&totalLength](const uint8_t* frame, unsigned int frameSize, const TIC::DatasetSpan* spans, unsigned int spanCount) {
+		for (unsigned int idx = 0; idx < spanCount; idx++) {
+			totalLength += spans[idx].length;
+		}
+	};
+	TIC::BasicDatasetBatchExtractor<8, decltype(onFrameDatasets)> batchExtractor(onFrameDatasets);
+	batchExtractor.pushFrame(frame, sizeof(frame));
+	if (totalLength != 3) {
+		FAILF("Wrong total dataset length: %u", totalLength);
+	}
+}
+
+#ifndef USE_CPPUTEST
+void runTicDatasetBatchExtractorAllUnitTests() {
+	Samples_same_datasets_as_DatasetExtractor();
+	Too_many_datasets_in_frame();
+	Compile_time_batch_sink();
+}
+#endif	// USE_CPPUTEST
@@ -5,11 +5,13 @@
 #include <stdint.h>
 #include <string>
 #include <iterator>
+#include <utility>
 #include <cstring>
 #include <iomanip>
 
 #include "Tools.h"
 #include "TIC/DatasetExtractor.h"
+#include "TIC/DatasetView.h"
 #include "TIC/Unframer.h"
 
 TEST_GROUP(TicDatasetExtractor_tests) {
@@ -396,6 +398,87 @@ TEST(TicDatasetExtractor_tests, Chunked_sample_unframe_dsextract_standard_TIC) {
 	}
 }
 
+TEST(TicDatasetExtractor_tests, Large_buffer_single_push_same_as_bytewise) {
+	std::vector<uint8_t> sample = readVectorFromDisk("./samples/continuous_linky_1P_standard_TIC_sample.bin");
+	std::vector<uint8_t> ticData;
+	for (unsigned int repeat = 0; repeat < 200; repeat++) {	/* Thousands of frames in one buffer */
+		ticData.insert(ticData.end(), sample.begin(), sample.end());
+	}
+
+	DatasetDecoderStub stubSinglePush;
+	TIC::DatasetExtractor deSinglePush(datasetDecoderStubUnwrapInvoke, &stubSinglePush);
+	TIC::Unframer tuSinglePush(datasetExtractorUnwrapForwardFrameBytes, datasetExtractorUnWrapFrameFinished, &deSinglePush);
+	unsigned int usedBytes = tuSinglePush.pushBytes(&(ticData[0]), ticData.size());
+	if (usedBytes != ticData.size()) {
+		FAILF("Unexpected used bytes count: %u, expected %zu", usedBytes, ticData.size());
+	}
+
+	DatasetDecoderStub stubBytewise;
+	TIC::DatasetExtractor deBytewise(datasetDecoderStubUnwrapInvoke, &stubBytewise);
+	TIC::Unframer tuBytewise(datasetExtractorUnwrapForwardFrameBytes, datasetExtractorUnWrapFrameFinished, &deBytewise);
+	TicUnframer_test_file_sent_by_chunks(ticData, 1, tuBytewise);
+
+	if (stubSinglePush.decodedDatasetList.size() < 200 * 11 * 40) { /* At least 11 full frames of 40 datasets in each sample repetition */
+		FAILF("Wrong dataset count: %zu", stubSinglePush.decodedDatasetList.size());
+	}
+	if (stubSinglePush.decodedDatasetList != stubBytewise.decodedDatasetList) {
+		FAILF("Datasets extracted from a single push differ from datasets extracted bytewise");
+	}
+}
+
+/**
+ * @brief Decode a capture using the function pointer API, cutting it into chunks
+ */
+static std::vector<std::vector<uint8_t> > decodeWithCallbacks(const std::vector<uint8_t>& ticData, unsigned int chunkSize) {
+	DatasetDecoderStub stub;
+	TIC::DatasetExtractor de(datasetDecoderStubUnwrapInvoke, &stub);
+	TIC::Unframer tu(datasetExtractorUnwrapForwardFrameBytes, datasetExtractorUnWrapFrameFinished, &de);
+	TicUnframer_test_file_sent_by_chunks(ticData, chunkSize, tu);
+	return stub.decodedDatasetList;
+}
+
+TEST(TicDatasetExtractor_tests, Chunked_sample_compile_time_sinks_same_as_callbacks) {
+	const char* samples[] = { "./samples/continuous_linky_3P_historical_TIC_sample.bin", "./samples/continuous_linky_1P_standard_TIC_sample.bin" };
+
+	for (const char* sample : samples) {
+		std::vector<uint8_t> ticData = readVectorFromDisk(sample);
+		for (unsigned int chunkSize = 1; chunkSize <= 1024; chunkSize *= 4) {
+			std::vector<std::vector<uint8_t> > datasets;
+			auto onDataset = [&datasets](const uint8_t* buf, unsigned int cnt) {
+				datasets.push_back(std::vector<uint8_t>(buf, buf+cnt));
+			};
+			typedef TIC::BasicDatasetExtractor<TIC::DatasetExtractorTruncateAndDeliver, TIC::DATASET_EXTRACTOR_DEFAULT_MAX_DATASET_SIZE, decltype(onDataset)> LambdaDatasetExtractor;
+			typedef TIC::UnframerDatasetExtractorSink<LambdaDatasetExtractor> FrameSink;
+			LambdaDatasetExtractor de(onDataset);
+			TIC::BasicUnframer<TIC::UnframerForwardOnTheFly, TIC::UNFRAMER_DEFAULT_MAX_FRAME_SIZE, FrameSink> tu{FrameSink(de)};
+
+			for (unsigned int bytesRead = 0; bytesRead < ticData.size(); bytesRead += chunkSize) {
+				unsigned int nbBytesToRead = ticData.size() - bytesRead;
+				if (nbBytesToRead > chunkSize) {
+					nbBytesToRead = chunkSize;
+				}
+				tu.pushBytes(&(ticData[bytesRead]), nbBytesToRead);
+			}
+			if (datasets.empty() || datasets != decodeWithCallbacks(ticData, chunkSize)) {
+				FAILF("When using chunk size %u on %s: datasets differ between compile-time sinks and callbacks (%zu datasets)", chunkSize, sample, datasets.size());
+			}
+		}
+	}
+}
+
+TEST(TicDatasetExtractor_tests, Unframer_callable_sink) {
+	uint8_t buffer[] = { TIC::Unframer::START_MARKER, 'a', 'b', TIC::Unframer::END_MARKER, TIC::Unframer::START_MARKER, 'c', TIC::Unframer::END_MARKER };
+	unsigned int bytesCount = 0;
+	unsigned int framesCount = 0;
+	auto sink = TIC::makeUnframerSink([&bytesCount](const uint8_t* buf, unsigned int cnt) { bytesCount += cnt; },
+	                                  [&framesCount]() { framesCount++; });
+	TIC::BasicUnframer<TIC::UnframerBufferWholeFrame, 16, decltype(sink)> tu(sink);
+	tu.pushBytes(buffer, sizeof(buffer));
+	if (bytesCount != 3 || framesCount != 2) {
+		FAILF("Unexpected callable sink invokations: %u bytes, %u frames", bytesCount, framesCount);
+	}
+}
+
 TEST(TicDatasetExtractor_tests, Sample_unframe_dsextract_historical_TIC_with_rx_errors) {
 	std::vector<uint8_t> ticData = readVectorFromDisk("./samples/continuous_linky_3P_historical_TIC_with_rx_errors.bin");
 
@@ -429,6 +512,747 @@ TEST(TicDatasetExtractor_tests, Sample_unframe_dsextract_historical_TIC_with_rx_
 	// }
 }
 
+/**
+ * @brief Stub decoding the datasets it receives, and feeding their type back to the extractor, so that it tracks the TIC mode
+ */
+class ModeTrackingDecoderStub : public DatasetDecoderStub {
+public:
+	ModeTrackingDecoderStub() : de(nullptr) { }
+	ModeTrackingDecoderStub(const ModeTrackingDecoderStub&) = delete;
+	ModeTrackingDecoderStub& operator=(const ModeTrackingDecoderStub&) = delete;
+
+	TIC::DatasetExtractor* de;
+};
+
+static void modeTrackingDecoderStubUnwrapInvoke(const uint8_t* buf, unsigned int cnt, void* context) {
+	ModeTrackingDecoderStub* stub = static_cast<ModeTrackingDecoderStub*>(context);
+	stub->onDatasetExtractedCallback(buf, cnt);
+	stub->de->accountDataset(TIC::DatasetView(buf, cnt).decodedType);
+}
+
+TEST(TicDatasetExtractor_tests, Mode_detection_and_end_marker_policy) {
+	const std::string standardDataset("\nADSC\t064468368739\tM\r");
+	const std::string standardDatasetWrongCRC("\nADSC\t064468368739\tN\r");
+	const std::string historicalDataset("\nADCO 012345678901 E\r");
+	uint8_t datasetWithLf[] = { TIC::DatasetExtractor::START_MARKER, 'a', TIC::DatasetExtractor::LF, 'b', TIC::DatasetExtractor::END_MARKER_TIC_1 };
+
+	DatasetDecoderStub rawStub;
+	TIC::DatasetExtractor rawDe(datasetDecoderStubUnwrapInvoke, &rawStub);
+	for (unsigned int idx = 0; idx < TIC::TicModeDetector::LOCK_AFTER_VALID_DATASETS; idx++) {
+		rawDe.pushBytes(reinterpret_cast<const uint8_t*>(standardDataset.data()), standardDataset.size());
+	}
+	if (rawDe.getMode() != TIC::DatasetExtractor::TicMode::Unknown || rawStub.decodedDatasetList.size() != TIC::TicModeDetector::LOCK_AFTER_VALID_DATASETS) {
+		FAILF("Datasets delivered to a raw sink should not be checked by the extractor");
+	}
+
+	ModeTrackingDecoderStub standardStub;
+	TIC::DatasetExtractor standardDe(modeTrackingDecoderStubUnwrapInvoke, &standardStub);
+	standardStub.de = &standardDe;
+	if (standardDe.getMode() != TIC::DatasetExtractor::TicMode::Unknown) {
+		FAILF("Mode should be unknown before any dataset is received");
+	}
+	for (unsigned int idx = 0; idx < TIC::TicModeDetector::LOCK_AFTER_VALID_DATASETS - 1; idx++) {
+		standardDe.pushBytes(reinterpret_cast<const uint8_t*>(standardDatasetWrongCRC.data()), standardDatasetWrongCRC.size());
+		standardDe.pushBytes(reinterpret_cast<const uint8_t*>(standardDataset.data()), standardDataset.size());
+	}
+	if (standardDe.getMode() != TIC::DatasetExtractor::TicMode::Unknown) {
+		FAILF("Mode should only be locked after %u datasets with a correct checksum", TIC::TicModeDetector::LOCK_AFTER_VALID_DATASETS);
+	}
+	standardDe.pushBytes(reinterpret_cast<const uint8_t*>(standardDataset.data()), 3); /* Dataset spanning two calls */
+	standardDe.pushBytes(reinterpret_cast<const uint8_t*>(standardDataset.data()) + 3, standardDataset.size() - 3);
+	if (standardDe.getMode() != TIC::DatasetExtractor::TicMode::Standard) {
+		FAILF("Standard TIC should have been detected");
+	}
+	standardDe.reset();
+	if (standardDe.getMode() != TIC::DatasetExtractor::TicMode::Standard) {
+		FAILF("Mode should be kept across reset()");
+	}
+	standardStub.decodedDatasetList.clear();
+	standardDe.pushBytes(datasetWithLf, sizeof(datasetWithLf));
+	if (standardStub.decodedDatasetList.size() != 1 || standardStub.decodedDatasetList[0] != std::vector<uint8_t>({'a', TIC::DatasetExtractor::LF, 'b'})) {
+		FAILF("In standard TIC, only CR should end a dataset:\n%s", standardStub.toString().c_str());
+	}
+
+	ModeTrackingDecoderStub historicalStub;
+	TIC::DatasetExtractor historicalDe(modeTrackingDecoderStubUnwrapInvoke, &historicalStub);
+	historicalStub.de = &historicalDe;
+	for (unsigned int idx = 0; idx < TIC::TicModeDetector::LOCK_AFTER_VALID_DATASETS; idx++) {
+		historicalDe.pushBytes(reinterpret_cast<const uint8_t*>(historicalDataset.data()), historicalDataset.size());
+	}
+	if (historicalDe.getMode() != TIC::DatasetExtractor::TicMode::Historical) {
+		FAILF("Historical TIC should have been detected");
+	}
+	historicalStub.decodedDatasetList.clear();
+	historicalDe.pushBytes(datasetWithLf, sizeof(datasetWithLf));
+	if (historicalStub.decodedDatasetList.size() != 2 || historicalStub.decodedDatasetList[0] != std::vector<uint8_t>({'a'}) || historicalStub.decodedDatasetList[1] != std::vector<uint8_t>({'b'})) {
+		FAILF("In historical TIC, the first CR or LF should end a dataset, and a LF should start the next one:\n%s", historicalStub.toString().c_str());
+	}
+	historicalDe.setMode(TIC::DatasetExtractor::TicMode::Standard);
+	if (historicalDe.getMode() != TIC::DatasetExtractor::TicMode::Standard) {
+		FAILF("Mode should have been forced to standard TIC");
+	}
+}
+
+/**
+ * @brief Read the standard TIC sample, with the CR ending one of its datasets lost (once the TIC mode has been locked)
+ */
+static std::vector<uint8_t> readStandardSampleWithLostCr() {
+	std::vector<uint8_t> ticData = readVectorFromDisk("./samples/continuous_linky_1P_standard_TIC_sample.bin");
+	unsigned int datasetEndCount = 0;
+	for (unsigned int pos = 0; pos + 1 < ticData.size(); pos++) {
+		if (ticData[pos] == TIC::DatasetExtractor::CR && ticData[pos + 1] == TIC::DatasetExtractor::LF && ++datasetEndCount == 50) {
+			ticData.erase(ticData.begin() + pos);
+			break;
+		}
+	}
+	return ticData;
+}
+
+TEST(TicDatasetExtractor_tests, Standard_lost_CR_resync) {
+	std::vector<uint8_t> sample = readVectorFromDisk("./samples/continuous_linky_1P_standard_TIC_sample.bin");
+	std::vector<uint8_t> sampleWithLostCr = readStandardSampleWithLostCr();
+	if (sampleWithLostCr.size() != sample.size() - 1) {
+		FAILF("No CR has been removed from the sample");
+	}
+	for (unsigned int chunkSize : { 1u, 7u, 64u, static_cast<unsigned int>(sample.size()) }) {
+		ModeTrackingDecoderStub expectedStub;
+		TIC::DatasetExtractor expectedDe(modeTrackingDecoderStubUnwrapInvoke, &expectedStub);
+		expectedStub.de = &expectedDe;
+		ModeTrackingDecoderStub stub;
+		TIC::DatasetExtractor de(modeTrackingDecoderStubUnwrapInvoke, &stub);
+		stub.de = &de;
+		for (unsigned int pos = 0; pos < sample.size(); pos += chunkSize) {
+			unsigned int len = (sample.size() - pos < chunkSize) ? sample.size() - pos : chunkSize;
+			expectedDe.pushBytes(&(sample[pos]), len);
+		}
+		for (unsigned int pos = 0; pos < sampleWithLostCr.size(); pos += chunkSize) {
+			unsigned int len = (sampleWithLostCr.size() - pos < chunkSize) ? sampleWithLostCr.size() - pos : chunkSize;
+			de.pushBytes(&(sampleWithLostCr[pos]), len);
+		}
+		/* The dataset whose CR has been lost is ended by the LF starting the next one, so no dataset is lost */
+		if (de.getMode() != TIC::DatasetExtractor::TicMode::Standard || stub.decodedDatasetList != expectedStub.decodedDatasetList) {
+			FAILF("Chunk size %u: a lost CR should not lose any dataset (got %zu datasets, expected %zu)", chunkSize, stub.decodedDatasetList.size(), expectedStub.decodedDatasetList.size());
+		}
+		if (de.getErrorCounters().datasetResyncs != expectedDe.getErrorCounters().datasetResyncs + 1) {
+			FAILF("Chunk size %u: the lost CR should be accounted as a resync", chunkSize);
+		}
+	}
+}
+
+static void appendDatasetView(const TIC::DatasetView& dataset, void* context) {
+	std::vector<TIC::DatasetView::DatasetType>* decodedTypes = static_cast<std::vector<TIC::DatasetView::DatasetType>*>(context);
+	decodedTypes->push_back(dataset.decodedType);
+}
+
+TEST(TicDatasetExtractor_tests, ViewDatasetExtractor_same_as_DatasetView) {
+	const char* samples[] = {
+		"./samples/continuous_linky_1P_standard_TIC_sample.bin",
+		"./samples/continuous_linky_3P_historical_TIC_sample.bin",
+		"./samples/continuous_linky_3P_historical_TIC_with_rx_errors.bin",
+	};
+	for (const char* sample : samples) {
+		std::vector<uint8_t> ticData = readVectorFromDisk(sample);
+		std::vector<TIC::DatasetView::DatasetType> decodedTypes;
+		TIC::ViewDatasetExtractor de(appendDatasetView, &decodedTypes);
+		ModeTrackingDecoderStub expectedStub;
+		TIC::DatasetExtractor expectedDe(modeTrackingDecoderStubUnwrapInvoke, &expectedStub);
+		expectedStub.de = &expectedDe;
+		for (unsigned int pos = 0; pos < ticData.size(); pos += 64) {
+			unsigned int len = (ticData.size() - pos < 64) ? ticData.size() - pos : 64;
+			de.pushBytes(&(ticData[pos]), len);
+			expectedDe.pushBytes(&(ticData[pos]), len);
+		}
+		std::vector<TIC::DatasetView::DatasetType> expectedTypes;
+		for (const std::vector<uint8_t>& dataset : expectedStub.decodedDatasetList) {
+			expectedTypes.push_back(TIC::DatasetView(dataset.data(), static_cast<unsigned int>(dataset.size())).decodedType);
+		}
+		if (decodedTypes.empty() || decodedTypes != expectedTypes) {
+			FAILF("%s: %zu datasets decoded by the extractor, %zu expected, or their types differ", sample, decodedTypes.size(), expectedTypes.size());
+		}
+		if (de.getMode() == TIC::DatasetExtractor::TicMode::Unknown || de.getMode() != expectedDe.getMode()) {
+			FAILF("%s: mode should have been locked", sample);
+		}
+	}
+}
+
+/**
+ * @brief Push a stream into a new small (8-byte) dataset extractor using @p OverflowPolicy, in standard TIC mode, and get the datasets extracted
+ */
+template<typename OverflowPolicy>
+static std::vector<std::vector<uint8_t> > extractWithOverflowPolicy(const std::vector<uint8_t>& stream, unsigned int chunkSize, TIC::DecodeErrorCounters& counters) {
+	DatasetDecoderStub stub;
+	TIC::BasicDatasetExtractor<OverflowPolicy, 8> de(datasetDecoderStubUnwrapInvoke, &stub);
+	de.setMode(TIC::DatasetExtractorBase::TicMode::Standard);
+	for (unsigned int pos = 0; pos < stream.size(); pos += chunkSize) {
+		unsigned int len = stream.size() - pos;
+		if (len > chunkSize)
+			len = chunkSize;
+		de.pushBytes(&(stream[pos]), len);
+	}
+	counters = de.getErrorCounters();
+	return stub.decodedDatasetList;
+}
+
+TEST(TicDatasetExtractor_tests, Overflow_policies) {
+	const uint8_t LF = TIC::DatasetExtractor::START_MARKER;
+	const uint8_t CR = TIC::DatasetExtractor::END_MARKER_TIC_1;
+	/* An oversized dataset, then an oversized dataset whose CR has been lost (so that it swallows the next dataset in standard TIC), then a valid dataset */
+	std::vector<uint8_t> stream({ LF, 'a', 'b', 'c', 'd', 'e', 'f', 'g', 'h', 'i', 'j', CR,
+	                              LF, 'k', 'l', 'm', 'n', 'o', 'p', 'q', 'r', 's',
+	                              LF, 'x', 'y', CR });
+	for (unsigned int chunkSize : { 1u, 5u, 64u }) {
+		TIC::DecodeErrorCounters counters;
+		std::vector<std::vector<uint8_t> > datasets = extractWithOverflowPolicy<TIC::DatasetExtractorTruncateAndDeliver>(stream, chunkSize, counters);
+		if (datasets != std::vector<std::vector<uint8_t> >({ {'a', 'b', 'c', 'd', 'e', 'f', 'g', 'h'}, {'k', 'l', 'm', 'n', 'o', 'p', 'q', 'r'} }) ||
+		    counters.overflowedDatasets != 2 || counters.droppedDatasetBytes != 2 + 4 || counters.discardedDatasets != 0) {
+			FAILF("Truncate and deliver, %u-byte chunks: got %zu datasets, %u overflowed, %u bytes dropped", chunkSize, datasets.size(), counters.overflowedDatasets, counters.droppedDatasetBytes);
+		}
+
+		datasets = extractWithOverflowPolicy<TIC::DatasetExtractorDropAndCount>(stream, chunkSize, counters);
+		if (!datasets.empty() || counters.overflowedDatasets != 2 || counters.droppedDatasetBytes != 2 + 4 + 2 * 8 || counters.discardedDatasets != 2) {
+			FAILF("Drop and count, %u-byte chunks: got %zu datasets, %u discarded, %u bytes dropped", chunkSize, datasets.size(), counters.discardedDatasets, counters.droppedDatasetBytes);
+		}
+
+		/* Only this policy recovers the last dataset, by skipping bytes up to the next start marker as soon as the dataset with a lost CR overflows */
+		datasets = extractWithOverflowPolicy<TIC::DatasetExtractorDropUntilNextStartMarker>(stream, chunkSize, counters);
+		if (datasets != std::vector<std::vector<uint8_t> >({ {'x', 'y'} }) ||
+		    counters.overflowedDatasets != 2 || counters.discardedDatasets != 2) {
+			FAILF("Drop until next start marker, %u-byte chunks: got %zu datasets, %u overflowed, %u discarded", chunkSize, datasets.size(), counters.overflowedDatasets, counters.discardedDatasets);
+		}
+	}
+}
+
+static void appendFrameBytes(const uint8_t* buf, unsigned int cnt, void* context) {
+	std::vector<std::vector<uint8_t> >* frames = static_cast<std::vector<std::vector<uint8_t> >*>(context);
+	frames->back().insert(frames->back().end(), buf, buf + cnt);
+}
+
+static void startNewFrame(void* context) {
+	static_cast<std::vector<std::vector<uint8_t> >*>(context)->push_back(std::vector<uint8_t>());
+}
+
+TEST(TicDatasetExtractor_tests, Extraction_does_not_depend_on_chunk_size) {
+	const char* samples[] = {
+		"./samples/continuous_linky_1P_standard_TIC_sample.bin",
+		"./samples/continuous_linky_3P_historical_TIC_sample.bin",
+		"./samples/continuous_linky_3P_historical_TIC_2024_sample.bin",
+		"./samples/continuous_linky_3P_historical_TIC_with_rx_errors.bin",
+	};
+	for (const char* sample : samples) {
+		std::vector<uint8_t> ticData = readVectorFromDisk(sample);
+		std::vector<std::vector<uint8_t> > frames(1);
+		TIC::Unframer tu(appendFrameBytes, startNewFrame, &frames);
+		tu.pushBytes(&(ticData[0]), ticData.size());
+		frames.pop_back(); /* Drop the trailing incomplete frame */
+
+		std::vector<std::vector<uint8_t> > expectedDatasets;
+		for (unsigned int chunkSize : { 1u, 7u, 64u, 4096u }) {
+			DatasetDecoderStub stub;
+			TIC::DatasetExtractor de(datasetDecoderStubUnwrapInvoke, &stub);
+			for (const std::vector<uint8_t>& frame : frames) {
+				de.reset();
+				for (unsigned int pos = 0; pos < frame.size(); pos += chunkSize) {
+					unsigned int len = frame.size() - pos;
+					if (len > chunkSize)
+						len = chunkSize;
+					de.pushBytes(&(frame[pos]), len);
+				}
+			}
+			if (chunkSize == 1) {
+				expectedDatasets = stub.decodedDatasetList;
+			}
+			else if (stub.decodedDatasetList != expectedDatasets) {
+				FAILF("%s: datasets extracted with %u-byte chunks (%zu) differ from datasets extracted bytewise (%zu)", sample, chunkSize, stub.decodedDatasetList.size(), expectedDatasets.size());
+			}
+		}
+		if (expectedDatasets.empty()) {
+			FAILF("%s: no dataset extracted", sample);
+		}
+	}
+}
+
+/**
+ * @brief A DatasetDecoderStub that also checks the prescan provided with each dataset
+ */
+class DatasetPrescanCheckerStub : public DatasetDecoderStub {
+public:
+	DatasetPrescanCheckerStub() : wrongPrescans(0) { }
+
+	void onDatasetExtractedCallback(const uint8_t* buf, unsigned int cnt, const TIC::DatasetPrescan& prescan) {
+		TIC::DatasetView dv(buf, cnt, prescan);
+		TIC::DatasetView expected(buf, cnt);
+		if (dv.decodedType != expected.decodedType ||
+		    dv.labelSz != expected.labelSz ||
+		    dv.dataSz != expected.dataSz ||
+		    (dv.labelSz && dv.labelBuffer != expected.labelBuffer) ||
+		    (dv.dataSz && dv.dataBuffer != expected.dataBuffer)) {
+			this->wrongPrescans++;
+		}
+		DatasetDecoderStub::onDatasetExtractedCallback(buf, cnt);
+	}
+
+	unsigned int wrongPrescans;
+};
+
+static void datasetPrescanCheckerStubUnwrapInvoke(const uint8_t* buf, unsigned int cnt, const TIC::DatasetPrescan& prescan, void* context) {
+	static_cast<DatasetPrescanCheckerStub*>(context)->onDatasetExtractedCallback(buf, cnt, prescan);
+}
+
+TEST(TicDatasetExtractor_tests, Prescan_sink_same_as_scanning_view) {
+	const char* samples[] = {
+		"./samples/continuous_linky_1P_standard_TIC_sample.bin",
+		"./samples/continuous_linky_3P_historical_TIC_sample.bin",
+		"./samples/continuous_linky_3P_historical_TIC_with_rx_errors.bin",
+	};
+	for (const char* sample : samples) {
+		std::vector<uint8_t> ticData = readVectorFromDisk(sample);
+		std::vector<std::vector<uint8_t> > frames(1);
+		TIC::Unframer tu(appendFrameBytes, startNewFrame, &frames);
+		tu.pushBytes(&(ticData[0]), ticData.size());
+		frames.pop_back(); /* Drop the trailing incomplete frame */
+
+		for (unsigned int chunkSize : { 1u, 7u, 64u, 4096u }) {
+			DatasetDecoderStub expectedStub;
+			TIC::DatasetExtractor expectedDe(datasetDecoderStubUnwrapInvoke, &expectedStub);
+			DatasetPrescanCheckerStub stub;
+			TIC::PrescanDatasetExtractor de(datasetPrescanCheckerStubUnwrapInvoke, &stub);
+			for (const std::vector<uint8_t>& frame : frames) {
+				expectedDe.reset();
+				de.reset();
+				for (unsigned int pos = 0; pos < frame.size(); pos += chunkSize) {
+					unsigned int len = frame.size() - pos;
+					if (len > chunkSize)
+						len = chunkSize;
+					expectedDe.pushBytes(&(frame[pos]), len);
+					de.pushBytes(&(frame[pos]), len);
+				}
+			}
+			if (stub.decodedDatasetList != expectedStub.decodedDatasetList) {
+				FAILF("%s: datasets extracted with a prescan sink and %u-byte chunks (%zu) differ from datasets extracted without (%zu)", sample, chunkSize, stub.decodedDatasetList.size(), expectedStub.decodedDatasetList.size());
+			}
+			if (stub.wrongPrescans != 0) {
+				FAILF("%s: %u datasets extracted with %u-byte chunks have a prescan that does not decode like the dataset", sample, stub.wrongPrescans, chunkSize);
+			}
+		}
+	}
+}
+
+/**
+ * @brief Does @p dataset start with @p label followed by a delimiter?
+ */
+static bool datasetHasLabel(const std::vector<uint8_t>& dataset, const char* label) {
+	size_t labelSize = strlen(label);
+	return (dataset.size() > labelSize &&
+	        memcmp(&(dataset[0]), label, labelSize) == 0 &&
+	        (dataset[labelSize] == 0x09 || dataset[labelSize] == 0x20));
+}
+
+TEST(TicDatasetExtractor_tests, Label_filter_same_as_filtering_delivered_datasets) {
+	struct {
+		const char* sample;
+		std::vector<const char*> labels;
+	} cases[] = {
+		{ "./samples/continuous_linky_1P_standard_TIC_sample.bin", { "EAST", "SINSTS", "IRMS1", "URMS1", "DATE" } },
+		{ "./samples/continuous_linky_3P_historical_TIC_sample.bin", { "PAPP", "IINST1", "BASE" } },
+		{ "./samples/continuous_linky_3P_historical_TIC_2024_sample.bin", { "PAPP", "IINST1", "BASE" } },
+	};
+	for (auto& c : cases) {
+		std::vector<uint8_t> ticData = readVectorFromDisk(c.sample);
+		std::vector<std::vector<uint8_t> > frames(1);
+		TIC::Unframer tu(appendFrameBytes, startNewFrame, &frames);
+		tu.pushBytes(&(ticData[0]), ticData.size());
+		frames.pop_back(); /* Drop the trailing incomplete frame */
+
+		TIC::DatasetLabelFilter filter;
+		for (const char* label : c.labels) {
+			filter.addLabel(label);
+		}
+		for (unsigned int chunkSize : { 1u, 3u, 7u, 64u, 4096u }) {
+			DatasetDecoderStub allStub;
+			TIC::DatasetExtractor allDe(datasetDecoderStubUnwrapInvoke, &allStub);
+			DatasetDecoderStub stub;
+			TIC::DatasetExtractor de(datasetDecoderStubUnwrapInvoke, &stub);
+			de.setLabelFilter(&filter); /* The same filter is used by the extractors of all chunk sizes, each one keeping its own counters */
+			for (const std::vector<uint8_t>& frame : frames) {
+				allDe.reset();
+				de.reset();
+				for (unsigned int pos = 0; pos < frame.size(); pos += chunkSize) {
+					unsigned int len = frame.size() - pos;
+					if (len > chunkSize)
+						len = chunkSize;
+					allDe.pushBytes(&(frame[pos]), len);
+					de.pushBytes(&(frame[pos]), len);
+				}
+			}
+			std::vector<std::vector<uint8_t> > expectedDatasets;
+			unsigned int otherDatasets = 0;
+			for (const std::vector<uint8_t>& dataset : allStub.decodedDatasetList) {
+				bool wanted = false;
+				for (const char* label : c.labels) {
+					wanted = wanted || datasetHasLabel(dataset, label);
+				}
+				if (wanted)
+					expectedDatasets.push_back(dataset);
+				else if (!dataset.empty())
+					otherDatasets++;
+			}
+			if (expectedDatasets.empty() || stub.decodedDatasetList != expectedDatasets) {
+				FAILF("%s: datasets extracted with a label filter and %u-byte chunks (%zu) differ from the datasets with these labels (%zu)", c.sample, chunkSize, stub.decodedDatasetList.size(), expectedDatasets.size());
+			}
+			const TIC::DatasetLabelFilterCounters& counters = de.getLabelFilterCounters();
+			if (counters.acceptedDatasets != expectedDatasets.size() || counters.filteredDatasets != otherDatasets || counters.filteredBytes == 0) {
+				FAILF("%s: with %u-byte chunks, unexpected filter counters: %u accepted (expected %zu), %u filtered (expected %u)", c.sample, chunkSize, counters.acceptedDatasets, expectedDatasets.size(), counters.filteredDatasets, otherDatasets);
+			}
+			const TIC::DatasetLabelFilterCounters& allCounters = allDe.getLabelFilterCounters();
+			if (allCounters.acceptedDatasets != 0 || allCounters.filteredDatasets != 0 || allCounters.filteredBytes != 0) {
+				FAILF("%s: filter counters should stay 0 without a label filter", c.sample);
+			}
+			de.resetLabelFilterCounters();
+			if (counters.acceptedDatasets != 0 || counters.filteredDatasets != 0 || counters.filteredBytes != 0) {
+				FAILF("%s: filter counters should be 0 after reset", c.sample);
+			}
+		}
+	}
+}
+
+/**
+ * @brief A compile-time dataset sink recording each dataset (and its prescan, if the extractor provides one)
+ */
+struct DatasetRecorder {
+	DatasetRecorder(std::vector<std::vector<uint8_t> >* datasets, std::vector<std::vector<unsigned int> >* prescans) :
+		datasets(datasets),
+		prescans(prescans) { }
+
+	void operator()(const uint8_t* buf, unsigned int cnt) {
+		this->datasets->push_back(std::vector<uint8_t>(buf, buf + cnt));
+	}
+
+	void operator()(const uint8_t* buf, unsigned int cnt, const TIC::DatasetPrescan& prescan) {
+		this->datasets->push_back(std::vector<uint8_t>(buf, buf + cnt));
+		this->prescans->push_back(std::vector<unsigned int>({ prescan.byteSum, prescan.htPos[0], prescan.htPos[1], prescan.spPos[0], prescan.spPos[1] }));
+	}
+
+	std::vector<std::vector<uint8_t> >* datasets;
+	std::vector<std::vector<unsigned int> >* prescans;
+};
+
+/**
+ * @brief A DatasetRecorder that wants the prescan of each dataset
+ */
+struct PrescanDatasetRecorder : public DatasetRecorder {
+	PrescanDatasetRecorder(std::vector<std::vector<uint8_t> >* datasets, std::vector<std::vector<unsigned int> >* prescans) :
+		DatasetRecorder(datasets, prescans) { }
+};
+
+namespace TIC {
+template<>
+struct DatasetSinkTraits<PrescanDatasetRecorder> {
+	typedef DatasetExtractorBase::FDatasetParserFunc FParserFunc;
+	static constexpr bool WANTS_PRESCAN = true;
+	static constexpr bool WANTS_VIEW = false;
+};
+} // namespace TIC
+
+/**
+ * @brief Check that feeding @p stream with pushByte() gives the same results as feeding it with pushBytes(&byte, 1)
+ */
+template<typename Extractor, typename Recorder>
+static void checkPushByteSameAsPushBytes(const char* description, const std::vector<uint8_t>& stream, const TIC::DatasetLabelFilter* labelFilter) {
+	std::vector<std::vector<uint8_t> > expectedDatasets;
+	std::vector<std::vector<unsigned int> > expectedPrescans;
+	std::vector<std::vector<uint8_t> > datasets;
+	std::vector<std::vector<unsigned int> > prescans;
+	Extractor expectedDe(Recorder(&expectedDatasets, &expectedPrescans));
+	Extractor de(Recorder(&datasets, &prescans));
+	expectedDe.setLabelFilter(labelFilter);
+	de.setLabelFilter(labelFilter);
+	for (unsigned int pos = 0; pos < stream.size(); pos++) {
+		unsigned int expectedUsed = expectedDe.pushBytes(&(stream[pos]), 1);
+		unsigned int used = de.pushByte(stream[pos]);
+		if (used != expectedUsed || de.isInSync() != expectedDe.isInSync() || de.getMode() != expectedDe.getMode()) {
+			FAILF("%s: pushByte() and pushBytes() differ at byte %u", description, pos);
+		}
+	}
+	if (datasets != expectedDatasets || prescans != expectedPrescans) {
+		FAILF("%s: datasets extracted with pushByte() (%zu) differ from datasets extracted with pushBytes() (%zu)", description, datasets.size(), expectedDatasets.size());
+	}
+	if (memcmp(&(de.getErrorCounters()), &(expectedDe.getErrorCounters()), sizeof(TIC::DecodeErrorCounters)) != 0) {
+		FAILF("%s: error counters differ between pushByte() and pushBytes()", description);
+	}
+	if (memcmp(&(de.getLabelFilterCounters()), &(expectedDe.getLabelFilterCounters()), sizeof(TIC::DatasetLabelFilterCounters)) != 0) {
+		FAILF("%s: label filter counters differ between pushByte() and pushBytes()", description);
+	}
+}
+
+TEST(TicDatasetExtractor_tests, PushByte_same_as_single_byte_pushBytes) {
+	const char* samples[] = {
+		"./samples/continuous_linky_1P_standard_TIC_sample.bin",
+		"./samples/continuous_linky_3P_historical_TIC_sample.bin",
+		"./samples/continuous_linky_3P_historical_TIC_2024_sample.bin",
+		"./samples/continuous_linky_3P_historical_TIC_with_rx_errors.bin",
+	};
+	TIC::DatasetLabelFilter labelFilter;
+	for (const char* label : { "EAST", "SINSTS", "DATE", "PAPP", "IINST1" }) {
+		labelFilter.addLabel(label);
+	}
+	std::vector<std::pair<std::string, std::vector<uint8_t> > > streams;
+	for (const char* sample : samples) {
+		streams.push_back(std::make_pair(std::string(sample), readVectorFromDisk(sample)));
+	}
+	streams.push_back(std::make_pair(std::string("Standard sample with a lost CR"), readStandardSampleWithLostCr()));
+	for (const std::pair<std::string, std::vector<uint8_t> >& stream : streams) {
+		const char* sample = stream.first.c_str();
+		const std::vector<uint8_t>& ticData = stream.second;
+		for (const TIC::DatasetLabelFilter* filter : { static_cast<const TIC::DatasetLabelFilter*>(nullptr), static_cast<const TIC::DatasetLabelFilter*>(&labelFilter) }) {
+			checkPushByteSameAsPushBytes<TIC::BasicDatasetExtractor<TIC::DatasetExtractorTruncateAndDeliver, 128, DatasetRecorder>, DatasetRecorder>(sample, ticData, filter);
+			checkPushByteSameAsPushBytes<TIC::BasicDatasetExtractor<TIC::DatasetExtractorTruncateAndDeliver, 8, DatasetRecorder>, DatasetRecorder>(sample, ticData, filter);
+			checkPushByteSameAsPushBytes<TIC::BasicDatasetExtractor<TIC::DatasetExtractorDropAndCount, 8, DatasetRecorder>, DatasetRecorder>(sample, ticData, filter);
+			checkPushByteSameAsPushBytes<TIC::BasicDatasetExtractor<TIC::DatasetExtractorDropUntilNextStartMarker, 8, DatasetRecorder>, DatasetRecorder>(sample, ticData, filter);
+			checkPushByteSameAsPushBytes<TIC::BasicDatasetExtractor<TIC::DatasetExtractorTruncateAndDeliver, 128, PrescanDatasetRecorder>, PrescanDatasetRecorder>(sample, ticData, filter);
+			checkPushByteSameAsPushBytes<TIC::BasicDatasetExtractor<TIC::DatasetExtractorTruncateAndDeliver, 8, PrescanDatasetRecorder>, PrescanDatasetRecorder>(sample, ticData, filter);
+		}
+	}
+}
+
+TEST(TicDatasetExtractor_tests, Unframer_pushByte_through_extractor_sink) {
+	typedef TIC::BasicDatasetExtractor<TIC::DatasetExtractorTruncateAndDeliver, TIC::DATASET_EXTRACTOR_DEFAULT_MAX_DATASET_SIZE, DatasetRecorder> RecordingDatasetExtractor;
+	typedef TIC::UnframerDatasetExtractorSink<RecordingDatasetExtractor> RecordingFrameSink;
+	for (const char* sample : { "./samples/continuous_linky_1P_standard_TIC_sample.bin", "./samples/continuous_linky_3P_historical_TIC_sample.bin" }) {
+		std::vector<uint8_t> ticData = readVectorFromDisk(sample);
+		std::vector<std::vector<uint8_t> > expectedDatasets;
+		std::vector<std::vector<uint8_t> > datasets;
+		RecordingDatasetExtractor expectedDe(DatasetRecorder(&expectedDatasets, nullptr));
+		RecordingDatasetExtractor de(DatasetRecorder(&datasets, nullptr));
+		TIC::BasicUnframer<TIC::UnframerForwardOnTheFly, TIC::UNFRAMER_DEFAULT_MAX_FRAME_SIZE, RecordingFrameSink> expectedTu((RecordingFrameSink(expectedDe)));
+		TIC::BasicUnframer<TIC::UnframerForwardOnTheFly, TIC::UNFRAMER_DEFAULT_MAX_FRAME_SIZE, RecordingFrameSink> tu((RecordingFrameSink(de)));
+		expectedTu.pushBytes(&(ticData[0]), ticData.size());
+		for (uint8_t byte : ticData) {
+			tu.pushByte(byte);
+		}
+		if (datasets.empty() || datasets != expectedDatasets) {
+			FAILF("%s: datasets extracted byte per byte through the sink chain (%zu) differ from datasets extracted in one push (%zu)", sample, datasets.size(), expectedDatasets.size());
+		}
+	}
+}
+
+/**
+ * @brief A DatasetDecoderStub that also records whether each dataset was delivered from within a given caller buffer
+ */
+class DatasetLocationCheckerStub : public DatasetDecoderStub {
+public:
+	DatasetLocationCheckerStub(const uint8_t* callerBuffer, unsigned int callerBufferSz) :
+		callerBuffer(callerBuffer),
+		callerBufferSz(callerBufferSz),
+		deliveredFromCallerBuffer() { }
+
+	DatasetLocationCheckerStub(const DatasetLocationCheckerStub&) = delete;
+	DatasetLocationCheckerStub& operator=(const DatasetLocationCheckerStub&) = delete;
+
+	void onDatasetExtractedCallback(const uint8_t* buf, unsigned int cnt) {
+		this->deliveredFromCallerBuffer.push_back(buf >= this->callerBuffer && buf + cnt <= this->callerBuffer + this->callerBufferSz);
+		DatasetDecoderStub::onDatasetExtractedCallback(buf, cnt);
+	}
+
+	const uint8_t* callerBuffer;
+	unsigned int callerBufferSz;
+	std::vector<bool> deliveredFromCallerBuffer;
+};
+
+static void datasetLocationCheckerStubUnwrapInvoke(const uint8_t* buf, unsigned int cnt, void* context) {
+	static_cast<DatasetLocationCheckerStub*>(context)->onDatasetExtractedCallback(buf, cnt);
+}
+
+TEST(TicDatasetExtractor_tests, Zero_copy_contiguous_datasets) {
+	uint8_t buffer[] = { TIC::DatasetExtractor::START_MARKER, 'a', 'b', 'c', TIC::DatasetExtractor::END_MARKER_TIC_1,
+	                     TIC::DatasetExtractor::START_MARKER, 'A', 'B', TIC::DatasetExtractor::END_MARKER_TIC_1,
+	                     TIC::DatasetExtractor::START_MARKER, '0', '1' };
+	uint8_t trailer[] = { '2', TIC::DatasetExtractor::END_MARKER_TIC_1 };
+	DatasetLocationCheckerStub stub(buffer, sizeof(buffer));
+	TIC::DatasetExtractor de(datasetLocationCheckerStubUnwrapInvoke, &stub);
+	de.pushBytes(buffer, sizeof(buffer));
+	de.pushBytes(trailer, sizeof(trailer));
+	if (stub.decodedDatasetList.size() != 3 ||
+	    stub.decodedDatasetList[0] != std::vector<uint8_t>({'a', 'b', 'c'}) ||
+	    stub.decodedDatasetList[1] != std::vector<uint8_t>({'A', 'B'}) ||
+	    stub.decodedDatasetList[2] != std::vector<uint8_t>({'0', '1', '2'})) {
+		FAILF("Wrong datasets decoded:\n%s", stub.toString().c_str());
+	}
+	if (!stub.deliveredFromCallerBuffer[0] || !stub.deliveredFromCallerBuffer[1]) {
+		FAILF("Contiguous datasets should be delivered from the caller's buffer");
+	}
+	if (stub.deliveredFromCallerBuffer[2]) {
+		FAILF("Dataset spanning two calls should be delivered from the internal buffer");
+	}
+}
+
+TEST(TicDatasetExtractor_tests, Zero_copy_oversized_dataset_truncated) {
+	uint8_t buffer[TIC::DatasetExtractor::MAX_DATASET_SIZE + 12];
+	memset(buffer, 'a', sizeof(buffer));
+	buffer[0] = TIC::DatasetExtractor::START_MARKER;
+	buffer[sizeof(buffer) - 1] = TIC::DatasetExtractor::END_MARKER_TIC_1;
+	DatasetLocationCheckerStub stub(buffer, sizeof(buffer));
+	TIC::DatasetExtractor de(datasetLocationCheckerStubUnwrapInvoke, &stub);
+	unsigned int usedBytes = de.pushBytes(buffer, sizeof(buffer));
+	if (stub.decodedDatasetList.size() != 1 || stub.decodedDatasetList[0].size() != TIC::DatasetExtractor::MAX_DATASET_SIZE || !stub.deliveredFromCallerBuffer[0]) {
+		FAILF("Oversized contiguous dataset should be delivered truncated from the caller's buffer:\n%s", stub.toString().c_str());
+	}
+	if (usedBytes != sizeof(buffer) - 10 || de.getErrorCounters().droppedDatasetBytes != 10) {
+		FAILF("Wrong used bytes (%u) or dropped bytes (%u)", usedBytes, de.getErrorCounters().droppedDatasetBytes);
+	}
+}
+
+static void appendDecodeError(TIC::DecodeError error, unsigned int count, void* context) {
+	static_cast<std::vector<std::pair<TIC::DecodeError, unsigned int> >*>(context)->push_back(std::make_pair(error, count));
+}
+
+TEST(TicDatasetExtractor_tests, Error_counters_and_callback) {
+	uint8_t oversized[TIC::DatasetExtractor::MAX_DATASET_SIZE + 10];
+	memset(oversized, 'a', sizeof(oversized));
+	uint8_t emptyDataset[] = { TIC::DatasetExtractor::START_MARKER, TIC::DatasetExtractor::END_MARKER_TIC_1 };
+	uint8_t startMarker = TIC::DatasetExtractor::START_MARKER;
+	uint8_t endMarker = TIC::DatasetExtractor::END_MARKER_TIC_1;
+	std::vector<std::pair<TIC::DecodeError, unsigned int> > errors;
+	DatasetDecoderStub stub;
+	TIC::DatasetExtractor de(datasetDecoderStubUnwrapInvoke, &stub);
+	de.setErrorCallback(appendDecodeError, &errors);
+	de.pushBytes(&startMarker, 1);
+	de.pushBytes(oversized, sizeof(oversized) - 4);
+	de.pushBytes(oversized, 4);
+	de.pushBytes(&endMarker, 1);
+	de.pushBytes(emptyDataset, sizeof(emptyDataset));
+	if (stub.decodedDatasetList.size() != 2 || stub.decodedDatasetList[0].size() != TIC::DatasetExtractor::MAX_DATASET_SIZE || !stub.decodedDatasetList[1].empty()) {
+		FAILF("Wrong datasets received:\n%s", stub.toString().c_str());
+	}
+	const TIC::DecodeErrorCounters& counters = de.getErrorCounters();
+	if (counters.overflowedDatasets != 1 || counters.droppedDatasetBytes != 10 || counters.emptyDatasets != 1) {
+		FAILF("Wrong error counters: %u overflowed datasets, %u dropped bytes, %u empty datasets", counters.overflowedDatasets, counters.droppedDatasetBytes, counters.emptyDatasets);
+	}
+	std::vector<std::pair<TIC::DecodeError, unsigned int> > expectedErrors({
+		std::make_pair(TIC::DecodeError::DatasetOverflow, 6u),
+		std::make_pair(TIC::DecodeError::DatasetOverflow, 4u),
+		std::make_pair(TIC::DecodeError::EmptyDataset, 1u),
+	});
+	if (errors != expectedErrors) {
+		FAILF("Wrong error callbacks: got %zu, expected %zu", errors.size(), expectedErrors.size());
+	}
+}
+
+/**
+ * @brief Check the datasets extracted from @p stream (pushed by chunks of any size) with TIC mode @p mode locked, and the resynchronizations accounted
+ */
+static void checkResync(const char* description, const std::string& stream, const std::vector<std::string>& expectedDatasets, unsigned int expectedResyncs, unsigned int expectedLostBytes, TIC::DatasetExtractor::TicMode mode = TIC::DatasetExtractor::TicMode::Historical) {
+	std::vector<std::vector<uint8_t> > expected;
+	for (const std::string& dataset : expectedDatasets) {
+		expected.push_back(std::vector<uint8_t>(dataset.begin(), dataset.end()));
+	}
+	const uint8_t* bytes = reinterpret_cast<const uint8_t*>(stream.data());
+	for (unsigned int chunkSize = 1; chunkSize <= stream.size(); chunkSize++) {
+		DatasetDecoderStub stub;
+		TIC::DatasetExtractor de(datasetDecoderStubUnwrapInvoke, &stub);
+		de.setMode(mode);
+		for (unsigned int pos = 0; pos < stream.size(); pos += chunkSize) {
+			unsigned int len = stream.size() - pos;
+			if (len > chunkSize)
+				len = chunkSize;
+			de.pushBytes(bytes + pos, len);
+		}
+		if (stub.decodedDatasetList != expected) {
+			FAILF("%s, chunk size %u: unexpected datasets extracted:\n%s", description, chunkSize, stub.toString().c_str());
+		}
+		const TIC::DecodeErrorCounters& counters = de.getErrorCounters();
+		if (counters.datasetResyncs != expectedResyncs || counters.resyncLostBytes != expectedLostBytes || counters.emptyDatasets != 0) {
+			FAILF("%s, chunk size %u: got %u resyncs (%u lost bytes) and %u empty datasets, expected %u resyncs (%u lost bytes)", description, chunkSize, counters.datasetResyncs, counters.resyncLostBytes, counters.emptyDatasets, expectedResyncs, expectedLostBytes);
+		}
+	}
+}
+
+TEST(TicDatasetExtractor_tests, Resync_after_missing_or_spurious_markers) {
+	checkResync("Missing CR", "\nA 1\r\nB 2\nC 3\r\nD 4\r", { "A 1", "B 2", "C 3", "D 4" }, 1, 0);
+	checkResync("Spurious LF inside a dataset", "\nA 1\r\nB\n 2\r\nC 3\r", { "A 1", "B", " 2", "C 3" }, 1, 0);
+	checkResync("Duplicated LF", "\nA 1\r\n\nB 2\r\nC 3\r", { "A 1", "B 2", "C 3" }, 1, 0);
+	checkResync("Missing LF", "\nA 1\rB 2\r\nC 3\r", { "A 1", "C 3" }, 1, 3);
+	checkResync("Spurious CR", "\nA 1\r\r\nB 2\r", { "A 1", "B 2" }, 1, 0);
+	checkResync("Datasets terminated by LF", "\nA 1\n\nB 2\n\nC 3\n", { "A 1", "B 2", "C 3" }, 0, 0);
+
+	/* In standard TIC, a LF only ends a dataset if it completes a valid dataset */
+	const TIC::DatasetExtractor::TicMode standard = TIC::DatasetExtractor::TicMode::Standard;
+	checkResync("Missing CR (standard)", "\nADSC\t064468368739\tM\nUMOY1\tH101112010203\t229\t'\r\nADSC\t064468368739\tM\r",
+	            { "ADSC\t064468368739\tM", "UMOY1\tH101112010203\t229\t'", "ADSC\t064468368739\tM" }, 1, 0, standard);
+	checkResync("Spurious LF inside a dataset (standard)", "\nADSC\t064468368739\tM\r\nADSC\t0644\n68368739\tM\r\nADSC\t064468368739\tM\r",
+	            { "ADSC\t064468368739\tM", "ADSC\t0644\n68368739\tM", "ADSC\t064468368739\tM" }, 0, 0, standard);
+	checkResync("Missing CR before a spurious LF (standard)", "\nADSC\t064468368739\tM\nUMOY1\tH10\n1112010203\t229\t'\r",
+	            { "ADSC\t064468368739\tM", "UMOY1\tH10\n1112010203\t229\t'" }, 1, 0, standard);
+
+	/* On a noisy line, no empty dataset should be delivered anymore */
+	std::vector<uint8_t> ticData = readVectorFromDisk("./samples/continuous_linky_3P_historical_TIC_with_rx_errors.bin");
+	DatasetDecoderStub stub;
+	TIC::DatasetExtractor de(datasetDecoderStubUnwrapInvoke, &stub);
+	TIC::Unframer tu(datasetExtractorUnwrapForwardFrameBytes, datasetExtractorUnWrapFrameFinished, &de);
+	tu.pushBytes(&(ticData[0]), ticData.size());
+	unsigned int validCount = 0;
+	for (const std::vector<uint8_t>& dataset : stub.decodedDatasetList) {
+		if (TIC::DatasetView(dataset.data(), dataset.size()).isValid())
+			validCount++;
+	}
+	if (de.getErrorCounters().emptyDatasets != 0 || de.getErrorCounters().datasetResyncs == 0 || validCount != 299) {
+		FAILF("Noisy sample: got %u valid datasets, %u empty datasets and %u resyncs", validCount, de.getErrorCounters().emptyDatasets, de.getErrorCounters().datasetResyncs);
+	}
+}
+
+TEST(TicDatasetExtractor_tests, PushBytesv_wrapped_ring_buffer) {
+	/* A ring buffer whose content wraps in the middle of the second dataset */
+	uint8_t ring[] = { 'B', TIC::DatasetExtractor::END_MARKER_TIC_1,
+	                   TIC::DatasetExtractor::START_MARKER, '0', '1', TIC::DatasetExtractor::END_MARKER_TIC_1,
+	                   'x', 'x', 'x', /* Unused part of the ring buffer */
+	                   TIC::DatasetExtractor::START_MARKER, 'a', 'b', 'c', TIC::DatasetExtractor::END_MARKER_TIC_1,
+	                   TIC::DatasetExtractor::START_MARKER, 'A' };
+	TIC::ByteSegment segments[] = { { ring + 9, 7 }, { ring, 6 } };
+	DatasetLocationCheckerStub stub(ring, sizeof(ring));
+	TIC::DatasetExtractor de(datasetLocationCheckerStubUnwrapInvoke, &stub);
+	unsigned int usedBytes = de.pushBytesv(segments, 2);
+	if (usedBytes != 13) {
+		FAILF("Wrong number of bytes used: %u", usedBytes);
+	}
+	if (stub.decodedDatasetList.size() != 3 ||
+	    stub.decodedDatasetList[0] != std::vector<uint8_t>({'a', 'b', 'c'}) ||
+	    stub.decodedDatasetList[1] != std::vector<uint8_t>({'A', 'B'}) ||
+	    stub.decodedDatasetList[2] != std::vector<uint8_t>({'0', '1'})) {
+		FAILF("Wrong datasets decoded:\n%s", stub.toString().c_str());
+	}
+	/* Only the dataset straddling the wrap point is copied */
+	if (stub.deliveredFromCallerBuffer != std::vector<bool>({true, false, true})) {
+		FAILF("Datasets entirely inside one segment should be delivered in place");
+	}
+}
+
+TEST(TicDatasetExtractor_tests, PushBytesv_same_as_contiguous_pushBytes) {
+	std::vector<uint8_t> ticData = readVectorFromDisk("./samples/continuous_linky_3P_historical_TIC_with_rx_errors.bin");
+	DatasetDecoderStub expectedStub;
+	TIC::DatasetExtractor expectedDe(datasetDecoderStubUnwrapInvoke, &expectedStub);
+	expectedDe.pushBytes(&(ticData[0]), ticData.size());
+	for (unsigned int segmentSize : { 1U, 7U, 64U, 1000U }) {
+		std::vector<TIC::ByteSegment> segments;
+		for (unsigned int pos = 0; pos < ticData.size(); pos += segmentSize) {
+			unsigned int len = ticData.size() - pos;
+			if (len > segmentSize)
+				len = segmentSize;
+			segments.push_back(TIC::ByteSegment{ &(ticData[pos]), len });
+		}
+		DatasetDecoderStub stub;
+		TIC::DatasetExtractor de(datasetDecoderStubUnwrapInvoke, &stub);
+		unsigned int usedBytes = de.pushBytesv(&(segments[0]), segments.size());
+		if (usedBytes != ticData.size()) {
+			FAILF("Wrong number of bytes used with %u-byte segments: %u", segmentSize, usedBytes);
+		}
+		if (stub.decodedDatasetList != expectedStub.decodedDatasetList) {
+			FAILF("Datasets extracted from %u-byte segments differ from datasets extracted from contiguous bytes", segmentSize);
+		}
+		if (memcmp(&(de.getErrorCounters()), &(expectedDe.getErrorCounters()), sizeof(TIC::DecodeErrorCounters)) != 0) {
+			FAILF("Error counters differ between %u-byte segments and contiguous bytes", segmentSize);
+		}
+	}
+}
+
 #ifndef USE_CPPUTEST
 void runTicDatasetExtractorAllUnitTests() {
 	TicDatasetExtractor_test_one_pure_dataset_10bytes();
@@ -442,6 +1266,24 @@ void runTicDatasetExtractorAllUnitTests() {
 	Chunked_sample_unframe_dsextract_historical_TIC();
 	Chunked_sample_unframe_dsextract_historical_TIC_2();
 	Chunked_sample_unframe_dsextract_standard_TIC();
+	Large_buffer_single_push_same_as_bytewise();
+	Chunked_sample_compile_time_sinks_same_as_callbacks();
+	Unframer_callable_sink();
+	Error_counters_and_callback();
+	Zero_copy_contiguous_datasets();
+	Zero_copy_oversized_dataset_truncated();
+	Mode_detection_and_end_marker_policy();
+	Standard_lost_CR_resync();
+	ViewDatasetExtractor_same_as_DatasetView();
+	Extraction_does_not_depend_on_chunk_size();
+	Prescan_sink_same_as_scanning_view();
+	Label_filter_same_as_filtering_delivered_datasets();
+	PushByte_same_as_single_byte_pushBytes();
+	Unframer_pushByte_through_extractor_sink();
+	PushBytesv_wrapped_ring_buffer();
+	PushBytesv_same_as_contiguous_pushBytes();
+	Overflow_policies();
+	Resync_after_missing_or_spurious_markers();
 	//Sample_unframe_dsextract_historical_TIC_with_rx_errors();
 }
 #endif	// USE_CPPUTEST
@@ -0,0 +1,78 @@
+#include "TestHarness.h"
+#include <stdint.h>
+#include <string.h>
+
+#include "TIC/DatasetLabelFilter.h"
+
+TEST_GROUP(TicDatasetLabelFilter_tests) {
+};
+
+typedef TIC::DatasetLabelFilter::Decision Decision;
+
+/**
+ * @brief Match a C string against @p filter, with its bytes split in two parts at @p splitPos
+ */
+static Decision decideSplit(const TIC::DatasetLabelFilter& filter, const char* bytes, unsigned int splitPos) {
+	const uint8_t* buf = reinterpret_cast<const uint8_t*>(bytes);
+	unsigned int len = static_cast<unsigned int>(strlen(bytes));
+	if (splitPos > len)
+		splitPos = len;
+	return filter.decide(buf, splitPos, buf + splitPos, len - splitPos);
+}
+
+TEST(TicDatasetLabelFilter_tests, TicDatasetLabelFilter_add_label) {
+	TIC::DatasetLabelFilter filter;
+	if (!filter.addLabel("EAST") || !filter.addLabel("PJOURF+1")) {
+		FAILF("Valid labels should be accepted");
+	}
+	if (filter.addLabel("") || filter.addLabel(nullptr) || filter.addLabel("EA ST") || filter.addLabel("EA\tST") || filter.addLabel("01234567890123456")) {
+		FAILF("Empty or too long labels, or labels containing delimiters should be refused");
+	}
+	while (filter.getLabelCount() < TIC::DatasetLabelFilter::MAX_LABELS) {
+		filter.addLabel("ADSC");
+	}
+	if (filter.addLabel("ADCO")) {
+		FAILF("No more than %u labels should be accepted", TIC::DatasetLabelFilter::MAX_LABELS);
+	}
+	filter.clear();
+	if (filter.getLabelCount() != 0 || decideSplit(filter, "EAST\t000\tA", 0) != Decision::Reject) {
+		FAILF("All datasets should be rejected by an empty allowlist");
+	}
+}
+
+TEST(TicDatasetLabelFilter_tests, TicDatasetLabelFilter_decide) {
+	TIC::DatasetLabelFilter filter;
+	filter.addLabel("EAST");
+	filter.addLabel("EASF01");
+	filter.addLabel("PAPP");
+	struct {
+		const char* bytes;
+		Decision expected;
+	} cases[] = {
+		{ "EAST\t000012345\t:", Decision::Accept },
+		{ "PAPP 00750 -", Decision::Accept },
+		{ "EASF01\t000012345\t:", Decision::Accept },
+		{ "EASF02\t000012345\t:", Decision::Reject },
+		{ "EASTX\t000012345\t:", Decision::Reject },
+		{ "EAS\r\nEAST\t000012345\t:", Decision::Reject }, /* Bytes past the end of the dataset do not match */
+		{ "ADSC\t064468368739\tM", Decision::Reject },
+		{ "EAS", Decision::Undecided },
+		{ "EAST", Decision::Undecided },
+		{ "EASF0", Decision::Undecided },
+		{ "", Decision::Undecided },
+	};
+	for (auto& c : cases) {
+		for (unsigned int splitPos = 0; splitPos <= strlen(c.bytes); splitPos++) {
+			if (decideSplit(filter, c.bytes, splitPos) != c.expected) {
+				FAILF("Wrong decision for dataset \"%s\" split at %u", c.bytes, splitPos);
+			}
+		}
+	}
+}
+
+#ifndef USE_CPPUTEST
+void runTicDatasetLabelFilterAllUnitTests() {
+	TicDatasetLabelFilter_add_label();
+	TicDatasetLabelFilter_decide();
+}
+#endif	// USE_CPPUTEST
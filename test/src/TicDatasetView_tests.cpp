@@ -603,6 +603,118 @@ TEST(TicDatasetView_tests, Chunked_sample_unframe_dsextract_decode_standard_TIC)
 	}
 }
 
+TEST(TicDatasetView_tests, TicDatasetView_prescan_same_as_scan) {
+	const char* datasets[] = {
+		"ADCO 012345678901 E",
+		"\nADCO 012345678901 E",
+		"ADCO 012345678901 E\r",
+		"ADCO 012345678901 F",
+		"ADSC\t064468368739\tM",
+		"UMOY1\tH101112010203\t229\t'",
+		"UMOY1\tH101112010203\t229\t(",
+		"DATE\tE110108140000\t\t:",
+		"PAPP 00750 -",
+		"PAPP00750 -",
+		"A\tB\tC",
+		"AB\t\t",
+		"ABCD",
+		"",
+	};
+
+	for (const char* dataset : datasets) {
+		const uint8_t* datasetBuf = reinterpret_cast<const uint8_t*>(dataset);
+		unsigned int datasetSz = static_cast<unsigned int>(strlen(dataset));
+		TIC::DatasetView expected(datasetBuf, datasetSz);
+		TIC::DatasetView dv(datasetBuf, datasetSz, TIC::DatasetPrescan::fromBuffer(datasetBuf, datasetSz));
+		if (dv.decodedType != expected.decodedType ||
+		    dv.labelSz != expected.labelSz ||
+		    dv.dataSz != expected.dataSz ||
+		    (dv.labelSz && dv.labelBuffer != expected.labelBuffer) ||
+		    (dv.dataSz && dv.dataBuffer != expected.dataBuffer) ||
+		    dv.horodate.isValid != expected.horodate.isValid ||
+		    (dv.horodate.isValid && dv.horodate != expected.horodate)) {
+			FAILF("Prescan-based decoding differs from scanning decoding for dataset %s", vectorToHexString(std::vector<uint8_t>(datasetBuf, datasetBuf + datasetSz)).c_str());
+		}
+		if (TIC::DatasetView::typeFromPrescan(datasetBuf, datasetSz, TIC::DatasetPrescan::fromBuffer(datasetBuf, datasetSz)) != expected.decodedType) {
+			FAILF("Prescan-based type differs from scanning decoding for dataset %s", vectorToHexString(std::vector<uint8_t>(datasetBuf, datasetBuf + datasetSz)).c_str());
+		}
+		if (TIC::DatasetView::typeOf(datasetBuf, datasetSz) != expected.decodedType) {
+			FAILF("Sum-only type differs from scanning decoding for dataset %s", vectorToHexString(std::vector<uint8_t>(datasetBuf, datasetBuf + datasetSz)).c_str());
+		}
+	}
+}
+
+TEST(TicDatasetView_tests, TicDatasetView_prescan_by_blocks_same_as_bytewise) {
+	/* Long enough for several 16-byte blocks, with delimiters at block boundaries, followed by an end marker and bytes that must not be accounted */
+	std::string dataset("PJOURF+1\t00008001 NONUTILE NONUTILE NONUTILE NONUTILE\t 0\tNONUTILE\tNONUTILE \t\t\t\t\tNONUTILE NONUTILE\t9");
+	std::string stream = dataset + "\r\nADCO 012345678901 E\r\n";
+	const uint8_t* datasetBuf = reinterpret_cast<const uint8_t*>(stream.c_str());
+	unsigned int datasetSz = static_cast<unsigned int>(dataset.size());
+	TIC::DatasetPrescan expected = TIC::DatasetPrescan::fromBuffer(datasetBuf, datasetSz);
+
+	for (unsigned int blockSize = 1; blockSize <= stream.size(); blockSize++) {
+		TIC::DatasetPrescan prescan;
+		const uint8_t* endMarker = nullptr;
+		for (unsigned int pos = 0; pos < stream.size() && !endMarker; pos += blockSize) {
+			unsigned int count = stream.size() - pos;
+			if (count > blockSize)
+				count = blockSize;
+			endMarker = prescan.accountBytesUpTo(datasetBuf + pos, count, pos, 0x0d, 0x0a);
+		}
+		if (endMarker != datasetBuf + datasetSz) {
+			FAILF("End marker not found at the expected position with %u-byte blocks", blockSize);
+		}
+		if (prescan.byteSum != expected.byteSum ||
+		    prescan.htPos[0] != expected.htPos[0] || prescan.htPos[1] != expected.htPos[1] ||
+		    prescan.spPos[0] != expected.spPos[0] || prescan.spPos[1] != expected.spPos[1]) {
+			FAILF("Prescan collected by %u-byte blocks differs from bytewise prescan", blockSize);
+		}
+	}
+}
+
+static bool sameDatasetView(const TIC::DatasetView& dv, const TIC::DatasetView& expected) {
+	return (dv.decodedType == expected.decodedType &&
+	        dv.labelSz == expected.labelSz &&
+	        dv.dataSz == expected.dataSz &&
+	        (!dv.labelSz || dv.labelBuffer == expected.labelBuffer) &&
+	        (!dv.dataSz || dv.dataBuffer == expected.dataBuffer) &&
+	        dv.horodate.isValid == expected.horodate.isValid &&
+	        (!dv.horodate.isValid || dv.horodate == expected.horodate));
+}
+
+TEST(TicDatasetView_tests, TicDatasetView_format_specialised_same_as_generic) {
+	const char* datasets[] = {
+		"ADCO 012345678901 E",
+		"\nADCO 012345678901 E",
+		"ADCO 012345678901 E\r",
+		"ADCO 012345678901 F",
+		"ADSC\t064468368739\tM",
+		"\nADSC\t064468368739\tM\r",
+		"ADSC\t064468368739\tN",
+		"UMOY1\tH101112010203\t229\t'",
+		"DATE\tE110108140000\t\t:",
+		"PAPP 00750 -",
+		"PAPP00750 -",
+		"A\tB\tC",
+		"AB\t\t",
+		"ABCD",
+		"",
+	};
+
+	for (const char* dataset : datasets) {
+		const uint8_t* datasetBuf = reinterpret_cast<const uint8_t*>(dataset);
+		unsigned int datasetSz = static_cast<unsigned int>(strlen(dataset));
+		TIC::DatasetView expected(datasetBuf, datasetSz);
+		TIC::DatasetPrescan prescan = TIC::DatasetPrescan::fromBuffer(datasetBuf, datasetSz);
+		if (!sameDatasetView(TIC::DatasetView(datasetBuf, datasetSz, TIC::HistoricalTicFormat()), expected) ||
+		    !sameDatasetView(TIC::DatasetView(datasetBuf, datasetSz, TIC::StandardTicFormat()), expected) ||
+		    !sameDatasetView(TIC::DatasetView(datasetBuf, datasetSz, prescan, TIC::HistoricalTicFormat()), expected) ||
+		    !sameDatasetView(TIC::DatasetView(datasetBuf, datasetSz, prescan, TIC::StandardTicFormat()), expected)) {
+			FAILF("Format-specialised decoding differs from generic decoding for dataset %s", vectorToHexString(std::vector<uint8_t>(datasetBuf, datasetBuf + datasetSz)).c_str());
+		}
+	}
+}
+
 TEST(TicDatasetView_tests, TicDatasetView_uint32FromValueBuffer) {
 	if (TIC::DatasetView::uint32FromValueBuffer((const uint8_t*)("0"), 1) != 0) {
 		FAILF("Failed parsing value");
@@ -684,6 +796,120 @@ TEST(TicDatasetView_tests, TicDatasetView_uint32FromValueBuffer) {
 	}
 }
 
+/**
+ * @brief Reference digit-by-digit conversion, used to check uint64FromValueBuffer()
+ */
+static uint64_t referenceUint64FromDigits(const std::string& digits, bool& ok) {
+	uint64_t result = 0;
+	ok = false;
+	if (digits.empty())
+		return 0;
+	for (char c : digits) {
+		if (c < '0' || c > '9')
+			return 0;
+		unsigned int digit = c - '0';
+		if (result > ((uint64_t)-1 - digit) / 10)
+			return 0;
+		result = result * 10 + digit;
+	}
+	ok = true;
+	return result;
+}
+
+static uint64_t uint64FromString(const std::string& digits, bool& ok) {
+	return TIC::DatasetView::uint64FromValueBuffer(reinterpret_cast<const uint8_t*>(digits.data()), static_cast<unsigned int>(digits.size()), ok);
+}
+
+TEST(TicDatasetView_tests, TicDatasetView_uint64FromValueBuffer) {
+	struct {
+		const char* digits;
+		bool ok;
+		uint64_t value;
+	} cases[] = {
+		{ "", false, 0 },
+		{ "0", true, 0 },
+		{ "7", true, 7 },
+		{ "12345678", true, 12345678 },
+		{ "123456789", true, 123456789 },
+		{ "000012345678", true, 12345678 },
+		{ "4294967295", true, 4294967295ULL },
+		{ "4294967296", true, 4294967296ULL },
+		{ "18446744073709551615", true, 18446744073709551615ULL },
+		{ "0000018446744073709551615", true, 18446744073709551615ULL },
+		{ "18446744073709551616", false, 0 },
+		{ "99999999999999999999", false, 0 },
+		{ "100000000000000000000", false, 0 },
+		{ "1234567a", false, 0 },
+		{ "a2345678", false, 0 },
+		{ "12:4", false, 0 },
+		{ "12/4", false, 0 },
+		{ "-1", false, 0 },
+		{ "1 2", false, 0 },
+	};
+	for (const auto& c : cases) {
+		bool ok;
+		uint64_t value = uint64FromString(c.digits, ok);
+		if (ok != c.ok || value != c.value) {
+			FAILF("Wrong conversion of \"%s\": ok=%d, value=%llu", c.digits, ok, (unsigned long long)value);
+		}
+	}
+	/* Compare with the reference conversion, for all lengths, with a non-digit at each position */
+	const char nonDigits[] = { '/', ':', ' ', '\x00', static_cast<char>('0' + 0x80), static_cast<char>('9' + 0x10) };
+	std::string digits;
+	for (unsigned int len = 1; len <= 24; len++) {
+		digits += static_cast<char>('0' + (len * 7) % 10);
+		for (unsigned int pos = 0; pos <= len; pos++) {
+			for (unsigned int nonDigitIdx = 0; nonDigitIdx <= sizeof(nonDigits); nonDigitIdx++) {
+				std::string value = digits;
+				if (pos < len && nonDigitIdx < sizeof(nonDigits)) {
+					value[pos] = nonDigits[nonDigitIdx];
+				}
+				bool expectedOk;
+				bool ok;
+				uint64_t expected = referenceUint64FromDigits(value, expectedOk);
+				uint64_t result = uint64FromString(value, ok);
+				if (ok != expectedOk || result != expected) {
+					FAILF("Wrong conversion of %s: ok=%d, value=%llu, expected ok=%d, value=%llu", vectorToHexString(std::vector<uint8_t>(value.begin(), value.end())).c_str(), ok, (unsigned long long)result, expectedOk, (unsigned long long)expected);
+				}
+			}
+		}
+	}
+}
+
+TEST(TicDatasetView_tests, TicDatasetView_dataToUint_with_error_flag) {
+	const char* datasets[] = { "EAST\t4294967295\t8", "EAST\t4294967296\t9", "EAST\t000012345678\tC", "PAPP 0075a ^" };
+	bool ok;
+	TIC::DatasetView maxUint32(reinterpret_cast<const uint8_t*>(datasets[0]), static_cast<unsigned int>(strlen(datasets[0])));
+	if (!maxUint32.isValid() || maxUint32.dataToUint32(ok) != 4294967295U || !ok || maxUint32.dataToUint64(ok) != 4294967295ULL || !ok) {
+		FAILF("4294967295 should be a valid value");
+	}
+	TIC::DatasetView above32bits(reinterpret_cast<const uint8_t*>(datasets[1]), static_cast<unsigned int>(strlen(datasets[1])));
+	if (!above32bits.isValid() || above32bits.dataToUint64(ok) != 4294967296ULL || !ok) {
+		FAILF("4294967296 should be a valid 64-bit value");
+	}
+	above32bits.dataToUint32(ok);
+	if (ok) {
+		FAILF("4294967296 should not fit in 32 bits");
+	}
+	TIC::DatasetView energy(reinterpret_cast<const uint8_t*>(datasets[2]), static_cast<unsigned int>(strlen(datasets[2])));
+	if (!energy.isValid() || energy.dataToUint64(ok) != 12345678 || !ok || energy.dataToUint32(ok) != 12345678 || !ok) {
+		FAILF("Wrong value for an energy dataset");
+	}
+	TIC::DatasetView notANumber(reinterpret_cast<const uint8_t*>(datasets[3]), static_cast<unsigned int>(strlen(datasets[3])));
+	if (!notANumber.isValid()) {
+		FAILF("Dataset should be valid");
+	}
+	notANumber.dataToUint64(ok);
+	if (ok) {
+		FAILF("A non-numeric value should be reported as an error");
+	}
+	TIC::DatasetView invalid(reinterpret_cast<const uint8_t*>("PAPP 00750 0"), 12);
+	invalid.dataToUint32(ok);
+	if (invalid.isValid() || ok) {
+		FAILF("The value of an invalid dataset should be reported as an error");
+	}
+}
+
 TEST(TicDatasetView_tests, TicDatasetView_labelEquals) {
 	const char dataset[] = "PAPP 00750 -";
 	const uint8_t* datasetBuf = reinterpret_cast<const unsigned char*>(dataset);
@@ -1073,7 +1299,12 @@ void runTicDatasetViewAllUnitTests() {
 	TicDatasetView_historical_with_value();
 	Chunked_sample_unframe_dsextract_decode_historical_TIC();
 	Chunked_sample_unframe_dsextract_decode_standard_TIC();
+	TicDatasetView_prescan_same_as_scan();
+	TicDatasetView_prescan_by_blocks_same_as_bytewise();
+	TicDatasetView_format_specialised_same_as_generic();
 	TicDatasetView_uint32FromValueBuffer();
+	TicDatasetView_uint64FromValueBuffer();
+	TicDatasetView_dataToUint_with_error_flag();
 	TicDatasetView_labelEquals();
 	TicDatasetView_dataToUint32OnValidValue();
 	TicDatasetView_dataToUint32OnValidValueWith0Prefix();
@@ -0,0 +1,170 @@
+#include "TestHarness.h"
+#include <vector>
+#include <stdint.h>
+#include <string>
+#include <string.h>
+
+#include "Tools.h"
+#include "TIC/FrameValidator.h"
+#include "TIC/DatasetBatchExtractor.h"
+#include "TIC/DatasetView.h"
+#include "TIC/Unframer.h"
+
+TEST_GROUP(TicFrameValidator_tests) {
+};
+
+static void appendFrameBytes(const uint8_t* buf, unsigned int cnt, void* context) {
+	std::vector<std::vector<uint8_t> >* frames = static_cast<std::vector<std::vector<uint8_t> >*>(context);
+	frames->back().insert(frames->back().end(), buf, buf + cnt);
+}
+
+static void startNextFrame(void* context) {
+	static_cast<std::vector<std::vector<uint8_t> >*>(context)->push_back(std::vector<uint8_t>());
+}
+
+/**
+ * @brief Get the payloads of all complete frames of a sample file
+ */
+static std::vector<std::vector<uint8_t> > readSampleFrames(const char* sample) {
+	std::vector<uint8_t> ticData = readVectorFromDisk(sample);
+	std::vector<std::vector<uint8_t> > frames(1);
+	TIC::Unframer tu(appendFrameBytes, startNextFrame, &frames);
+	tu.pushBytes(&(ticData[0]), ticData.size());
+	frames.pop_back(); /* Drop the trailing incomplete frame */
+	return frames;
+}
+
+static void recordFrameSpans(const uint8_t* frame, unsigned int frameSize, const TIC::DatasetSpan* spans, unsigned int spanCount, void* context) {
+	std::vector<TIC::DatasetSpan>* result = static_cast<std::vector<TIC::DatasetSpan>*>(context);
+	result->assign(spans, spans + spanCount);
+}
+
+/**
+ * @brief Check that the checksum result of each listed dataset agrees with TIC::DatasetView
+ *
+ * @return The index of the first dataset that disagrees, or spanCount if all agree
+ */
+template<unsigned int MaxDatasetsPerFrame>
+static unsigned int firstDisagreementWithDatasetView(const uint8_t* frame, const TIC::FrameValidation<MaxDatasetsPerFrame>& validation) {
+	for (unsigned int idx = 0; idx < validation.spanCount; idx++) {
+		TIC::DatasetView dv(frame + validation.spans[idx].offset, validation.spans[idx].length);
+		if (validation.isValid(idx) && dv.decodedType == TIC::DatasetView::DatasetType::WrongCRC)
+			return idx;
+		if (!validation.isValid(idx) && dv.isValid())
+			return idx;
+	}
+	return validation.spanCount;
+}
+
+TEST(TicFrameValidator_tests, TicFrameValidator_handmade_frame) {
+	const char frameString[] =
+		"\nADCO 012345678901 E\r" /* Correct historical dataset */
+		"\nADCO 012345678901 E\n" /* Terminated by LF */
+		"\nADCO 012345678901 F\r" /* Wrong checksum */
+		"garbage"
+		"\nADSC\t064468368739\tM\r" /* Correct standard dataset */
+		"\nADSC\t0644" /* Ended by the next start marker, wrong checksum */
+		"\nABCD\r" /* Too short */
+		"\nUMOY1\tH101112010203\t229\t'\r" /* Correct standard dataset with horodate */
+		"\nADCO 0123"; /* Unterminated */
+	const uint8_t* frame = reinterpret_cast<const uint8_t*>(frameString);
+	TIC::FrameValidation<8> validation;
+	unsigned int spanCount = TIC::validateFrame(frame, static_cast<unsigned int>(strlen(frameString)), validation);
+	const char* expectedDatasets[] = { "ADCO 012345678901 E", "ADCO 012345678901 E", "ADCO 012345678901 F", "ADSC\t064468368739\tM", "ADSC\t0644", "ABCD", "UMOY1\tH101112010203\t229\t'" };
+	const bool expectedValid[] = { true, true, false, true, false, false, true };
+	if (spanCount != 7 || validation.spanCount != 7) {
+		FAILF("Expected 7 datasets, got %u", spanCount);
+	}
+	for (unsigned int idx = 0; idx < spanCount; idx++) {
+		std::string dataset(frameString + validation.spans[idx].offset, validation.spans[idx].length);
+		if (dataset != expectedDatasets[idx]) {
+			FAILF("Wrong dataset %u: \"%s\"", idx, dataset.c_str());
+		}
+		if (validation.isValid(idx) != expectedValid[idx]) {
+			FAILF("Wrong checksum result for dataset %u (\"%s\")", idx, dataset.c_str());
+		}
+	}
+	if (validation.validBitmap[0] != 0x4b || validation.isValid(7)) {
+		FAILF("Unexpected bitmap 0x%08x", validation.validBitmap[0]);
+	}
+}
+
+TEST(TicFrameValidator_tests, TicFrameValidator_bitmap_beyond_32_datasets) {
+	std::string frameString;
+	for (unsigned int idx = 0; idx < 45; idx++)
+		frameString += (idx % 3 == 0) ? "\nADCO 012345678901 F\r" : "\nADSC\t064468368739\tM\r";
+	const uint8_t* frame = reinterpret_cast<const uint8_t*>(frameString.data());
+
+	TIC::FrameValidation<64> validation;
+	if (TIC::validateFrame(frame, static_cast<unsigned int>(frameString.size()), validation) != 45) {
+		FAILF("Expected 45 datasets, got %u", validation.spanCount);
+	}
+	for (unsigned int idx = 0; idx < 45; idx++) {
+		if (validation.isValid(idx) != (idx % 3 != 0)) {
+			FAILF("Wrong checksum result for dataset %u", idx);
+		}
+	}
+	if ((validation.validBitmap[1] >> (45 - 32)) != 0) {
+		FAILF("Bits beyond the last dataset should be cleared");
+	}
+
+	TIC::FrameValidation<8> smallValidation;
+	if (TIC::validateFrame(frame, static_cast<unsigned int>(frameString.size()), smallValidation) != 8 || smallValidation.validBitmap[0] != 0xb6) {
+		FAILF("Expected only the first 8 datasets, got %u (bitmap 0x%08x)", smallValidation.spanCount, smallValidation.validBitmap[0]);
+	}
+}
+
+TEST(TicFrameValidator_tests, TicFrameValidator_samples) {
+	const char* samples[] = {
+		"./samples/continuous_linky_1P_standard_TIC_sample.bin",
+		"./samples/continuous_linky_3P_historical_TIC_sample.bin",
+		"./samples/continuous_linky_3P_historical_TIC_2024_sample.bin",
+		"./samples/linky_1P_midnight.bin",
+		"./samples/continuous_linky_3P_historical_TIC_with_rx_errors.bin",
+	};
+	for (const char* sample : samples) {
+		bool withRxErrors = (strstr(sample, "rx_errors") != nullptr);
+		std::vector<std::vector<uint8_t> > frames = readSampleFrames(sample);
+		if (frames.empty()) {
+			FAILF("%s: no frame found", sample);
+		}
+		unsigned int invalidDatasets = 0;
+		for (const std::vector<uint8_t>& frame : frames) {
+			TIC::FrameValidation<TIC::DATASET_BATCH_DEFAULT_MAX_DATASETS_PER_FRAME> validation;
+			TIC::validateFrame(&(frame[0]), static_cast<unsigned int>(frame.size()), validation);
+			unsigned int disagreement = firstDisagreementWithDatasetView(&(frame[0]), validation);
+			if (disagreement != validation.spanCount) {
+				FAILF("%s: checksum result of dataset %u differs from DatasetView", sample, disagreement);
+			}
+			for (unsigned int idx = 0; idx < validation.spanCount; idx++) {
+				if (!validation.isValid(idx))
+					invalidDatasets++;
+			}
+			if (withRxErrors)
+				continue;
+			/* On well-formed frames, the datasets are those listed by DatasetBatchExtractor */
+			std::vector<TIC::DatasetSpan> expectedSpans;
+			TIC::DatasetBatchExtractor batchExtractor(recordFrameSpans, &expectedSpans);
+			batchExtractor.pushFrame(&(frame[0]), static_cast<unsigned int>(frame.size()));
+			if (expectedSpans.size() != validation.spanCount) {
+				FAILF("%s: %u datasets listed, expected %zu", sample, validation.spanCount, expectedSpans.size());
+			}
+			for (unsigned int idx = 0; idx < validation.spanCount; idx++) {
+				if (validation.spans[idx].offset != expectedSpans[idx].offset || validation.spans[idx].length != expectedSpans[idx].length) {
+					FAILF("%s: wrong span for dataset %u", sample, idx);
+				}
+			}
+		}
+		if (withRxErrors ? (invalidDatasets == 0) : (invalidDatasets != 0)) {
+			FAILF("%s: unexpected number of invalid datasets (%u)", sample, invalidDatasets);
+		}
+	}
+}
+
+#ifndef USE_CPPUTEST
+void runTicFrameValidatorAllUnitTests() {
+	TicFrameValidator_handmade_frame();
+	TicFrameValidator_bitmap_beyond_32_datasets();
+	TicFrameValidator_samples();
+}
+#endif	// USE_CPPUTEST
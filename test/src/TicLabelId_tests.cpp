@@ -0,0 +1,117 @@
+#include "TestHarness.h"
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+
+#include "Tools.h"
+#include "TIC/LabelId.h"
+#include "TIC/DatasetView.h"
+#include "TIC/DatasetExtractor.h"
+#include "TIC/Unframer.h"
+
+TEST_GROUP(TicLabelId_tests) {
+};
+
+static TIC::LabelId labelIdFromCString(const char* label) {
+	return TIC::labelIdFromBuffer(reinterpret_cast<const uint8_t*>(label), static_cast<unsigned int>(strlen(label)));
+}
+
+TEST(TicLabelId_tests, TicLabelId_known_labels) {
+	const char* labels[] = {
+#define TIC_LABEL_STRING(id, label) label,
+		TIC_KNOWN_LABELS(TIC_LABEL_STRING)
+#undef TIC_LABEL_STRING
+	};
+	for (const char* label : labels) {
+		TIC::LabelId id = labelIdFromCString(label);
+		if (id == TIC::LabelId::Unknown || strcmp(TIC::labelName(id), label) != 0) {
+			FAILF("Known label \"%s\" should get its own identifier", label);
+		}
+		if (TIC::labelIdFromKey(TIC::labelKey(label)) != id) {
+			FAILF("Known label \"%s\" should get the same identifier from its key", label);
+		}
+	}
+	if (labelIdFromCString("EAST") != TIC::LabelId::EAST ||
+	    labelIdFromCString("SMAXSN1-1") != TIC::LabelId::SMAXSN1_1 ||
+	    labelIdFromCString("NJOURF+1") != TIC::LabelId::NJOURF_PLUS_1) {
+		FAILF("Wrong identifier for a known label");
+	}
+}
+
+TEST(TicLabelId_tests, TicLabelId_unknown_labels) {
+	for (const char* label : { "", "EAS", "EASTT", "east", "SMAXSN1-12", "FOOBAR" }) {
+		if (labelIdFromCString(label) != TIC::LabelId::Unknown) {
+			FAILF("Label \"%s\" should be unknown", label);
+		}
+	}
+	const uint8_t withNul[] = { 'P', 'R', 'M', '\0' };
+	if (TIC::labelIdFromBuffer(withNul, sizeof(withNul)) != TIC::LabelId::Unknown) {
+		FAILF("A label followed by a NUL byte should be unknown");
+	}
+	if (strcmp(TIC::labelName(TIC::LabelId::Unknown), "") != 0) {
+		FAILF("The name of an unknown label should be empty");
+	}
+}
+
+TEST(TicLabelId_tests, TicLabelId_dataset_view) {
+	const uint8_t dataset[] = "PAPP 00750 -";
+	TIC::DatasetView dv(dataset, sizeof(dataset) - 1);
+	if (!dv.isValid() || dv.labelId != TIC::LabelId::PAPP) {
+		FAILF("Wrong identifier for a PAPP dataset");
+	}
+	const uint8_t invalidDataset[] = "PAPP 00750 0";
+	TIC::DatasetView invalidDv(invalidDataset, sizeof(invalidDataset) - 1);
+	if (invalidDv.isValid() || invalidDv.labelId != TIC::LabelId::Unknown) {
+		FAILF("An invalid dataset should have an unknown label identifier");
+	}
+}
+
+/**
+ * @brief Context counting the datasets of a sample whose label identifier does not match their label
+ */
+struct LabelIdCheckContext {
+	unsigned int validDatasets;
+	unsigned int mismatches;
+};
+
+static void checkDatasetLabelId(const uint8_t* buf, unsigned int cnt, void* context) {
+	LabelIdCheckContext* ctx = static_cast<LabelIdCheckContext*>(context);
+	TIC::DatasetView dv(buf, cnt);
+	if (!dv.isValid())
+		return;
+	ctx->validDatasets++;
+	const char* name = TIC::labelName(dv.labelId);
+	if (dv.labelId == TIC::LabelId::Unknown || strlen(name) != dv.labelSz || memcmp(name, dv.labelBuffer, dv.labelSz) != 0) {
+		ctx->mismatches++;
+	}
+}
+
+static void forwardFrameBytesToExtractor(const uint8_t* buf, unsigned int cnt, void* context) {
+	static_cast<TIC::DatasetExtractor*>(context)->pushBytes(buf, cnt);
+}
+
+static void resetExtractorOnFrameComplete(void* context) {
+	static_cast<TIC::DatasetExtractor*>(context)->reset();
+}
+
+TEST(TicLabelId_tests, TicLabelId_all_sample_labels_known) {
+	for (const char* sample : { "./samples/continuous_linky_1P_standard_TIC_sample.bin", "./samples/continuous_linky_3P_historical_TIC_sample.bin" }) {
+		std::vector<uint8_t> ticData = readVectorFromDisk(sample);
+		LabelIdCheckContext ctx = { 0, 0 };
+		TIC::DatasetExtractor de(checkDatasetLabelId, &ctx);
+		TIC::Unframer tu(forwardFrameBytesToExtractor, resetExtractorOnFrameComplete, &de);
+		tu.pushBytes(&(ticData[0]), ticData.size());
+		if (ctx.validDatasets == 0 || ctx.mismatches != 0) {
+			FAILF("%s: %u datasets out of %u got a wrong label identifier", sample, ctx.mismatches, ctx.validDatasets);
+		}
+	}
+}
+
+#ifndef USE_CPPUTEST
+void runTicLabelIdAllUnitTests() {
+	TicLabelId_known_labels();
+	TicLabelId_unknown_labels();
+	TicLabelId_dataset_view();
+	TicLabelId_all_sample_labels_known();
+}
+#endif	// USE_CPPUTEST
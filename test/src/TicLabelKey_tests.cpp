@@ -0,0 +1,124 @@
+#include "TestHarness.h"
+#include <stdint.h>
+#include <string.h>
+#include <string>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+#include "Tools.h"
+#include "TIC/LabelKey.h"
+#include "TIC/DatasetView.h"
+#include "TIC/DatasetExtractor.h"
+#include "TIC/Unframer.h"
+
+TEST_GROUP(TicLabelKey_tests) {
+};
+
+static uint64_t labelKeyFromCString(const char* label) {
+	return TIC::labelKeyFromBuffer(reinterpret_cast<const uint8_t*>(label), static_cast<unsigned int>(strlen(label)));
+}
+
+static_assert(TIC::labelKey("EAST") != TIC::labelKey("EASF01"), "Different labels should have different keys");
+static_assert(TIC::labelKey("SMAXSN1-1") != TIC::NO_LABEL_KEY, "The longest standard TIC labels should have a key");
+
+TEST(TicLabelKey_tests, TicLabelKey_same_at_compile_time_and_runtime) {
+	for (const char* label : { "A", "EAST", "SINSTS", "MOTDETAT", "SMAXSN1-1", "NJOURF+1" }) {
+		if (TIC::labelKey(label) == TIC::NO_LABEL_KEY || labelKeyFromCString(label) != TIC::labelKey(label)) {
+			FAILF("Wrong key for label \"%s\"", label);
+		}
+	}
+	if (TIC::labelKey("EAST") == TIC::labelKey("EASTT") || TIC::labelKey("EAS") == TIC::labelKey("EAST")) {
+		FAILF("Labels sharing a prefix should have different keys");
+	}
+}
+
+TEST(TicLabelKey_tests, TicLabelKey_unpackable_labels) {
+	if (TIC::labelKey("") != TIC::NO_LABEL_KEY || TIC::labelKey("SMAXSN1-12") != TIC::NO_LABEL_KEY || TIC::labelKey("\xc3\xa9t\xc3\xa9") != TIC::NO_LABEL_KEY) {
+		FAILF("Empty, too long or non-ASCII labels should have no key");
+	}
+	const uint8_t withNul[] = { 'P', 'R', 'M', '\0' };
+	const uint8_t nonAscii[] = { 'P', 0x80 };
+	if (labelKeyFromCString("") != TIC::NO_LABEL_KEY || labelKeyFromCString("SMAXSN1-12") != TIC::NO_LABEL_KEY ||
+	    TIC::labelKeyFromBuffer(withNul, sizeof(withNul)) != TIC::NO_LABEL_KEY || TIC::labelKeyFromBuffer(nonAscii, sizeof(nonAscii)) != TIC::NO_LABEL_KEY) {
+		FAILF("Empty, too long, or labels containing NUL or non-ASCII bytes should have no key");
+	}
+}
+
+static unsigned int dispatchOnKey(uint64_t key) {
+	switch (key) {
+		case TIC::labelKey("EAST"): return 1;
+		case TIC::labelKey("SINSTS"): return 2;
+		case TIC::labelKey("PAPP"): return 3;
+		default: return 0;
+	}
+}
+
+TEST(TicLabelKey_tests, TicLabelKey_dataset_view) {
+	const uint8_t dataset[] = "PAPP 00750 -";
+	TIC::DatasetView dv(dataset, sizeof(dataset) - 1);
+	if (!dv.isValid() || dv.labelKey != TIC::labelKey("PAPP") || dispatchOnKey(dv.labelKey) != 3) {
+		FAILF("Wrong key for a PAPP dataset");
+	}
+	const uint8_t invalidDataset[] = "PAPP 00750 0";
+	TIC::DatasetView invalidDv(invalidDataset, sizeof(invalidDataset) - 1);
+	if (invalidDv.isValid() || invalidDv.labelKey != TIC::NO_LABEL_KEY) {
+		FAILF("An invalid dataset should have no label key");
+	}
+}
+
+/**
+ * @brief Aggregator counting datasets per label, both by label key and by label string
+ */
+struct LabelKeyAggregator {
+	LabelKeyAggregator() :
+		countsByKey(),
+		countsByString() { }
+
+	std::unordered_map<uint64_t, unsigned int> countsByKey;
+	std::map<std::string, unsigned int> countsByString;
+};
+
+static void aggregateDataset(const uint8_t* buf, unsigned int cnt, void* context) {
+	LabelKeyAggregator* aggregator = static_cast<LabelKeyAggregator*>(context);
+	TIC::DatasetView dv(buf, cnt);
+	if (!dv.isValid())
+		return;
+	aggregator->countsByKey[dv.labelKey]++;
+	aggregator->countsByString[std::string(reinterpret_cast<const char*>(dv.labelBuffer), dv.labelSz)]++;
+}
+
+static void forwardFrameBytesToExtractor(const uint8_t* buf, unsigned int cnt, void* context) {
+	static_cast<TIC::DatasetExtractor*>(context)->pushBytes(buf, cnt);
+}
+
+static void resetExtractorOnFrameComplete(void* context) {
+	static_cast<TIC::DatasetExtractor*>(context)->reset();
+}
+
+TEST(TicLabelKey_tests, TicLabelKey_hash_map_aggregation) {
+	for (const char* sample : { "./samples/continuous_linky_1P_standard_TIC_sample.bin", "./samples/continuous_linky_3P_historical_TIC_sample.bin" }) {
+		std::vector<uint8_t> ticData = readVectorFromDisk(sample);
+		LabelKeyAggregator aggregator;
+		TIC::DatasetExtractor de(aggregateDataset, &aggregator);
+		TIC::Unframer tu(forwardFrameBytesToExtractor, resetExtractorOnFrameComplete, &de);
+		tu.pushBytes(&(ticData[0]), ticData.size());
+		if (aggregator.countsByString.empty() || aggregator.countsByKey.size() != aggregator.countsByString.size()) {
+			FAILF("%s: %zu distinct label keys, but %zu distinct labels", sample, aggregator.countsByKey.size(), aggregator.countsByString.size());
+		}
+		for (const std::pair<const std::string, unsigned int>& labelCount : aggregator.countsByString) {
+			if (aggregator.countsByKey[labelKeyFromCString(labelCount.first.c_str())] != labelCount.second) {
+				FAILF("%s: wrong count for label %s", sample, labelCount.first.c_str());
+			}
+		}
+	}
+}
+
+#ifndef USE_CPPUTEST
+void runTicLabelKeyAllUnitTests() {
+	TicLabelKey_same_at_compile_time_and_runtime();
+	TicLabelKey_unpackable_labels();
+	TicLabelKey_dataset_view();
+	TicLabelKey_hash_map_aggregation();
+}
+#endif	// USE_CPPUTEST
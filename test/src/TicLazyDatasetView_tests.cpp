@@ -0,0 +1,154 @@
+#include "TestHarness.h"
+#include <vector>
+#include <stdint.h>
+#include <string>
+#include <string.h>
+
+#include "Tools.h"
+#include "TIC/LazyDatasetView.h"
+#include "TIC/DatasetView.h"
+#include "TIC/DatasetExtractor.h"
+#include "TIC/Unframer.h"
+
+TEST_GROUP(TicLazyDatasetView_tests) {
+};
+
+/**
+ * @brief Check that a LazyDatasetView gives the same results as a DatasetView on the same dataset
+ *
+ * @note The label and value are only compared on valid datasets, as they are empty for invalid datasets in LazyDatasetView
+ */
+static bool sameAsDatasetView(const TIC::LazyDatasetView& lazy, const TIC::DatasetView& expected) {
+	if (lazy.decodedType != expected.decodedType || lazy.isValid() != expected.isValid())
+		return false;
+	if (!expected.isValid())
+		return (lazy.labelSz == 0 && lazy.getDataSz() == 0 && !lazy.getHorodate().isValid);
+	const TIC::Horodate& horodate = lazy.getHorodate();
+	bool ok = false;
+	bool expectedOk = false;
+	return (lazy.labelSz == expected.labelSz &&
+	        lazy.labelBuffer == expected.labelBuffer &&
+	        lazy.labelKey == expected.labelKey &&
+	        lazy.labelId == expected.labelId &&
+	        lazy.getDataSz() == expected.dataSz &&
+	        (!expected.dataSz || lazy.getDataBuffer() == expected.dataBuffer) &&
+	        horodate.isValid == expected.horodate.isValid &&
+	        horodate.season == expected.horodate.season &&
+	        horodate.degradedTime == expected.horodate.degradedTime &&
+	        (!horodate.isValid || horodate == expected.horodate) &&
+	        lazy.dataToUint32() == expected.dataToUint32() &&
+	        lazy.dataToUint64(ok) == expected.dataToUint64(expectedOk) && ok == expectedOk);
+}
+
+TEST(TicLazyDatasetView_tests, TicLazyDatasetView_same_as_DatasetView) {
+	const char* datasets[] = {
+		"ADCO 012345678901 E",
+		"\nADCO 012345678901 E",
+		"ADCO 012345678901 E\r",
+		"ADCO 012345678901 F",
+		"ADSC\t064468368739\tM",
+		"\nADSC\t064468368739\tM\r",
+		"ADSC\t064468368739\tN",
+		"UMOY1\tH101112010203\t229\t'",
+		"DATE\tE110108140000\t\t:",
+		"PAPP 00750 -",
+		"PAPP00750 -",
+		"A\tB\tC",
+		"AB\t\t",
+		"ABCD",
+		"",
+	};
+
+	for (const char* dataset : datasets) {
+		const uint8_t* datasetBuf = reinterpret_cast<const uint8_t*>(dataset);
+		unsigned int datasetSz = static_cast<unsigned int>(strlen(dataset));
+		if (!sameAsDatasetView(TIC::LazyDatasetView(datasetBuf, datasetSz), TIC::DatasetView(datasetBuf, datasetSz))) {
+			FAILF("LazyDatasetView differs from DatasetView for dataset %s", vectorToHexString(std::vector<uint8_t>(datasetBuf, datasetBuf + datasetSz)).c_str());
+		}
+	}
+}
+
+/**
+ * @brief Number of datasets compared with DatasetView, and number of differences
+ */
+struct LazyComparisonCounters {
+	LazyComparisonCounters() : datasetCount(0), horodateCount(0), differenceCount(0) { }
+
+	unsigned int datasetCount;
+	unsigned int horodateCount;
+	unsigned int differenceCount;
+};
+
+static void compareLazyWithDatasetView(const uint8_t* buf, unsigned int cnt, void* context) {
+	LazyComparisonCounters* counters = static_cast<LazyComparisonCounters*>(context);
+	TIC::DatasetView expected(buf, cnt);
+	counters->datasetCount++;
+	if (expected.horodate.isValid)
+		counters->horodateCount++;
+	if (!sameAsDatasetView(TIC::LazyDatasetView(buf, cnt), expected))
+		counters->differenceCount++;
+}
+
+static void datasetExtractorPushBytes(const uint8_t* buf, unsigned int cnt, void* context) {
+	static_cast<TIC::DatasetExtractor*>(context)->pushBytes(buf, cnt);
+}
+
+static void datasetExtractorReset(void* context) {
+	static_cast<TIC::DatasetExtractor*>(context)->reset();
+}
+
+TEST(TicLazyDatasetView_tests, TicLazyDatasetView_samples_same_as_DatasetView) {
+	const char* samples[] = {
+		"./samples/continuous_linky_1P_standard_TIC_sample.bin",
+		"./samples/continuous_linky_3P_historical_TIC_sample.bin",
+		"./samples/continuous_linky_3P_historical_TIC_with_rx_errors.bin",
+		"./samples/linky_1P_midnight.bin",
+	};
+	unsigned int horodateCount = 0;
+	for (const char* sample : samples) {
+		std::vector<uint8_t> ticData = readVectorFromDisk(sample);
+		LazyComparisonCounters counters;
+		TIC::DatasetExtractor de(compareLazyWithDatasetView, &counters);
+		TIC::Unframer tu(datasetExtractorPushBytes, datasetExtractorReset, &de);
+		tu.pushBytes(&(ticData[0]), ticData.size());
+		if (counters.datasetCount == 0 || counters.differenceCount != 0) {
+			FAILF("%s: %u datasets out of %u differ from DatasetView", sample, counters.differenceCount, counters.datasetCount);
+		}
+		horodateCount += counters.horodateCount;
+	}
+	if (horodateCount == 0) {
+		FAILF("Samples should contain datasets with a horodate");
+	}
+}
+
+TEST(TicLazyDatasetView_tests, TicLazyDatasetView_fields_split_on_first_access) {
+	char dataset[] = "UMOY1\tH101112010203\t229\t'";
+	const uint8_t* datasetBuf = reinterpret_cast<const uint8_t*>(dataset);
+	TIC::LazyDatasetView dv(datasetBuf, static_cast<unsigned int>(strlen(dataset)));
+	if (!dv.isValid() || dv.labelId != TIC::LabelId::UMOY1 || !dv.labelEquals("UMOY1")) {
+		FAILF("Label should be available right after construction");
+	}
+
+	/* The horodate has not been parsed yet, so changing it in the buffer is visible at first access (but not at the next ones) */
+	dataset[13] = '2'; /* Hour 01 becomes 23 */
+	dataset[14] = '3';
+	const TIC::Horodate& horodate = dv.getHorodate();
+	if (!horodate.isValid || horodate.hour != 23 || horodate.minute != 2) {
+		FAILF("Horodate should be parsed from the buffer at first access");
+	}
+	dataset[18] = '9'; /* Second 03 becomes 09 */
+	if (dv.getHorodate().second != 3 || &(dv.getHorodate()) != &horodate) {
+		FAILF("Horodate should be cached after first access");
+	}
+	if (dv.getDataSz() != 3 || memcmp(dv.getDataBuffer(), "229", 3) != 0 || dv.dataToUint32() != 229) {
+		FAILF("Wrong data");
+	}
+}
+
+#ifndef USE_CPPUTEST
+void runTicLazyDatasetViewAllUnitTests() {
+	TicLazyDatasetView_same_as_DatasetView();
+	TicLazyDatasetView_samples_same_as_DatasetView();
+	TicLazyDatasetView_fields_split_on_first_access();
+}
+#endif	// USE_CPPUTEST
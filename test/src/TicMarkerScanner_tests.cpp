@@ -0,0 +1,99 @@
+#include "TestHarness.h"
+#include <vector>
+#include <stdint.h>
+#include <string.h>
+
+#include "Tools.h"
+#include "TIC/MarkerScanner.h"
+
+TEST_GROUP(TicMarkerScanner_tests) {
+};
+
+/**
+ * @brief Reference (bytewise) implementation of TIC::MarkerScanner::findFirstOf()
+ */
+static const uint8_t* referenceFindFirstOf(const uint8_t* buffer, unsigned int len, uint8_t marker1, uint8_t marker2) {
+	for (unsigned int pos = 0; pos < len; pos++) {
+		if (buffer[pos] == marker1 || buffer[pos] == marker2)
+			return buffer + pos;
+	}
+	return nullptr;
+}
+
+TEST(TicMarkerScanner_tests, TicMarkerScanner_no_marker) {
+	uint8_t buffer[100];
+	memset(buffer, 0x41, sizeof(buffer));
+	for (unsigned int len = 0; len <= sizeof(buffer); len++) {
+		if (TIC::MarkerScanner::findFirstOf(buffer, len, 0x02, 0x03) != nullptr) {
+			FAILF("Unexpected marker found in a buffer of %u bytes without marker", len);
+		}
+	}
+}
+
+TEST(TicMarkerScanner_tests, TicMarkerScanner_single_marker_all_positions) {
+	uint8_t buffer[100];
+	for (unsigned int markerPos = 0; markerPos < sizeof(buffer); markerPos++) {
+		memset(buffer, 0x41, sizeof(buffer));
+		buffer[markerPos] = 0x03;
+		for (unsigned int len = 0; len <= sizeof(buffer); len++) {
+			const uint8_t* expected = (markerPos < len) ? buffer + markerPos : nullptr;
+			const uint8_t* found = TIC::MarkerScanner::findFirstOf(buffer, len, 0x03, 0x02);
+			if (found != expected) {
+				FAILF("Wrong marker position with marker at %u in a buffer of %u bytes: got offset %ld", markerPos, len, found ? (long)(found - buffer) : -1L);
+			}
+			found = TIC::MarkerScanner::find(buffer, len, 0x03);
+			if (found != expected) {
+				FAILF("Wrong single marker position with marker at %u in a buffer of %u bytes: got offset %ld", markerPos, len, found ? (long)(found - buffer) : -1L);
+			}
+		}
+	}
+}
+
+TEST(TicMarkerScanner_tests, TicMarkerScanner_first_of_two_markers) {
+	uint8_t buffer[80];
+	for (unsigned int pos1 = 0; pos1 < sizeof(buffer); pos1++) {
+		for (unsigned int pos2 = 0; pos2 < sizeof(buffer); pos2++) {
+			if (pos1 == pos2)
+				continue;
+			memset(buffer, 0x80, sizeof(buffer)); /* Use a high byte, that could be mistaken by a wrong SWAR carry propagation */
+			buffer[pos1] = 0x02;
+			buffer[pos2] = 0x03;
+			const uint8_t* found = TIC::MarkerScanner::findFirstOf(buffer, sizeof(buffer), 0x02, 0x03);
+			const uint8_t* expected = buffer + (pos1 < pos2 ? pos1 : pos2);
+			if (found != expected) {
+				FAILF("Wrong marker position with markers at %u and %u", pos1, pos2);
+			}
+		}
+	}
+}
+
+TEST(TicMarkerScanner_tests, TicMarkerScanner_unaligned_sample) {
+	std::vector<uint8_t> ticData = readVectorFromDisk("./samples/continuous_linky_1P_standard_TIC_sample.bin");
+	const uint8_t markers[][2] = { { 0x02, 0x03 }, { 0x0a, 0x0d }, { 0x09, 0x09 } };
+
+	for (auto& marker : markers) {
+		for (unsigned int startOffset = 0; startOffset < 64; startOffset++) {
+			const uint8_t* pos = &(ticData[startOffset]);
+			const uint8_t* end = &(ticData[0]) + ticData.size();
+			while (pos < end) {
+				const uint8_t* expected = referenceFindFirstOf(pos, end - pos, marker[0], marker[1]);
+				const uint8_t* found = TIC::MarkerScanner::findFirstOf(pos, end - pos, marker[0], marker[1]);
+				if (found != expected) {
+					FAILF("Wrong marker position for markers %02x/%02x starting at offset %ld", marker[0], marker[1], (long)(pos - &(ticData[0])));
+				}
+				if (found == nullptr)
+					break;
+				pos = found + 1;
+			}
+		}
+	}
+}
+
+#ifndef USE_CPPUTEST
+void runTicMarkerScannerAllUnitTests() {
+	TicMarkerScanner_no_marker();
+	TicMarkerScanner_single_marker_all_positions();
+	TicMarkerScanner_first_of_two_markers();
+	TicMarkerScanner_unaligned_sample();
+}
+#endif	// USE_CPPUTEST
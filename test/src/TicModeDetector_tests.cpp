@@ -0,0 +1,92 @@
+#include "TestHarness.h"
+#include <stdint.h>
+
+#include "TIC/TicModeDetector.h"
+#include "TIC/DatasetView.h"
+
+TEST_GROUP(TicModeDetector_tests) {
+};
+
+typedef TIC::DatasetView::DatasetType DatasetType;
+typedef TIC::TicModeDetector::TicMode TicMode;
+
+/**
+ * @brief Account @p count datasets of type @p type into @p detector
+ *
+ * @return The number of times the locked mode has changed
+ */
+static unsigned int accountDatasets(TIC::TicModeDetector& detector, DatasetType type, unsigned int count) {
+	unsigned int changes = 0;
+	for (unsigned int idx = 0; idx < count; idx++) {
+		if (detector.account(type))
+			changes++;
+	}
+	return changes;
+}
+
+TEST(TicModeDetector_tests, TicModeDetector_lock_after_valid_datasets) {
+	TIC::TicModeDetector detector;
+	if (accountDatasets(detector, DatasetType::ValidStandard, TIC::TicModeDetector::LOCK_AFTER_VALID_DATASETS - 1) != 0 || detector.getMode() != TicMode::Unknown) {
+		FAILF("Mode should not be locked before %u valid datasets", TIC::TicModeDetector::LOCK_AFTER_VALID_DATASETS);
+	}
+	/* Invalid datasets do not break the streak of valid datasets */
+	accountDatasets(detector, DatasetType::WrongCRC, 1);
+	accountDatasets(detector, DatasetType::Malformed, 1);
+	if (accountDatasets(detector, DatasetType::ValidStandard, 1) != 1 || detector.getMode() != TicMode::Standard) {
+		FAILF("Expected standard mode to be locked");
+	}
+	/* Further valid datasets do not change anything */
+	if (accountDatasets(detector, DatasetType::ValidStandard, 100) != 0 || detector.getMode() != TicMode::Standard) {
+		FAILF("Locked mode should not change on valid datasets");
+	}
+}
+
+TEST(TicModeDetector_tests, TicModeDetector_no_lock_on_alternating_modes) {
+	TIC::TicModeDetector detector;
+	for (unsigned int idx = 0; idx < 10; idx++) {
+		accountDatasets(detector, DatasetType::ValidHistorical, TIC::TicModeDetector::LOCK_AFTER_VALID_DATASETS - 1);
+		accountDatasets(detector, DatasetType::ValidStandard, TIC::TicModeDetector::LOCK_AFTER_VALID_DATASETS - 1);
+	}
+	if (detector.getMode() != TicMode::Unknown) {
+		FAILF("Mode should not be locked while valid datasets of both modes are interleaved");
+	}
+	if (accountDatasets(detector, DatasetType::ValidHistorical, TIC::TicModeDetector::LOCK_AFTER_VALID_DATASETS) != 1 || detector.getMode() != TicMode::Historical) {
+		FAILF("Expected historical mode to be locked");
+	}
+}
+
+TEST(TicModeDetector_tests, TicModeDetector_redetect_after_failures) {
+	TIC::TicModeDetector detector;
+	accountDatasets(detector, DatasetType::ValidHistorical, TIC::TicModeDetector::LOCK_AFTER_VALID_DATASETS);
+	if (detector.getMode() != TicMode::Historical) {
+		FAILF("Expected historical mode to be locked");
+	}
+	/* Failures that are not consecutive do not unlock the mode */
+	for (unsigned int idx = 0; idx < 10; idx++) {
+		accountDatasets(detector, DatasetType::WrongCRC, TIC::TicModeDetector::REDETECT_AFTER_FAILURES - 1);
+		accountDatasets(detector, DatasetType::ValidHistorical, 1);
+	}
+	if (detector.getMode() != TicMode::Historical) {
+		FAILF("Mode should stay locked when failures are not consecutive");
+	}
+	/* Valid datasets of the other mode are failures for the locked mode */
+	accountDatasets(detector, DatasetType::Malformed, 1);
+	if (accountDatasets(detector, DatasetType::ValidStandard, TIC::TicModeDetector::REDETECT_AFTER_FAILURES - 1) != 1 || detector.getMode() != TicMode::Unknown) {
+		FAILF("Expected mode to be unlocked after %u consecutive failures", TIC::TicModeDetector::REDETECT_AFTER_FAILURES);
+	}
+	if (accountDatasets(detector, DatasetType::ValidStandard, TIC::TicModeDetector::LOCK_AFTER_VALID_DATASETS) != 1 || detector.getMode() != TicMode::Standard) {
+		FAILF("Expected standard mode to be locked after redetection");
+	}
+	detector.reset();
+	if (detector.getMode() != TicMode::Unknown) {
+		FAILF("Mode should be unknown after reset");
+	}
+}
+
+#ifndef USE_CPPUTEST
+void runTicModeDetectorAllUnitTests() {
+	TicModeDetector_lock_after_valid_datasets();
+	TicModeDetector_no_lock_on_alternating_modes();
+	TicModeDetector_redetect_after_failures();
+}
+#endif	// USE_CPPUTEST
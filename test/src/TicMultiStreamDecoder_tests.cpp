@@ -0,0 +1,199 @@
+#include "TestHarness.h"
+#include <vector>
+#include <stdint.h>
+#include <string>
+#include <thread>
+#include <atomic>
+
+#include "Tools.h"
+#include "TIC/MultiStreamDecoder.h"
+#include "TIC/StreamDecoder.h"
+
+TEST_GROUP(TicMultiStreamDecoder_tests) {
+};
+
+/**
+ * @brief Build a string summarizing a decoded dataset, used to compare dataset sequences
+ */
+static std::string datasetSignature(const TIC::DatasetView& dv) {
+	std::string result(1, static_cast<char>('0' + dv.decodedType));
+	result += std::string(dv.labelBuffer, dv.labelBuffer + dv.labelSz);
+	result += '|';
+	result += std::string(dv.dataBuffer, dv.dataBuffer + dv.dataSz);
+	return result;
+}
+
+static void appendStreamDatasetSignature(unsigned int streamId, const TIC::DatasetView& dv, void* context) {
+	/* Each stream has its own list, and a stream's callback is never invoked concurrently, so no lock is needed here */
+	std::vector<std::vector<std::string> >* perStream = static_cast<std::vector<std::vector<std::string> >*>(context);
+	(*perStream)[streamId].push_back(datasetSignature(dv));
+}
+
+static void appendDatasetSignature(const TIC::DatasetView& dv, void* context) {
+	static_cast<std::vector<std::string>*>(context)->push_back(datasetSignature(dv));
+}
+
+TEST(TicMultiStreamDecoder_tests, MultiStreamDecoder_per_stream_order) {
+	const char* samples[] = {
+		"./samples/continuous_linky_1P_standard_TIC_sample.bin",
+		"./samples/continuous_linky_3P_historical_TIC_2024_sample.bin",
+		"./samples/continuous_linky_3P_historical_TIC_sample.bin",
+		"./samples/continuous_linky_3P_historical_TIC_with_rx_errors.bin",
+		"./samples/linky_1P_midnight.bin",
+	};
+	const unsigned int sampleCount = sizeof(samples) / sizeof(samples[0]);
+	std::vector<std::vector<uint8_t> > sampleData;
+	std::vector<std::vector<std::string> > expected;
+	for (const char* sample : samples) {
+		sampleData.push_back(readVectorFromDisk(sample));
+		std::vector<std::string> datasets;
+		TIC::StreamDecoder sd(appendDatasetSignature, &datasets);
+		sd.pushBytes(&(sampleData.back()[0]), sampleData.back().size());
+		expected.push_back(datasets);
+	}
+
+	const unsigned int streamCount = 40;
+	std::vector<std::vector<std::string> > decoded(streamCount);
+	{
+		TIC::MultiStreamDecoder msd(streamCount, 4, appendStreamDatasetSignature, &decoded);
+		if (msd.getStreamCount() != streamCount || msd.getWorkerCount() != 4) {
+			FAILF("Unexpected stream count %u or worker count %u", msd.getStreamCount(), msd.getWorkerCount());
+		}
+
+		/* Two producer threads, each one feeding half of the streams, with a different chunk size per stream */
+		auto producer = [&msd, &sampleData, sampleCount](unsigned int firstStream) {
+			for (unsigned int streamId = firstStream; streamId < streamCount; streamId += 2) {
+				const std::vector<uint8_t>& data = sampleData[streamId % sampleCount];
+				unsigned int chunkSize = (streamId % 7) * 13 + 1;
+				for (unsigned int pos = 0; pos < data.size(); pos += chunkSize) {
+					unsigned int len = data.size() - pos;
+					if (len > chunkSize)
+						len = chunkSize;
+					msd.pushBytes(streamId, &(data[pos]), len);
+				}
+			}
+		};
+		std::thread producer0(producer, 0);
+		std::thread producer1(producer, 1);
+		producer0.join();
+		producer1.join();
+		msd.flush();
+	}
+
+	for (unsigned int streamId = 0; streamId < streamCount; streamId++) {
+		const std::vector<std::string>& expectedDatasets = expected[streamId % sampleCount];
+		if (expectedDatasets.empty() || decoded[streamId] != expectedDatasets) {
+			FAILF("Stream %u: got %zu datasets, expected %zu, or datasets are out of order", streamId, decoded[streamId].size(), expectedDatasets.size());
+		}
+	}
+}
+
+TEST(TicMultiStreamDecoder_tests, MultiStreamDecoder_interleaved_batches) {
+	std::vector<uint8_t> ticData = readVectorFromDisk("./samples/continuous_linky_3P_historical_TIC_sample.bin");
+	std::vector<std::string> expected;
+	TIC::StreamDecoder sd(appendDatasetSignature, &expected);
+	sd.pushBytes(&(ticData[0]), ticData.size());
+
+	const unsigned int streamCount = 8;
+	std::vector<std::vector<std::string> > decoded(streamCount);
+	TIC::MultiStreamDecoder msd(streamCount, 3, appendStreamDatasetSignature, &decoded);
+	/* Push one byte at a time, round-robin over streams, so that bytes keep arriving for streams that are being decoded */
+	for (unsigned int pos = 0; pos < ticData.size(); pos++) {
+		for (unsigned int streamId = 0; streamId < streamCount; streamId++) {
+			msd.pushBytes(streamId, &(ticData[pos]), 1);
+		}
+	}
+	msd.flush();
+
+	for (unsigned int streamId = 0; streamId < streamCount; streamId++) {
+		if (expected.empty() || decoded[streamId] != expected) {
+			FAILF("Stream %u: got %zu datasets, expected %zu, or datasets are out of order", streamId, decoded[streamId].size(), expected.size());
+		}
+	}
+}
+
+/**
+ * @brief Context shared by the callbacks of MultiStreamDecoder_requeued_stream_does_not_starve
+ */
+struct StarvationContext {
+	TIC::MultiStreamDecoder* msd; /*!< The decoder under test */
+	const std::vector<uint8_t>* hotData; /*!< The bytes replayed (cyclically) on the hot stream */
+	unsigned int hotPos; /*!< The next position to replay in hotData */
+	bool coldSubmitted; /*!< Has the cold stream been submitted? */
+	std::atomic<unsigned int> hotRefeeds; /*!< The number of batches pushed on the hot stream from its own callback */
+	std::atomic<unsigned int> hotRefeedsWhenColdDecoded; /*!< The value of hotRefeeds when the cold stream's first dataset was decoded */
+	std::atomic<bool> coldDecoded; /*!< Has the cold stream been decoded? */
+};
+
+static const unsigned int STARVATION_MAX_REFEEDS = 20000;
+
+static void starvationOnStreamDataset(unsigned int streamId, const TIC::DatasetView& dv, void* context) {
+	(void)dv;
+	StarvationContext* ctx = static_cast<StarvationContext*>(context);
+	if (streamId == 1) {
+		if (!ctx->coldDecoded) {
+			ctx->hotRefeedsWhenColdDecoded = ctx->hotRefeeds.load();
+			ctx->coldDecoded = true;
+		}
+		return;
+	}
+	/* Hot stream: submit the cold stream once, while the hot stream is being decoded */
+	if (!ctx->coldSubmitted) {
+		ctx->msd->pushBytes(1, &((*ctx->hotData)[0]), ctx->hotData->size());
+		ctx->coldSubmitted = true;
+	}
+	/* Then feed the hot stream again from its own callback, so that it always has pending bytes when its task ends, until the cold stream has been decoded */
+	if (ctx->coldDecoded || ctx->hotRefeeds >= STARVATION_MAX_REFEEDS)
+		return;
+	const unsigned int chunkSize = 16;
+	if (ctx->hotPos + chunkSize > ctx->hotData->size())
+		ctx->hotPos = 0;
+	ctx->msd->pushBytes(0, &((*ctx->hotData)[ctx->hotPos]), chunkSize);
+	ctx->hotPos += chunkSize;
+	ctx->hotRefeeds++;
+}
+
+TEST(TicMultiStreamDecoder_tests, MultiStreamDecoder_requeued_stream_does_not_starve) {
+	std::vector<uint8_t> ticData = readVectorFromDisk("./samples/continuous_linky_3P_historical_TIC_sample.bin");
+	StarvationContext ctx;
+	ctx.msd = nullptr;
+	ctx.hotData = &ticData;
+	ctx.hotPos = 0;
+	ctx.coldSubmitted = false;
+	ctx.hotRefeeds = 0;
+	ctx.hotRefeedsWhenColdDecoded = 0;
+	ctx.coldDecoded = false;
+	/* A single worker, so that the cold stream cannot be picked by another worker stealing it */
+	TIC::MultiStreamDecoder msd(2, 1, starvationOnStreamDataset, &ctx);
+	ctx.msd = &msd;
+	msd.pushBytes(0, &(ticData[0]), ticData.size()); /* The hot stream, the cold stream is submitted once from its callback */
+	msd.flush();
+
+	if (!ctx.coldDecoded) {
+		FAILF("Cold stream was never decoded");
+	}
+	if (ctx.hotRefeedsWhenColdDecoded >= STARVATION_MAX_REFEEDS) {
+		FAILF("Cold stream was only decoded once the hot stream stopped being fed (after %u batches)", ctx.hotRefeedsWhenColdDecoded.load());
+	}
+}
+
+TEST(TicMultiStreamDecoder_tests, MultiStreamDecoder_invalid_stream) {
+	TIC::MultiStreamDecoder msd(2, 0, nullptr);
+	uint8_t byte = 0x02;
+	if (msd.getWorkerCount() == 0) {
+		FAILF("Expected at least one worker");
+	}
+	if (!msd.pushBytes(1, &byte, 1) || msd.pushBytes(2, &byte, 1)) {
+		FAILF("Unexpected pushBytes() result on valid or invalid stream identifier");
+	}
+	msd.flush();
+}
+
+#ifndef USE_CPPUTEST
+void runTicMultiStreamDecoderAllUnitTests() {
+	MultiStreamDecoder_per_stream_order();
+	MultiStreamDecoder_interleaved_batches();
+	MultiStreamDecoder_requeued_stream_does_not_starve();
+	MultiStreamDecoder_invalid_stream();
+}
+#endif	// USE_CPPUTEST
@@ -0,0 +1,185 @@
+#include "TestHarness.h"
+#include <vector>
+#include <stdint.h>
+#include <string>
+
+#include "Tools.h"
+#include "TIC/SerialIngestion.h"
+#include "TIC/StreamDecoder.h"
+
+#ifdef __linux__
+#include <errno.h>
+#include <fcntl.h>
+#include <pty.h>	// For openpty()
+#include <unistd.h>
+#endif
+
+TEST_GROUP(TicSerialIngestion_tests) {
+};
+
+#ifdef __linux__
+static void countValidDataset(const TIC::DatasetView& dv, void* context) {
+	if (dv.isValid())
+		(*static_cast<unsigned int*>(context))++;
+}
+
+static void streamDecoderPushBytes(const uint8_t* buf, unsigned int cnt, void* context) {
+	static_cast<TIC::StreamDecoder*>(context)->pushBytes(buf, cnt);
+}
+
+/**
+ * @brief A pseudo-terminal emulating a TIC serial line: sample bytes are written on the master side, and read by TIC::SerialIngestion on the slave side
+ */
+class PtyLine {
+public:
+	PtyLine(const char* sampleFilename, TIC::SerialIngestion::Mode mode) :
+		master(-1),
+		slave(-1),
+		data(readVectorFromDisk(sampleFilename)),
+		written(0),
+		validDatasets(0),
+		decoder(countValidDataset, &(this->validDatasets)) {
+		if (openpty(&(this->master), &(this->slave), nullptr, nullptr, nullptr) != 0) {
+			FAILF("openpty() failed");
+		}
+		if (!TIC::SerialIngestion::configureSerial(this->slave, mode)) {
+			FAILF("Could not configure pty for TIC");
+		}
+		fcntl(this->master, F_SETFL, fcntl(this->master, F_GETFL) | O_NONBLOCK);
+	}
+
+	~PtyLine() {
+		if (this->master >= 0)
+			close(this->master);
+		close(this->slave);
+	}
+
+	PtyLine(const PtyLine&) = delete;
+	PtyLine& operator=(const PtyLine&) = delete;
+
+	/**
+	 * @brief Write the next bytes of the sample (as many as the pty accepts, up to @p maxBytes)
+	 */
+	void writeMore(unsigned int maxBytes) {
+		unsigned int len = this->data.size() - this->written;
+		if (len > maxBytes)
+			len = maxBytes;
+		if (len == 0)
+			return;
+		ssize_t result = write(this->master, &(this->data[this->written]), len);
+		if (result > 0)
+			this->written += result;
+		else if (result < 0 && errno != EAGAIN) {
+			FAILF("write() on pty failed");
+		}
+	}
+
+	bool allWritten() const {
+		return this->written == this->data.size();
+	}
+
+	void hangUp() {
+		close(this->master);
+		this->master = -1;
+	}
+
+	unsigned int expectedValidDatasets() const {
+		unsigned int count = 0;
+		TIC::StreamDecoder sd(countValidDataset, &count);
+		sd.pushBytes(&(this->data[0]), this->data.size());
+		return count;
+	}
+
+	int master;
+	int slave;
+	std::vector<uint8_t> data;
+	unsigned int written;
+	unsigned int validDatasets;
+	TIC::StreamDecoder decoder;
+};
+
+TEST(TicSerialIngestion_tests, SerialIngestion_two_ptys) {
+	PtyLine standardLine("./samples/continuous_linky_1P_standard_TIC_sample.bin", TIC::SerialIngestion::Mode::Standard);
+	PtyLine historicalLine("./samples/continuous_linky_3P_historical_TIC_sample.bin", TIC::SerialIngestion::Mode::Historical);
+
+	TIC::SerialIngestion ingestion(256);
+	if (!ingestion.isValid()) {
+		FAILF("Could not create epoll instance");
+	}
+	int standardIndex = ingestion.addFd(standardLine.slave, streamDecoderPushBytes, &(standardLine.decoder));
+	int historicalIndex = ingestion.addFd(historicalLine.slave, streamDecoderPushBytes, &(historicalLine.decoder));
+	if (standardIndex != 0 || historicalIndex != 1 || ingestion.getFdCount() != 2) {
+		FAILF("Unexpected descriptor indexes %d and %d", standardIndex, historicalIndex);
+	}
+
+	while (!standardLine.allWritten() || !historicalLine.allWritten()) {
+		standardLine.writeMore(1000);
+		historicalLine.writeMore(100);
+		if (ingestion.poll(100) < 0) {
+			FAILF("poll() failed");
+		}
+	}
+	/* Wait until all bytes written have been read, before hanging up */
+	for (unsigned int attempt = 0; attempt < 100 && (ingestion.getStatistics(0).bytesRead != standardLine.data.size() || ingestion.getStatistics(1).bytesRead != historicalLine.data.size()); attempt++) {
+		ingestion.poll(100);
+	}
+	standardLine.hangUp();
+	historicalLine.hangUp();
+	/* Read the remaining bytes, until both descriptors report their hang up */
+	for (unsigned int attempt = 0; attempt < 100 && !(ingestion.getStatistics(0).closed && ingestion.getStatistics(1).closed); attempt++) {
+		ingestion.poll(100);
+	}
+
+	const PtyLine* lines[] = { &standardLine, &historicalLine };
+	uint64_t totalReads = 0;
+	for (unsigned int index = 0; index < 2; index++) {
+		const TIC::SerialIngestion::FdStatistics& stats = ingestion.getStatistics(index);
+		if (!stats.closed) {
+			FAILF("Descriptor %u should have been closed after hang up", index);
+		}
+		if (stats.bytesRead != lines[index]->data.size()) {
+			FAILF("Descriptor %u: read %llu bytes, expected %zu", index, static_cast<unsigned long long>(stats.bytesRead), lines[index]->data.size());
+		}
+		if (stats.maxReadSize == 0 || stats.maxReadSize > 256) {
+			FAILF("Descriptor %u: unexpected max read size %u", index, stats.maxReadSize);
+		}
+		uint64_t histogramReads = 0;
+		for (unsigned int bucket = 0; bucket < TIC::SerialIngestion::READ_SIZE_BUCKETS; bucket++) {
+			histogramReads += stats.readSizeHistogram[bucket];
+		}
+		if (histogramReads == 0 || histogramReads > stats.readCalls) {
+			FAILF("Descriptor %u: read size histogram does not match %llu read calls", index, static_cast<unsigned long long>(stats.readCalls));
+		}
+		totalReads += stats.readCalls;
+		unsigned int expectedValidDatasets = lines[index]->expectedValidDatasets();
+		if (expectedValidDatasets == 0 || lines[index]->validDatasets != expectedValidDatasets) {
+			FAILF("Descriptor %u: decoded %u valid datasets, expected %u", index, lines[index]->validDatasets, expectedValidDatasets);
+		}
+	}
+	if (totalReads != ingestion.getReadCount() || ingestion.getEpollWaitCount() == 0) {
+		FAILF("Inconsistent syscall counts: %llu reads, %llu epoll_wait", static_cast<unsigned long long>(ingestion.getReadCount()), static_cast<unsigned long long>(ingestion.getEpollWaitCount()));
+	}
+	if (ingestion.poll(0) != -1) {
+		FAILF("poll() should fail when all descriptors are closed");
+	}
+}
+
+TEST(TicSerialIngestion_tests, SerialIngestion_invalid_fd) {
+	TIC::SerialIngestion ingestion;
+	if (ingestion.addFd(-1, streamDecoderPushBytes) != -1) {
+		FAILF("Expected failure when adding an invalid descriptor");
+	}
+	if (TIC::SerialIngestion::openSerial("/nonexistent/tty", TIC::SerialIngestion::Mode::Historical) != -1) {
+		FAILF("Expected failure when opening a nonexistent serial port");
+	}
+}
+#endif // __linux__
+
+#ifndef USE_CPPUTEST
+void runTicSerialIngestionAllUnitTests() {
+#ifdef __linux__
+	SerialIngestion_two_ptys();
+	SerialIngestion_invalid_fd();
+#endif
+}
+#endif	// USE_CPPUTEST
@@ -0,0 +1,351 @@
+#include "TestHarness.h"
+#include <sstream>
+#include <vector>
+#include <stdint.h>
+#include <string>
+#include <cstring>
+
+#include "Tools.h"
+#include "TIC/StreamDecoder.h"
+#include "TIC/DatasetView.h"
+#include "TIC/DatasetExtractor.h"
+#include "TIC/Unframer.h"
+
+TEST_GROUP(TicStreamDecoder_tests) {
+};
+
+/**
+ * @brief Comparable copy of the content of a TIC::DatasetView
+ */
+class DecodedDataset {
+public:
+	DecodedDataset(const TIC::DatasetView& dv) :
+		decodedType(dv.decodedType),
+		label(dv.labelBuffer, dv.labelBuffer + dv.labelSz),
+		data(dv.dataBuffer, dv.dataBuffer + dv.dataSz),
+		horodate(dv.horodate) { }
+
+	bool operator==(const DecodedDataset& other) const {
+		return this->decodedType == other.decodedType &&
+		       this->label == other.label &&
+		       this->data == other.data &&
+		       this->horodate.isValid == other.horodate.isValid &&
+		       this->horodate.season == other.horodate.season &&
+		       this->horodate.degradedTime == other.horodate.degradedTime &&
+		       (!this->horodate.isValid || this->horodate == other.horodate);
+	}
+
+	bool operator!=(const DecodedDataset& other) const {
+		return !(*this == other);
+	}
+
+	std::string toString() const {
+		std::stringstream result;
+		result << "type " << static_cast<int>(this->decodedType) << " label=\"" << std::string(this->label.begin(), this->label.end()) << "\" data=\"" << std::string(this->data.begin(), this->data.end()) << "\"";
+		if (this->horodate.isValid) {
+			result << " horodate=" << this->horodate.toString();
+		}
+		return result.str();
+	}
+
+	TIC::DatasetView::DatasetType decodedType;
+	std::vector<uint8_t> label;
+	std::vector<uint8_t> data;
+	TIC::Horodate horodate;
+};
+
+static void decodedDatasetListAppend(const TIC::DatasetView& dv, void* context) {
+	std::vector<DecodedDataset>* list = static_cast<std::vector<DecodedDataset>*>(context);
+	list->push_back(DecodedDataset(dv));
+}
+
+/**
+ * @brief The datasets decoded by the three stages pipeline, and its extractor (fed back with the type of each dataset, so that it tracks the TIC mode as TIC::StreamDecoder does)
+ */
+struct PipelineContext {
+	std::vector<DecodedDataset>* list;
+	TIC::DatasetExtractor* de;
+};
+
+static void datasetExtractorAppendView(const uint8_t* buf, unsigned int cnt, void* context) {
+	PipelineContext* pipeline = static_cast<PipelineContext*>(context);
+	TIC::DatasetView dv(buf, cnt);
+	pipeline->de->accountDataset(dv.decodedType);
+	decodedDatasetListAppend(dv, pipeline->list);
+}
+
+static void datasetExtractorForwardFrameBytes(const uint8_t* buf, unsigned int cnt, void* context) {
+	static_cast<TIC::DatasetExtractor*>(context)->pushBytes(buf, cnt);
+}
+
+static void datasetExtractorFrameFinished(void* context) {
+	static_cast<TIC::DatasetExtractor*>(context)->reset();
+}
+
+/**
+ * @brief Decode a TIC byte stream with the three stages pipeline (TIC::Unframer, TIC::DatasetExtractor then TIC::DatasetView), one byte at a time
+ */
+static std::vector<DecodedDataset> decodeWithPipeline(const std::vector<uint8_t>& ticData) {
+	std::vector<DecodedDataset> result;
+	PipelineContext pipeline = { &result, nullptr };
+	TIC::DatasetExtractor de(datasetExtractorAppendView, &pipeline);
+	pipeline.de = &de;
+	TIC::BasicUnframer<TIC::UnframerForwardOnTheFly, TIC::UNFRAMER_DEFAULT_MAX_FRAME_SIZE> tu(datasetExtractorForwardFrameBytes, datasetExtractorFrameFinished, &de);
+	for (uint8_t byte : ticData) {
+		tu.pushBytes(&byte, 1);
+	}
+	return result;
+}
+
+/**
+ * @brief Decode a TIC byte stream with TIC::StreamDecoder, by chunks of at most @p chunkSize bytes
+ */
+static std::vector<DecodedDataset> decodeWithStreamDecoder(const std::vector<uint8_t>& ticData, unsigned int chunkSize) {
+	std::vector<DecodedDataset> result;
+	TIC::StreamDecoder sd(decodedDatasetListAppend, &result);
+	for (unsigned int bytesRead = 0; bytesRead < ticData.size(); bytesRead += chunkSize) {
+		unsigned int nbBytesToRead = ticData.size() - bytesRead;
+		if (nbBytesToRead > chunkSize) {
+			nbBytesToRead = chunkSize;
+		}
+		if (sd.pushBytes(&(ticData[bytesRead]), nbBytesToRead) != nbBytesToRead) {
+			FAILF("Not all bytes were used by the stream decoder");
+		}
+	}
+	return result;
+}
+
+static void checkSameAsPipeline(const std::vector<uint8_t>& ticData, const char* description) {
+	std::vector<DecodedDataset> expected = decodeWithPipeline(ticData);
+	const unsigned int chunkSizes[] = { 1, 2, 7, 64, 127, 128, 129, 1024, (unsigned int)ticData.size() };
+	for (unsigned int chunkSize : chunkSizes) {
+		if (chunkSize == 0)
+			continue;
+		std::vector<DecodedDataset> decoded = decodeWithStreamDecoder(ticData, chunkSize);
+		if (decoded.size() != expected.size()) {
+			FAILF("%s, chunk size %u: stream decoder produced %zu datasets, pipeline produced %zu", description, chunkSize, decoded.size(), expected.size());
+		}
+		for (unsigned int idx = 0; idx < decoded.size(); idx++) {
+			if (decoded[idx] != expected[idx]) {
+				FAILF("%s, chunk size %u: dataset %u differs:\nGot:      %s\nExpected: %s", description, chunkSize, idx, decoded[idx].toString().c_str(), expected[idx].toString().c_str());
+			}
+		}
+	}
+}
+
+TEST(TicStreamDecoder_tests, StreamDecoder_all_samples_same_as_pipeline) {
+	const char* samples[] = {
+		"./samples/continuous_linky_1P_standard_TIC_sample.bin",
+		"./samples/continuous_linky_3P_historical_TIC_2024_sample.bin",
+		"./samples/continuous_linky_3P_historical_TIC_sample.bin",
+		"./samples/continuous_linky_3P_historical_TIC_with_rx_errors.bin",
+		"./samples/linky_1P_midnight.bin",
+	};
+
+	for (const char* sample : samples) {
+		std::vector<uint8_t> ticData = readVectorFromDisk(sample);
+		if (ticData.empty()) {
+			FAILF("Could not read sample %s", sample);
+		}
+		checkSameAsPipeline(ticData, sample);
+	}
+}
+
+TEST(TicStreamDecoder_tests, StreamDecoder_valid_datasets_count) {
+	std::vector<uint8_t> ticData = readVectorFromDisk("./samples/continuous_linky_1P_standard_TIC_sample.bin");
+	std::vector<DecodedDataset> decoded = decodeWithStreamDecoder(ticData, 64);
+
+	unsigned int validCount = 0;
+	for (auto& it : decoded) {
+		if (it.decodedType == TIC::DatasetView::DatasetType::ValidStandard)
+			validCount++;
+	}
+	if (decoded.empty() || validCount != decoded.size()) {
+		FAILF("Expected only valid standard datasets, got %u valid out of %zu", validCount, decoded.size());
+	}
+}
+
+TEST(TicStreamDecoder_tests, StreamDecoder_truncated_and_oversized) {
+	std::vector<uint8_t> ticData;
+	const char validDataset[] = "ADCO 056234673197 L";
+	/* A frame with a valid dataset, then a dataset interrupted by the start of the next frame */
+	ticData.push_back(TIC::StreamDecoder::STX);
+	ticData.push_back(TIC::StreamDecoder::LF);
+	ticData.insert(ticData.end(), validDataset, validDataset + strlen(validDataset));
+	ticData.push_back(TIC::StreamDecoder::CR);
+	ticData.push_back(TIC::StreamDecoder::LF);
+	ticData.insert(ticData.end(), validDataset, validDataset + 6);
+	ticData.push_back(TIC::StreamDecoder::STX);
+	/* An oversized dataset, that is truncated, then a valid dataset ended by a historical LF end marker */
+	ticData.push_back(TIC::StreamDecoder::LF);
+	for (unsigned int idx = 0; idx < 2 * TIC::StreamDecoder::MAX_DATASET_SIZE; idx++) {
+		ticData.push_back('A' + (idx % 26));
+	}
+	ticData.push_back(TIC::StreamDecoder::CR);
+	ticData.push_back(TIC::StreamDecoder::LF);
+	ticData.insert(ticData.end(), validDataset, validDataset + strlen(validDataset));
+	ticData.push_back(TIC::StreamDecoder::LF);
+	/* Datasets interrupted by the end of frame, and outside of any frame, are ignored */
+	ticData.push_back(TIC::StreamDecoder::LF);
+	ticData.insert(ticData.end(), validDataset, validDataset + 6);
+	ticData.push_back(TIC::StreamDecoder::ETX);
+	ticData.push_back(TIC::StreamDecoder::LF);
+	ticData.insert(ticData.end(), validDataset, validDataset + strlen(validDataset));
+	ticData.push_back(TIC::StreamDecoder::CR);
+
+	checkSameAsPipeline(ticData, "Crafted stream");
+
+	std::vector<DecodedDataset> decoded = decodeWithStreamDecoder(ticData, 1);
+	if (decoded.size() != 3 || !decoded[0].label.size() || decoded[0] != decoded[2] || decoded[1].decodedType != TIC::DatasetView::DatasetType::Malformed) {
+		FAILF("Unexpected datasets decoded from crafted stream (%zu datasets)", decoded.size());
+	}
+}
+
+TEST(TicStreamDecoder_tests, StreamDecoder_compile_time_sink) {
+	std::vector<uint8_t> ticData = readVectorFromDisk("./samples/continuous_linky_3P_historical_TIC_sample.bin");
+	unsigned int validCount = 0;
+	auto onDataset = [&validCount](const TIC::DatasetView& dv) {
+		if (dv.isValid())
+			validCount++;
+	};
+	TIC::BasicStreamDecoder<decltype(onDataset)> sd(onDataset);
+	sd.pushBytes(&(ticData[0]), ticData.size());
+
+	unsigned int expectedValidCount = 0;
+	for (auto& it : decodeWithPipeline(ticData)) {
+		if (it.decodedType == TIC::DatasetView::DatasetType::ValidHistorical)
+			expectedValidCount++;
+	}
+	if (validCount == 0 || validCount != expectedValidCount) {
+		FAILF("Got %u valid datasets with a compile-time sink, expected %u", validCount, expectedValidCount);
+	}
+}
+
+TEST(TicStreamDecoder_tests, StreamDecoder_mode_lock) {
+	std::vector<uint8_t> historicalData = readVectorFromDisk("./samples/continuous_linky_3P_historical_TIC_sample.bin");
+	std::vector<uint8_t> standardData = readVectorFromDisk("./samples/continuous_linky_1P_standard_TIC_sample.bin");
+	std::vector<DecodedDataset> decoded;
+	TIC::StreamDecoder sd(decodedDatasetListAppend, &decoded);
+
+	if (sd.getMode() != TIC::StreamDecoder::TicMode::Unknown) {
+		FAILF("Mode should be unknown before any dataset is decoded");
+	}
+	sd.pushBytes(&(historicalData[0]), historicalData.size());
+	if (sd.getMode() != TIC::StreamDecoder::TicMode::Historical) {
+		FAILF("Expected historical mode to be locked after a historical stream");
+	}
+	/* The line changes mode: standard datasets are not valid historical datasets, until the mode is detected again */
+	sd.reset();
+	sd.pushBytes(&(standardData[0]), standardData.size());
+	if (sd.getMode() != TIC::StreamDecoder::TicMode::Standard) {
+		FAILF("Expected standard mode to be locked after a standard stream");
+	}
+
+	std::vector<DecodedDataset> expected = decodeWithPipeline(historicalData);
+	std::vector<DecodedDataset> expectedStandard = decodeWithPipeline(standardData);
+	expected.insert(expected.end(), expectedStandard.begin(), expectedStandard.end());
+	if (decoded.size() != expected.size()) {
+		FAILF("Decoded %zu datasets, expected %zu", decoded.size(), expected.size());
+	}
+	for (unsigned int idx = 0; idx < decoded.size(); idx++) {
+		if (decoded[idx] != expected[idx]) {
+			FAILF("Dataset %u differs:\nGot:      %s\nExpected: %s", idx, decoded[idx].toString().c_str(), expected[idx].toString().c_str());
+		}
+	}
+}
+
+/**
+ * @brief Append a frame made of @p datasets to @p ticData
+ */
+static void appendFrame(std::vector<uint8_t>& ticData, const std::vector<std::string>& datasets) {
+	ticData.push_back(TIC::StreamDecoder::STX);
+	for (const std::string& dataset : datasets) {
+		ticData.insert(ticData.end(), dataset.begin(), dataset.end());
+	}
+	ticData.push_back(TIC::StreamDecoder::ETX);
+}
+
+TEST(TicStreamDecoder_tests, StreamDecoder_standard_spurious_lf) {
+	const std::string valid("\nADSC\t064468368739\tM\r");
+	std::vector<uint8_t> ticData;
+	/* Before standard TIC is locked, a spurious LF ends the dataset */
+	appendFrame(ticData, { valid, "\nADSC\t0644\n68368739\tM\r", valid });
+	/* Once it is locked, only CR ends a dataset, so the spurious LF only corrupts one dataset */
+	appendFrame(ticData, { valid, valid, valid, "\nADSC\t0644\n68368739\tM\r", valid, "\n\nADSC\t064468368739\tM\r" });
+	checkSameAsPipeline(ticData, "Standard stream with spurious LFs");
+
+	std::vector<DecodedDataset> decoded = decodeWithStreamDecoder(ticData, 64);
+	if (decoded.size() != 4 + 6 || decoded[1].decodedType != TIC::DatasetView::DatasetType::Malformed || decoded[2].decodedType != TIC::DatasetView::DatasetType::WrongCRC) {
+		FAILF("Unexpected datasets decoded before standard TIC is locked (%zu datasets)", decoded.size());
+	}
+	for (unsigned int idx = 4; idx < decoded.size(); idx++) {
+		if ((idx == 7) != (decoded[idx].decodedType == TIC::DatasetView::DatasetType::WrongCRC)) {
+			FAILF("Once standard TIC is locked, only the dataset containing a spurious LF should be invalid (dataset %u)", idx);
+		}
+	}
+
+	/* Standard TIC is locked by a dataset ended by a LF, the next LF is then data, not the start marker of the next dataset */
+	ticData.clear();
+	appendFrame(ticData, { valid, valid, "\nADSC\t064468368739\tM\n", "\nADSC\t064468368739\tM\r" });
+	checkSameAsPipeline(ticData, "Standard TIC locked on a dataset ended by a LF");
+}
+
+/**
+ * @brief Read the standard TIC sample, with the CR ending one of its datasets lost (once the TIC mode has been locked)
+ */
+static std::vector<uint8_t> readStandardSampleWithLostCr() {
+	std::vector<uint8_t> ticData = readVectorFromDisk("./samples/continuous_linky_1P_standard_TIC_sample.bin");
+	unsigned int datasetEndCount = 0;
+	for (unsigned int pos = 0; pos + 1 < ticData.size(); pos++) {
+		if (ticData[pos] == TIC::StreamDecoder::CR && ticData[pos + 1] == TIC::StreamDecoder::LF && ++datasetEndCount == 50) {
+			ticData.erase(ticData.begin() + pos);
+			break;
+		}
+	}
+	return ticData;
+}
+
+static unsigned int countValidDatasets(const std::vector<DecodedDataset>& datasets) {
+	unsigned int validCount = 0;
+	for (const DecodedDataset& dataset : datasets) {
+		if (dataset.decodedType == TIC::DatasetView::DatasetType::ValidStandard || dataset.decodedType == TIC::DatasetView::DatasetType::ValidHistorical)
+			validCount++;
+	}
+	return validCount;
+}
+
+TEST(TicStreamDecoder_tests, StreamDecoder_standard_lost_cr) {
+	const std::string valid("\nADSC\t064468368739\tM\r");
+	std::vector<uint8_t> ticData;
+	/* Once standard TIC is locked, a LF completing a valid dataset ends it (its CR has been lost), and starts the next dataset */
+	appendFrame(ticData, { valid, valid, valid, "\nADSC\t064468368739\tM", valid });
+	checkSameAsPipeline(ticData, "Standard frame with a lost CR");
+	std::vector<DecodedDataset> decoded = decodeWithStreamDecoder(ticData, ticData.size());
+	if (decoded.size() != 5 || countValidDatasets(decoded) != 5) {
+		FAILF("A lost CR should not lose any dataset: got %zu datasets, %u valid", decoded.size(), countValidDatasets(decoded));
+	}
+
+	std::vector<uint8_t> sample = readVectorFromDisk("./samples/continuous_linky_1P_standard_TIC_sample.bin");
+	std::vector<uint8_t> sampleWithLostCr = readStandardSampleWithLostCr();
+	if (sampleWithLostCr.size() != sample.size() - 1) {
+		FAILF("No CR has been removed from the sample");
+	}
+	checkSameAsPipeline(sampleWithLostCr, "Standard sample with a lost CR");
+	unsigned int expectedValidCount = countValidDatasets(decodeWithStreamDecoder(sample, sample.size()));
+	unsigned int validCount = countValidDatasets(decodeWithStreamDecoder(sampleWithLostCr, sampleWithLostCr.size()));
+	if (validCount != expectedValidCount) {
+		FAILF("A lost CR should not lose any dataset: got %u valid datasets, expected %u", validCount, expectedValidCount);
+	}
+}
+
+#ifndef USE_CPPUTEST
+void runTicStreamDecoderAllUnitTests() {
+	StreamDecoder_all_samples_same_as_pipeline();
+	StreamDecoder_valid_datasets_count();
+	StreamDecoder_truncated_and_oversized();
+	StreamDecoder_compile_time_sink();
+	StreamDecoder_mode_lock();
+	StreamDecoder_standard_spurious_lf();
+	StreamDecoder_standard_lost_cr();
+}
+#endif	// USE_CPPUTEST
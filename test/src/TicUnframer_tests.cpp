@@ -5,6 +5,8 @@
 #include <stdint.h>
 #include <string>
 #include <iterator>
+#include <utility>
+#include <cstring>
 
 #include "Tools.h"
 #include "TIC/Unframer.h"
@@ -264,7 +266,7 @@ TEST(TicUnframer_tests, TicUnframer_unframe_callbacks_in_cached_mode) {
 
 	CallbackSequenceCheckerStub stub;
 
-	TIC::Unframer tu(frameDecoderStubUnwrapForwardFrameBytes, frameDecoderStubUnwrapFrameFinished, &stub);
+	TIC::BasicUnframer<TIC::UnframerBufferWholeFrame, TIC::UNFRAMER_DEFAULT_MAX_FRAME_SIZE> tu(frameDecoderStubUnwrapForwardFrameBytes, frameDecoderStubUnwrapFrameFinished, &stub);
 	const uint8_t* bufPtr = buffer;
 	tu.pushBytes(bufPtr, 5); /* Start of first frame + 4 bytes */
 	bufPtr += 5;
@@ -346,7 +348,7 @@ TEST(TicUnframer_tests, TicUnframer_unframe_callbacks_in_on_the_fly_mode) {
 
 	CallbackSequenceCheckerStub stub;
 
-	TIC::Unframer tu(frameDecoderStubUnwrapForwardFrameBytes, frameDecoderStubUnwrapFrameFinished, &stub);
+	TIC::BasicUnframer<TIC::UnframerForwardOnTheFly, TIC::UNFRAMER_DEFAULT_MAX_FRAME_SIZE> tu(frameDecoderStubUnwrapForwardFrameBytes, frameDecoderStubUnwrapFrameFinished, &stub);
 	const uint8_t* bufPtr = buffer;
 	tu.pushBytes(bufPtr, 5); /* Start of first frame + 4 bytes */
 	bufPtr += 5;
@@ -367,6 +369,319 @@ TEST(TicUnframer_tests, TicUnframer_unframe_callbacks_in_on_the_fly_mode) {
 	}
 }
 
+TEST(TicUnframer_tests, TicUnframer_frame_statistics) {
+	uint8_t buffer[] = { 'x', 'y', 'z', /* 3 bytes out of sync */
+	                     TIC::Unframer::START_MARKER, 'a', 'b', 'c', 'd', TIC::Unframer::END_MARKER,
+	                     'w', /* 1 byte out of sync */
+	                     TIC::Unframer::START_MARKER, 'A', 'B', /* Truncated frame (interrupted by the next start marker) */
+	                     TIC::Unframer::START_MARKER, '0', '1', '2', '3', '4', '5', TIC::Unframer::END_MARKER };
+	FrameDecoderStub stub;
+	TIC::Unframer tu(frameDecoderStubUnwrapForwardFrameBytes, frameDecoderStubUnwrapFrameFinished, &stub);
+
+	if (tu.getMaxFrameSizeFromRecentHistory() != 0 || tu.getMinFrameSizeFromRecentHistory() != 0 || tu.getMeanFrameSizeFromRecentHistory() != 0 || tu.getP95FrameSizeFromRecentHistory() != 0) {
+		FAILF("Unexpected non-zero statistics before any frame");
+	}
+	for (unsigned int pos = 0; pos < sizeof(buffer); pos++) {
+		tu.pushBytes(buffer + pos, 1);
+	}
+	if (tu.getFramesSeen() != 3) {
+		FAILF("Wrong frames seen: %u", tu.getFramesSeen());
+	}
+	if (tu.getTruncatedFrames() != 1) {
+		FAILF("Wrong truncated frames: %u", tu.getTruncatedFrames());
+	}
+	if (tu.getBytesSkippedOutOfSync() != 4) {
+		FAILF("Wrong bytes skipped: %u", tu.getBytesSkippedOutOfSync());
+	}
+	if (tu.getMaxFrameSizeFromRecentHistory() != 6) {
+		FAILF("Wrong max frame size: %u", tu.getMaxFrameSizeFromRecentHistory());
+	}
+	if (tu.getMinFrameSizeFromRecentHistory() != 2) {
+		FAILF("Wrong min frame size: %u", tu.getMinFrameSizeFromRecentHistory());
+	}
+	if (tu.getMeanFrameSizeFromRecentHistory() != 4) {
+		FAILF("Wrong mean frame size: %u", tu.getMeanFrameSizeFromRecentHistory());
+	}
+	if (tu.getP95FrameSizeFromRecentHistory() != 6) {
+		FAILF("Wrong p95 frame size: %u", tu.getP95FrameSizeFromRecentHistory());
+	}
+	if (tu.getMaxInterFrameGapFromRecentHistory() != 3) {
+		FAILF("Wrong max inter-frame gap: %u", tu.getMaxInterFrameGapFromRecentHistory());
+	}
+}
+
+TEST(TicUnframer_tests, TicUnframer_frame_statistics_history_window) {
+	FrameDecoderStub stub;
+	TIC::Unframer tu(frameDecoderStubUnwrapForwardFrameBytes, frameDecoderStubUnwrapFrameFinished, &stub);
+	uint8_t frame[TIC::Unframer::FRAME_HISTORY_SIZE * 2 + 2];
+
+	/* Push frames of increasing sizes, from 1 to 2*FRAME_HISTORY_SIZE bytes, only the FRAME_HISTORY_SIZE last ones should be kept in history */
+	for (unsigned int frameSize = 1; frameSize <= 2 * TIC::Unframer::FRAME_HISTORY_SIZE; frameSize++) {
+		frame[0] = TIC::Unframer::START_MARKER;
+		for (unsigned int pos = 1; pos <= frameSize; pos++) {
+			frame[pos] = 'a';
+		}
+		frame[frameSize + 1] = TIC::Unframer::END_MARKER;
+		tu.pushBytes(frame, frameSize + 2);
+	}
+	unsigned int expectedMin = TIC::Unframer::FRAME_HISTORY_SIZE + 1;
+	unsigned int expectedMax = 2 * TIC::Unframer::FRAME_HISTORY_SIZE;
+	if (tu.getMinFrameSizeFromRecentHistory() != expectedMin || tu.getMaxFrameSizeFromRecentHistory() != expectedMax) {
+		FAILF("Wrong min/max frame size: %u/%u", tu.getMinFrameSizeFromRecentHistory(), tu.getMaxFrameSizeFromRecentHistory());
+	}
+	if (tu.getMeanFrameSizeFromRecentHistory() != (expectedMin + expectedMax) / 2) {
+		FAILF("Wrong mean frame size: %u", tu.getMeanFrameSizeFromRecentHistory());
+	}
+	if (tu.getP95FrameSizeFromRecentHistory() != expectedMax) {	/* ceil(95% of 16) = 16th value */
+		FAILF("Wrong p95 frame size: %u", tu.getP95FrameSizeFromRecentHistory());
+	}
+	if (tu.getFramesSeen() != 2 * TIC::Unframer::FRAME_HISTORY_SIZE || tu.getTruncatedFrames() != 0 || tu.getBytesSkippedOutOfSync() != 0) {
+		FAILF("Wrong counters: %u/%u/%u", tu.getFramesSeen(), tu.getTruncatedFrames(), tu.getBytesSkippedOutOfSync());
+	}
+}
+
+TEST(TicUnframer_tests, TicUnframer_frame_statistics_standard_TIC) {
+	std::vector<uint8_t> ticData = readVectorFromDisk("./samples/continuous_linky_1P_standard_TIC_sample.bin");
+	FrameDecoderStub stub;
+	TIC::Unframer tu(frameDecoderStubUnwrapForwardFrameBytes, frameDecoderStubUnwrapFrameFinished, &stub);
+	TicUnframer_test_file_sent_by_chunks(ticData, 64, tu);
+	if (tu.getFramesSeen() != 12 || tu.getTruncatedFrames() != 0) {
+		FAILF("Wrong frame counters: %u/%u", tu.getFramesSeen(), tu.getTruncatedFrames());
+	}
+	if (tu.getMinFrameSizeFromRecentHistory() != 863 || tu.getMaxFrameSizeFromRecentHistory() != 863 || tu.getP95FrameSizeFromRecentHistory() != 863) {
+		FAILF("Wrong frame sizes: %u/%u/%u", tu.getMinFrameSizeFromRecentHistory(), tu.getMaxFrameSizeFromRecentHistory(), tu.getP95FrameSizeFromRecentHistory());
+	}
+}
+
+TEST(TicUnframer_tests, TicUnframer_small_buffer_truncation_in_cached_mode) {
+	uint8_t buffer[] = { TIC::Unframer::START_MARKER, 'a', 'b', 'c', 'd', 'e', 'f', 'g', 'h', 'i', 'j', TIC::Unframer::END_MARKER,
+	                     TIC::Unframer::START_MARKER, 'A', 'B', 'C', TIC::Unframer::END_MARKER };
+	FrameDecoderStub stub;
+	TIC::BasicUnframer<TIC::UnframerBufferWholeFrame, 8> tu(frameDecoderStubUnwrapForwardFrameBytes, frameDecoderStubUnwrapFrameFinished, &stub);
+	unsigned int usedBytes = tu.pushBytes(buffer, sizeof(buffer));
+	if (usedBytes != sizeof(buffer) - 2) {	/* The 2 bytes not fitting in the 8-byte frame buffer are not used */
+		FAILF("Unexpected used bytes count: %u", usedBytes);
+	}
+	if (stub.decodedFramesList.size() != 2) {
+		FAILF("Wrong frame count: %zu\nFrames received:\n%s", stub.decodedFramesList.size(), stub.toString().c_str());
+	}
+	if (stub.decodedFramesList[0] != std::vector<uint8_t>({'a', 'b', 'c', 'd', 'e', 'f', 'g', 'h'})) {
+		FAILF("Wrong truncated frame decoded: %s", vectorToHexString(stub.decodedFramesList[0]).c_str());
+	}
+	if (stub.decodedFramesList[1] != std::vector<uint8_t>({'A', 'B', 'C'})) {
+		FAILF("Wrong frame decoded after truncated frame: %s", vectorToHexString(stub.decodedFramesList[1]).c_str());
+	}
+	if (tu.getTruncatedFrames() != 1) {
+		FAILF("Wrong truncated frames: %u", tu.getTruncatedFrames());
+	}
+}
+
+/**
+ * @brief A FrameDecoderStub that also records whether each frame was delivered from within a given caller buffer
+ */
+class FrameLocationCheckerStub : public FrameDecoderStub {
+public:
+	FrameLocationCheckerStub(const uint8_t* callerBuffer, unsigned int callerBufferSz) :
+		callerBuffer(callerBuffer),
+		callerBufferSz(callerBufferSz),
+		deliveredFromCallerBuffer() { }
+
+	FrameLocationCheckerStub(const FrameLocationCheckerStub&) = delete;
+	FrameLocationCheckerStub& operator=(const FrameLocationCheckerStub&) = delete;
+
+	virtual void onNewBytesCallback(const uint8_t* buf, unsigned int cnt) override {
+		this->deliveredFromCallerBuffer.push_back(buf >= this->callerBuffer && buf + cnt <= this->callerBuffer + this->callerBufferSz);
+		FrameDecoderStub::onNewBytesCallback(buf, cnt);
+	}
+
+	const uint8_t* callerBuffer;
+	unsigned int callerBufferSz;
+	std::vector<bool> deliveredFromCallerBuffer;
+};
+
+TEST(TicUnframer_tests, TicUnframer_zero_copy_contiguous_frames_in_cached_mode) {
+	uint8_t buffer[] = { 'x', TIC::Unframer::START_MARKER, 'a', 'b', 'c', TIC::Unframer::END_MARKER,
+	                     TIC::Unframer::START_MARKER, 'A', 'B', 'C', 'D', TIC::Unframer::END_MARKER,
+	                     TIC::Unframer::START_MARKER, '0', '1' };
+	uint8_t trailer[] = { '2', TIC::Unframer::END_MARKER };
+	FrameLocationCheckerStub stub(buffer, sizeof(buffer));
+	TIC::BasicUnframer<TIC::UnframerBufferWholeFrame, TIC::UNFRAMER_DEFAULT_MAX_FRAME_SIZE> tu(frameDecoderStubUnwrapForwardFrameBytes, frameDecoderStubUnwrapFrameFinished, &stub);
+	tu.pushBytes(buffer, sizeof(buffer));
+	tu.pushBytes(trailer, sizeof(trailer));
+	if (stub.decodedFramesList.size() != 3) {
+		FAILF("Wrong frame count: %zu\nFrames received:\n%s", stub.decodedFramesList.size(), stub.toString().c_str());
+	}
+	if (stub.decodedFramesList[0] != std::vector<uint8_t>({'a', 'b', 'c'}) ||
+	    stub.decodedFramesList[1] != std::vector<uint8_t>({'A', 'B', 'C', 'D'}) ||
+	    stub.decodedFramesList[2] != std::vector<uint8_t>({'0', '1', '2'})) {
+		FAILF("Wrong frames decoded:\n%s", stub.toString().c_str());
+	}
+	if (!stub.deliveredFromCallerBuffer[0] || !stub.deliveredFromCallerBuffer[1]) {
+		FAILF("Contiguous frames should be delivered from the caller's buffer");
+	}
+	if (stub.deliveredFromCallerBuffer[2]) {
+		FAILF("Frame spanning two calls should be delivered from the internal buffer");
+	}
+}
+
+TEST(TicUnframer_tests, TicUnframer_zero_copy_truncation_in_cached_mode) {
+	uint8_t buffer[] = { TIC::Unframer::START_MARKER, 'a', 'b', 'c', 'd', 'e', 'f', 'g', 'h', 'i', 'j', TIC::Unframer::END_MARKER };
+	FrameLocationCheckerStub stub(buffer, sizeof(buffer));
+	TIC::BasicUnframer<TIC::UnframerBufferWholeFrame, 8> tu(frameDecoderStubUnwrapForwardFrameBytes, frameDecoderStubUnwrapFrameFinished, &stub);
+	tu.pushBytes(buffer, sizeof(buffer));
+	if (stub.decodedFramesList.size() != 1 || stub.decodedFramesList[0] != std::vector<uint8_t>({'a', 'b', 'c', 'd', 'e', 'f', 'g', 'h'})) {
+		FAILF("Wrong frames decoded:\n%s", stub.toString().c_str());
+	}
+	if (!stub.deliveredFromCallerBuffer[0] || tu.getTruncatedFrames() != 1) {
+		FAILF("Contiguous oversized frame should be delivered truncated from the caller's buffer");
+	}
+}
+
+TEST(TicUnframer_tests, TicUnframer_on_the_fly_mode_has_no_frame_buffer) {
+	if (sizeof(TIC::BasicUnframer<TIC::UnframerForwardOnTheFly, 65536>) >= sizeof(TIC::BasicUnframer<TIC::UnframerBufferWholeFrame, 8>)) {
+		FAILF("On-the-fly unframer (%zu bytes) should be smaller than any cached mode unframer (%zu bytes)", sizeof(TIC::BasicUnframer<TIC::UnframerForwardOnTheFly, 65536>), sizeof(TIC::BasicUnframer<TIC::UnframerBufferWholeFrame, 8>));
+	}
+}
+
+/**
+ * @brief Record each error reported to a FOnDecodeErrorFunc callback
+ */
+static void appendDecodeError(TIC::DecodeError error, unsigned int count, void* context) {
+	static_cast<std::vector<std::pair<TIC::DecodeError, unsigned int> >*>(context)->push_back(std::make_pair(error, count));
+}
+
+TEST(TicUnframer_tests, TicUnframer_error_counters_and_callback) {
+	uint8_t buffer[] = { 'x', 'y', TIC::Unframer::START_MARKER, 'a', 'b', 'c', 'd', 'e', 'f', 'g', 'h', 'i', 'j', TIC::Unframer::END_MARKER,
+	                     'z', TIC::Unframer::START_MARKER, 'A', 'B',
+	                     TIC::Unframer::START_MARKER, 'C', TIC::Unframer::END_MARKER };
+	std::vector<std::pair<TIC::DecodeError, unsigned int> > errors;
+	FrameDecoderStub stub;
+	TIC::BasicUnframer<TIC::UnframerBufferWholeFrame, 8> tu(frameDecoderStubUnwrapForwardFrameBytes, frameDecoderStubUnwrapFrameFinished, &stub);
+	tu.setErrorCallback(appendDecodeError, &errors);
+	tu.pushBytes(buffer, 8); /* Split the oversized frame across three calls, so that it overflows the internal buffer twice */
+	tu.pushBytes(buffer + 8, 4);
+	tu.pushBytes(buffer + 12, sizeof(buffer) - 13);
+	tu.pushBytes(buffer + sizeof(buffer) - 1, 1); /* Push the last ETX separately, or it would take precedence over the preceding STX to end frame 'AB' */
+	const TIC::DecodeErrorCounters& counters = tu.getErrorCounters();
+	if (counters.outOfSyncBytes != 3 || counters.overflowedFrames != 1 || counters.droppedFrameBytes != 2 || counters.interruptedFrames != 1) {
+		FAILF("Wrong error counters: %u out of sync bytes, %u overflowed frames, %u dropped bytes, %u interrupted frames", counters.outOfSyncBytes, counters.overflowedFrames, counters.droppedFrameBytes, counters.interruptedFrames);
+	}
+	if (counters.overflowedDatasets != 0 || counters.droppedDatasetBytes != 0 || counters.emptyDatasets != 0) {
+		FAILF("Unexpected dataset error counters");
+	}
+	std::vector<std::pair<TIC::DecodeError, unsigned int> > expectedErrors({
+		std::make_pair(TIC::DecodeError::OutOfSyncBytes, 2u),
+		std::make_pair(TIC::DecodeError::FrameOverflow, 1u),
+		std::make_pair(TIC::DecodeError::FrameOverflow, 1u),
+		std::make_pair(TIC::DecodeError::OutOfSyncBytes, 1u),
+		std::make_pair(TIC::DecodeError::InterruptedFrame, 1u),
+	});
+	if (errors != expectedErrors) {
+		FAILF("Wrong error callbacks: got %zu, expected %zu", errors.size(), expectedErrors.size());
+	}
+	if (tu.getBytesSkippedOutOfSync() != 3 || tu.getTruncatedFrames() != 2) {
+		FAILF("Wrong frame statistics: %u bytes skipped, %u truncated frames", tu.getBytesSkippedOutOfSync(), tu.getTruncatedFrames());
+	}
+	tu.resetErrorCounters();
+	if (tu.getErrorCounters().outOfSyncBytes != 0 || tu.getErrorCounters().overflowedFrames != 0) {
+		FAILF("Error counters should be 0 after reset");
+	}
+	if (tu.getBytesSkippedOutOfSync() != 3 || tu.getTruncatedFrames() != 2) {
+		FAILF("Frame statistics should not be reset with error counters");
+	}
+}
+
+/**
+ * @brief Check that feeding @p stream with pushByte() gives the same results as feeding it with pushBytes(&byte, 1)
+ */
+template<typename Unframer>
+static void checkPushByteSameAsPushBytes(const char* description, const std::vector<uint8_t>& stream) {
+	FrameDecoderStub expectedStub;
+	FrameDecoderStub stub;
+	Unframer expectedTu(frameDecoderStubUnwrapForwardFrameBytes, frameDecoderStubUnwrapFrameFinished, &expectedStub);
+	Unframer tu(frameDecoderStubUnwrapForwardFrameBytes, frameDecoderStubUnwrapFrameFinished, &stub);
+	for (unsigned int pos = 0; pos < stream.size(); pos++) {
+		unsigned int expectedUsed = expectedTu.pushBytes(&(stream[pos]), 1);
+		unsigned int used = tu.pushByte(stream[pos]);
+		if (used != expectedUsed || tu.isInSync() != expectedTu.isInSync()) {
+			FAILF("%s: pushByte() and pushBytes() differ at byte %u", description, pos);
+		}
+	}
+	if (stub.decodedFramesList.empty() || stub.decodedFramesList != expectedStub.decodedFramesList || stub.currentFrame != expectedStub.currentFrame) {
+		FAILF("%s: frames received with pushByte() (%zu) differ from frames received with pushBytes() (%zu)", description, stub.decodedFramesList.size(), expectedStub.decodedFramesList.size());
+	}
+	if (tu.getFramesSeen() != expectedTu.getFramesSeen() ||
+	    tu.getTruncatedFrames() != expectedTu.getTruncatedFrames() ||
+	    tu.getBytesSkippedOutOfSync() != expectedTu.getBytesSkippedOutOfSync() ||
+	    tu.getMeanFrameSizeFromRecentHistory() != expectedTu.getMeanFrameSizeFromRecentHistory() ||
+	    tu.getMaxInterFrameGapFromRecentHistory() != expectedTu.getMaxInterFrameGapFromRecentHistory() ||
+	    memcmp(&(tu.getErrorCounters()), &(expectedTu.getErrorCounters()), sizeof(TIC::DecodeErrorCounters)) != 0) {
+		FAILF("%s: frame statistics or error counters differ between pushByte() and pushBytes()", description);
+	}
+}
+
+TEST(TicUnframer_tests, TicUnframer_pushByte_same_as_single_byte_pushBytes) {
+	const char* samples[] = {
+		"./samples/continuous_linky_1P_standard_TIC_sample.bin",
+		"./samples/continuous_linky_3P_historical_TIC_sample.bin",
+		"./samples/continuous_linky_3P_historical_TIC_with_rx_errors.bin",
+	};
+	for (const char* sample : samples) {
+		std::vector<uint8_t> ticData = readVectorFromDisk(sample);
+		/* Also add a frame truncated by the start of the next one */
+		ticData.insert(ticData.begin(), { TIC::Unframer::START_MARKER, 'a', 'b', TIC::Unframer::START_MARKER, 'c', TIC::Unframer::END_MARKER });
+		checkPushByteSameAsPushBytes<TIC::BasicUnframer<TIC::UnframerForwardOnTheFly, TIC::UNFRAMER_DEFAULT_MAX_FRAME_SIZE> >(sample, ticData);
+		checkPushByteSameAsPushBytes<TIC::BasicUnframer<TIC::UnframerBufferWholeFrame, TIC::UNFRAMER_DEFAULT_MAX_FRAME_SIZE> >(sample, ticData);
+		checkPushByteSameAsPushBytes<TIC::BasicUnframer<TIC::UnframerBufferWholeFrame, 64> >(sample, ticData); /* With frame overflows */
+	}
+}
+
+/**
+ * @brief Check that feeding @p stream split into segments of @p segmentSize bytes with pushBytesv() gives the same results as feeding it with one pushBytes()
+ */
+template<typename Unframer>
+static void checkPushBytesvSameAsContiguousPushBytes(const char* description, const std::vector<uint8_t>& stream, unsigned int segmentSize) {
+	FrameDecoderStub expectedStub;
+	FrameDecoderStub stub;
+	Unframer expectedTu(frameDecoderStubUnwrapForwardFrameBytes, frameDecoderStubUnwrapFrameFinished, &expectedStub);
+	Unframer tu(frameDecoderStubUnwrapForwardFrameBytes, frameDecoderStubUnwrapFrameFinished, &stub);
+	unsigned int expectedUsed = expectedTu.pushBytes(&(stream[0]), stream.size());
+	std::vector<TIC::ByteSegment> segments;
+	for (unsigned int pos = 0; pos < stream.size(); pos += segmentSize) {
+		unsigned int len = stream.size() - pos;
+		if (len > segmentSize)
+			len = segmentSize;
+		segments.push_back(TIC::ByteSegment{ &(stream[pos]), len });
+	}
+	unsigned int used = tu.pushBytesv(&(segments[0]), segments.size());
+	if (used != expectedUsed) {
+		FAILF("%s: wrong number of bytes used with %u-byte segments: %u, expected %u", description, segmentSize, used, expectedUsed);
+	}
+	if (stub.decodedFramesList.empty() || stub.decodedFramesList != expectedStub.decodedFramesList || stub.currentFrame != expectedStub.currentFrame) {
+		FAILF("%s: frames received from %u-byte segments (%zu) differ from frames received from contiguous bytes (%zu)", description, segmentSize, stub.decodedFramesList.size(), expectedStub.decodedFramesList.size());
+	}
+	if (tu.getFramesSeen() != expectedTu.getFramesSeen() ||
+	    tu.getTruncatedFrames() != expectedTu.getTruncatedFrames() ||
+	    memcmp(&(tu.getErrorCounters()), &(expectedTu.getErrorCounters()), sizeof(TIC::DecodeErrorCounters)) != 0) {
+		FAILF("%s: frame statistics or error counters differ between %u-byte segments and contiguous bytes", description, segmentSize);
+	}
+}
+
+TEST(TicUnframer_tests, TicUnframer_pushBytesv_same_as_contiguous_pushBytes) {
+	const char* samples[] = {
+		"./samples/continuous_linky_1P_standard_TIC_sample.bin",
+		"./samples/continuous_linky_3P_historical_TIC_with_rx_errors.bin",
+	};
+	for (const char* sample : samples) {
+		std::vector<uint8_t> ticData = readVectorFromDisk(sample);
+		for (unsigned int segmentSize : { 1U, 100U, 4096U }) {
+			checkPushBytesvSameAsContiguousPushBytes<TIC::BasicUnframer<TIC::UnframerForwardOnTheFly, TIC::UNFRAMER_DEFAULT_MAX_FRAME_SIZE> >(sample, ticData, segmentSize);
+			checkPushBytesvSameAsContiguousPushBytes<TIC::BasicUnframer<TIC::UnframerBufferWholeFrame, TIC::UNFRAMER_DEFAULT_MAX_FRAME_SIZE> >(sample, ticData, segmentSize);
+			checkPushBytesvSameAsContiguousPushBytes<TIC::BasicUnframer<TIC::UnframerBufferWholeFrame, 64> >(sample, ticData, segmentSize); /* With frame overflows */
+		}
+	}
+}
+
 #ifndef USE_CPPUTEST
 void runTicUnframerAllUnitTests() {
 	TicUnframer_test_one_pure_stx_etx_frame_10bytes();
@@ -376,10 +691,17 @@ void runTicUnframerAllUnitTests() {
 	TicUnframer_test_one_pure_stx_etx_frame_two_halves();
 	TicUnframer_chunked_sample_unframe_historical_TIC();
 	TicUnframer_chunked_sample_unframe_standard_TIC();
-#ifdef __TIC_UNFRAMER_FORWARD_FRAME_BYTES_ON_THE_FLY__
+	TicUnframer_frame_statistics();
+	TicUnframer_frame_statistics_history_window();
+	TicUnframer_frame_statistics_standard_TIC();
 	TicUnframer_unframe_callbacks_in_on_the_fly_mode();
-#else
 	TicUnframer_unframe_callbacks_in_cached_mode();
-#endif
+	TicUnframer_small_buffer_truncation_in_cached_mode();
+	TicUnframer_on_the_fly_mode_has_no_frame_buffer();
+	TicUnframer_zero_copy_contiguous_frames_in_cached_mode();
+	TicUnframer_zero_copy_truncation_in_cached_mode();
+	TicUnframer_error_counters_and_callback();
+	TicUnframer_pushByte_same_as_single_byte_pushBytes();
+	TicUnframer_pushBytesv_same_as_contiguous_pushBytes();
 }
 #endif	// USE_CPPUTEST
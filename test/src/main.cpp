@@ -1,10 +1,33 @@
+extern void runTicMarkerScannerAllUnitTests();
 extern void runTicUnframerAllUnitTests();
 extern void runTicDatasetExtractorAllUnitTests();
+extern void runTicDatasetBatchExtractorAllUnitTests();
+extern void runTicFrameValidatorAllUnitTests();
+extern void runTicDatasetLabelFilterAllUnitTests();
 extern void runFixedSizeRingBufferAllUnitTests();
 extern void runTicDatasetViewAllUnitTests();
+extern void runTicLazyDatasetViewAllUnitTests();
+extern void runTicLabelIdAllUnitTests();
+extern void runTicLabelKeyAllUnitTests();
+extern void runTicModeDetectorAllUnitTests();
+extern void runTicStreamDecoderAllUnitTests();
+extern void runTicMultiStreamDecoderAllUnitTests();
+extern void runTicSerialIngestionAllUnitTests();
 
 int main(void) {
+    runFixedSizeRingBufferAllUnitTests();
+    runTicMarkerScannerAllUnitTests();
     runTicUnframerAllUnitTests();
     runTicDatasetExtractorAllUnitTests();
+    runTicDatasetBatchExtractorAllUnitTests();
+    runTicFrameValidatorAllUnitTests();
+    runTicDatasetLabelFilterAllUnitTests();
     runTicDatasetViewAllUnitTests();
+    runTicLazyDatasetViewAllUnitTests();
+    runTicLabelIdAllUnitTests();
+    runTicLabelKeyAllUnitTests();
+    runTicModeDetectorAllUnitTests();
+    runTicStreamDecoderAllUnitTests();
+    runTicMultiStreamDecoderAllUnitTests();
+    runTicSerialIngestionAllUnitTests();
 }
\ No newline at end of file